@@ -0,0 +1,128 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+    /**
+     * 基准测试上下文
+     *
+     * 测试函数在 Loop() 返回 true 期间反复执行被测代码，由框架负责计时。
+     */
+    class State
+    {
+    public:
+        explicit State(size_t iterations) noexcept
+            : m_uIterations(iterations) {}
+
+    public:
+        bool Loop() noexcept
+        {
+            auto now = std::chrono::steady_clock::now();
+            if (m_uCurrent == 0)
+                m_stStart = now;
+            else
+                m_stSamples.push_back(std::chrono::duration<double, std::micro>(now - m_stLast).count());
+            m_stLast = now;
+            return m_uCurrent++ < m_uIterations;
+        }
+
+        /**
+         * 附加一个计数器，在结果中按每次迭代的平均值输出
+         */
+        void AddCounter(const std::string& name, double value)
+        {
+            for (auto& c : m_stCounters)
+            {
+                if (c.first == name)
+                {
+                    c.second += value;
+                    return;
+                }
+            }
+            m_stCounters.emplace_back(name, value);
+        }
+
+        const std::vector<double>& GetSamples() const noexcept { return m_stSamples; }
+        const std::vector<std::pair<std::string, double>>& GetCounters() const noexcept { return m_stCounters; }
+        size_t GetIterations() const noexcept { return m_uIterations; }
+
+    private:
+        size_t m_uIterations = 0;
+        size_t m_uCurrent = 0;
+        std::chrono::steady_clock::time_point m_stStart;
+        std::chrono::steady_clock::time_point m_stLast;
+        std::vector<double> m_stSamples;  // 每次迭代耗时（微秒）
+        std::vector<std::pair<std::string, double>> m_stCounters;
+    };
+
+    using BenchFunc = std::function<void(State&)>;
+
+    struct Case
+    {
+        std::string Name;
+        size_t Iterations = 0;
+        BenchFunc Func;
+    };
+
+    std::vector<Case>& GetRegistry() noexcept;
+
+    /**
+     * 防止计算结果被优化掉
+     */
+    template <typename T>
+    void DoNotOptimize(const T& value) noexcept
+    {
+        [[maybe_unused]] static volatile T kSink {};
+        kSink = value;
+    }
+
+    /**
+     * 校验失败时的退出码，与回归（2）区分
+     */
+    constexpr int kCheckFailedExitCode = 3;
+
+    /**
+     * 报告被测代码的结果错误并立即结束进程
+     *
+     * 用于为编解码器、匹配器等手写实现提供正确性检查，任何一次运行都会执行，不依赖额外的测试目标。
+     * @param what 失败时输出的描述
+     */
+    [[noreturn]] inline void Fail(const std::string& what) noexcept
+    {
+        std::fprintf(stderr, "CHECK FAILED: %s\n", what.c_str());
+        std::fflush(stderr);
+        std::exit(kCheckFailedExitCode);
+    }
+
+    struct Registrar
+    {
+        Registrar(const char* name, size_t iterations, BenchFunc func)
+        {
+            GetRegistry().push_back({name, iterations, std::move(func)});
+        }
+    };
+}
+
+#define PSM_BENCH_CONCAT_IMPL(A, B) A##B
+#define PSM_BENCH_CONCAT(A, B) PSM_BENCH_CONCAT_IMPL(A, B)
+
+/**
+ * 注册一个基准测试
+ * @param NAME 名称
+ * @param ITERATIONS 迭代次数
+ */
+#define PSM_BENCH(NAME, ITERATIONS) \
+    static void PSM_BENCH_CONCAT(BenchFunc_, __LINE__)(bench::State& state); \
+    static bench::Registrar PSM_BENCH_CONCAT(BenchRegistrar_, __LINE__)(NAME, ITERATIONS, \
+        PSM_BENCH_CONCAT(BenchFunc_, __LINE__)); \
+    static void PSM_BENCH_CONCAT(BenchFunc_, __LINE__)(bench::State& state)
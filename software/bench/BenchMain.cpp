@@ -0,0 +1,203 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ *
+ * 用法：PiSystemMonitorBench [过滤子串] [--json 输出文件] [--baseline 基线文件] [--tolerance 比例]
+ *
+ * --json 输出机器可读结果，该文件也可直接作为之后运行的基线。指定 --baseline 时按 p50 与基线比较，
+ * 慢于基线超过 tolerance（默认 0.15）的测试会被标记为回归，此时进程返回 2。
+ * 部分测试会同时校验结果（bench::Fail），校验失败时进程立即返回 3。
+ *
+ * 结果中的 host 记录运行的硬件（uname 的 machine 与 CPU 数），基线来自不同的硬件时会给出警告，此时的比较没有意义。
+ * 仓库中的 bench/baseline.json 为参考基线，重新生成的方法见 README。
+ */
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <thread>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <sys/utsname.h>
+
+using namespace std;
+
+std::vector<bench::Case>& bench::GetRegistry() noexcept
+{
+    static std::vector<Case> kRegistry;
+    return kRegistry;
+}
+
+namespace
+{
+    struct Options
+    {
+        const char* Filter = nullptr;
+        const char* JsonPath = nullptr;
+        const char* BaselinePath = nullptr;
+        double Tolerance = 0.15;
+    };
+
+    bool ParseOptions(int argc, char* argv[], Options& options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            bool hasValue = i + 1 < argc;
+            if (::strcmp(argv[i], "--json") == 0 && hasValue)
+                options.JsonPath = argv[++i];
+            else if (::strcmp(argv[i], "--baseline") == 0 && hasValue)
+                options.BaselinePath = argv[++i];
+            else if (::strcmp(argv[i], "--tolerance") == 0 && hasValue)
+                options.Tolerance = ::atof(argv[++i]);
+            else if (argv[i][0] != '-' && !options.Filter)
+                options.Filter = argv[i];
+            else
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * 当前硬件
+     */
+    nlohmann::json GetHost()
+    {
+        struct utsname name {};
+        ::uname(&name);
+        return { { "machine", name.machine }, { "cpus", std::thread::hardware_concurrency() } };
+    }
+
+    /**
+     * 读取基线文件中各测试的 p50（微秒）
+     */
+    bool LoadBaseline(const char* path, std::map<std::string, double>& out)
+    {
+        try
+        {
+            ifstream fs(path);
+            if (!fs)
+                return false;
+            auto doc = nlohmann::json::parse(fs);
+            for (const auto& c : doc.at("cases"))
+                out[c.at("name").get<std::string>()] = c.at("p50_us").get<double>();
+
+            auto host = GetHost();
+            if (auto it = doc.find("host"); it != doc.end() && *it != host)
+            {
+                spdlog::warn("Baseline {} was recorded on {} with {} CPU(s), this host is {} with {} CPU(s), "
+                    "regenerate it on this host for meaningful comparisons", path, it->value("machine", "?"), it->value("cpus", 0),
+                    host["machine"].get<std::string>(), host["cpus"].get<unsigned>());
+            }
+            return true;
+        }
+        catch (const std::exception& ex)
+        {
+            spdlog::error("Failed to load baseline {}: {}", path, ex.what());
+            return false;
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        fmt::print(stderr, "Usage: {} [filter] [--json FILE] [--baseline FILE] [--tolerance RATIO]\n", argv[0]);
+        return 1;
+    }
+
+    std::map<std::string, double> baseline;
+    if (options.BaselinePath && !LoadBaseline(options.BaselinePath, baseline))
+        return 1;
+
+    auto results = nlohmann::json::array();
+    size_t regressions = 0;
+    for (const auto& c : bench::GetRegistry())
+    {
+        if (options.Filter && c.Name.find(options.Filter) == string::npos)
+            continue;
+
+        bench::State state(c.Iterations);
+        c.Func(state);
+
+        auto samples = state.GetSamples();
+        if (samples.empty())
+        {
+            spdlog::warn("{}: no samples", c.Name);
+            continue;
+        }
+        std::sort(samples.begin(), samples.end());
+        double sum = 0;
+        for (auto s : samples)
+            sum += s;
+        auto percentile = [&](double p) {
+            return samples[std::min(samples.size() - 1, static_cast<size_t>(p * static_cast<double>(samples.size())))];
+        };
+        auto mean = sum / static_cast<double>(samples.size());
+        auto p50 = percentile(0.5);
+        auto p99 = percentile(0.99);
+
+        // 与基线比较
+        std::string verdict;
+        auto it = baseline.find(c.Name);
+        if (it != baseline.end() && it->second > 0)
+        {
+            auto ratio = p50 / it->second;
+            if (ratio > 1. + options.Tolerance)
+            {
+                verdict = fmt::format("REGRESSION {:+.1f}%", (ratio - 1.) * 100.);
+                ++regressions;
+            }
+            else
+            {
+                verdict = fmt::format("{:+.1f}%", (ratio - 1.) * 100.);
+            }
+        }
+
+        fmt::print("{:<40} n={:<6} mean={:>10.2f}us p50={:>10.2f}us p99={:>10.2f}us max={:>10.2f}us {}\n", c.Name,
+            samples.size(), mean, p50, p99, samples.back(), verdict);
+
+        auto& result = results.emplace_back();
+        result["name"] = c.Name;
+        result["samples"] = samples.size();
+        result["mean_us"] = mean;
+        result["p50_us"] = p50;
+        result["p99_us"] = p99;
+        result["max_us"] = samples.back();
+        auto& counters = result["counters"] = nlohmann::json::object();
+        for (const auto& counter : state.GetCounters())
+        {
+            auto perIteration = counter.second / static_cast<double>(samples.size());
+            counters[counter.first] = perIteration;
+            fmt::print("{:<40}   {}={:.2f}/iter\n", "", counter.first, perIteration);
+        }
+        if (it != baseline.end())
+            result["baseline_p50_us"] = it->second;
+    }
+
+    if (options.JsonPath)
+    {
+        nlohmann::json doc;
+        doc["host"] = GetHost();
+        doc["cases"] = std::move(results);
+        ofstream fs(options.JsonPath);
+        fs << doc.dump(2) << '\n';
+        if (!fs)
+        {
+            spdlog::error("Failed to write {}", options.JsonPath);
+            return 1;
+        }
+    }
+
+    if (regressions > 0)
+    {
+        spdlog::error("{} benchmark(s) regressed beyond {:.0f}% of baseline", regressions, options.Tolerance * 100.);
+        return 2;
+    }
+    return 0;
+}
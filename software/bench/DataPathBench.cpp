@@ -0,0 +1,362 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include "Bench.hpp"
+
+#include <cstdlib>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <imgui.h>
+#include <SDL2/SDL.h>
+#include <implot.h>
+#include <App.hpp>
+#include <DeviceFilter.hpp>
+#include <MetricsCapture.hpp>
+#include <MetricsHistory.hpp>
+#include <MetricsParseListener.hpp>
+#include <MetricsParser.hpp>
+#include <SyntheticExporter.hpp>
+
+using namespace std;
+
+namespace
+{
+    constexpr uint64_t kStartTimestampMs = 1700000000000;
+
+    /**
+     * 默认规模（与树莓派相近）的合成页面
+     */
+    const std::string& GetSyntheticPage()
+    {
+        static const std::string kPage = []() {
+            SyntheticExporter exporter({});
+            return exporter.Render(kStartTimestampMs);
+        }();
+        return kPage;
+    }
+
+    /**
+     * 真实页面，取自 BENCH_CAPTURE 指定的采集文件（METRICS_RECORD 生成）中的第一条记录
+     */
+    const std::string* GetCapturedPage()
+    {
+        static const std::optional<std::string> kPage = []() -> std::optional<std::string> {
+            const char* path = ::getenv("BENCH_CAPTURE");
+            if (!path)
+                return {};
+            MetricsCaptureReader reader;
+            MetricsCaptureRecord record;
+            if (!reader.Open(path) || !reader.Next(record))
+                return {};
+            return std::move(record.Body);
+        }();
+        return kPage ? &*kPage : nullptr;
+    }
+
+    /**
+     * 不做任何处理的监听器，用于单独测量词法分析
+     */
+    class NullListener :
+        public MetricsParser::IListener
+    {
+    public:
+        void OnMetricsBegin(std::string_view) override {}
+        void OnMetricsLabel(std::string_view, std::string_view) override {}
+        void OnMetricsValue(std::string_view) override {}
+        void OnMetricsEnd() override {}
+    };
+
+    /**
+     * 记录解析事件，之后可以不经过词法分析直接重放给其他监听器
+     */
+    class RecordingListener :
+        public MetricsParser::IListener
+    {
+    public:
+        enum class EventType
+        {
+            Begin,
+            Label,
+            Value,
+            End,
+        };
+
+        struct Event
+        {
+            EventType Type;
+            std::string_view First;
+            std::string_view Second;
+        };
+
+    public:
+        void OnMetricsBegin(std::string_view name) override { m_stEvents.push_back({EventType::Begin, name, {}}); }
+        void OnMetricsLabel(std::string_view name, std::string_view value) override { m_stEvents.push_back({EventType::Label, name, value}); }
+        void OnMetricsValue(std::string_view value) override { m_stEvents.push_back({EventType::Value, value, {}}); }
+        void OnMetricsEnd() override { m_stEvents.push_back({EventType::End, {}, {}}); }
+
+        void Replay(MetricsParser::IListener& listener) const
+        {
+            for (const auto& e : m_stEvents)
+            {
+                switch (e.Type)
+                {
+                    case EventType::Begin:
+                        listener.OnMetricsBegin(e.First);
+                        break;
+                    case EventType::Label:
+                        listener.OnMetricsLabel(e.First, e.Second);
+                        break;
+                    case EventType::Value:
+                        listener.OnMetricsValue(e.First);
+                        break;
+                    case EventType::End:
+                        listener.OnMetricsEnd();
+                        break;
+                }
+            }
+        }
+
+        size_t GetEventCount() const noexcept { return m_stEvents.size(); }
+
+    private:
+        std::vector<Event> m_stEvents;
+    };
+
+    /**
+     * 暴露 App 的帧回调，以便脱离 AppBase::Run 单独计时
+     */
+    class BenchApp :
+        public App
+    {
+    public:
+        void Start() noexcept { OnStart(); }
+        void Frame(double delta) noexcept { OnFrame(delta); }
+        void Presented() noexcept { OnFramePresented(::SDL_GetPerformanceCounter()); }
+        void Stop() noexcept { OnStop(); }
+    };
+}
+
+PSM_BENCH("Data/Parse/Synthetic", 200)
+{
+    const auto& page = GetSyntheticPage();
+    while (state.Loop())
+    {
+        MetricsSampleThread::RawMetrics raw;
+        MetricsSampleThread::ParseMetrics(page, raw);
+        state.AddCounter("bytes", static_cast<double>(page.size()));
+    }
+}
+
+// 使用默认设备过滤规则，合成页面中的 dm-* 与 veth* 在解析时被丢弃
+PSM_BENCH("Data/Parse/Filtered", 200)
+{
+    const auto& page = GetSyntheticPage();
+    DeviceFilter diskFilter, networkFilter;
+    diskFilter.Compile(DeviceFilter::kDefaultDiskRules);
+    networkFilter.Compile(DeviceFilter::kDefaultNetworkRules);
+    while (state.Loop())
+    {
+        MetricsSampleThread::RawMetrics raw;
+        MetricsSampleThread::ParseMetrics(page, raw, &diskFilter, &networkFilter);
+        state.AddCounter("bytes", static_cast<double>(page.size()));
+        state.AddCounter("devices", static_cast<double>(raw.DiskIoTimeSecondsTotal.size() +
+            raw.NetworkReceiveBytesTotal.size()));
+    }
+}
+
+// 校验默认规则与通配符语义，任何一项不符都会使进程失败；计时部分为逐个匹配全部设备名
+PSM_BENCH("Data/DeviceFilter/Match", 200)
+{
+    struct Case
+    {
+        std::string_view Rules;
+        std::string_view Name;
+        bool Accepted;
+    };
+    static const Case kCases[] = {
+        // 默认磁盘规则：保留整盘，排除分区、device-mapper 与 loop 等
+        { DeviceFilter::kDefaultDiskRules, "sda", true },
+        { DeviceFilter::kDefaultDiskRules, "vdb", true },
+        { DeviceFilter::kDefaultDiskRules, "nvme0n1", true },
+        { DeviceFilter::kDefaultDiskRules, "mmcblk0", true },
+        { DeviceFilter::kDefaultDiskRules, "sda1", false },
+        { DeviceFilter::kDefaultDiskRules, "sdaa12", false },
+        { DeviceFilter::kDefaultDiskRules, "nvme0n1p1", false },
+        { DeviceFilter::kDefaultDiskRules, "mmcblk0p1", false },
+        { DeviceFilter::kDefaultDiskRules, "dm-0", false },
+        { DeviceFilter::kDefaultDiskRules, "loop7", false },
+        { DeviceFilter::kDefaultDiskRules, "zram0", false },
+        // 默认网络规则：保留物理接口，排除回环与虚拟接口
+        { DeviceFilter::kDefaultNetworkRules, "eth0", true },
+        { DeviceFilter::kDefaultNetworkRules, "wlan0", true },
+        { DeviceFilter::kDefaultNetworkRules, "enp3s0", true },
+        { DeviceFilter::kDefaultNetworkRules, "lo0", true },
+        { DeviceFilter::kDefaultNetworkRules, "lo", false },
+        { DeviceFilter::kDefaultNetworkRules, "veth123", false },
+        { DeviceFilter::kDefaultNetworkRules, "docker0", false },
+        { DeviceFilter::kDefaultNetworkRules, "br-1a2b", false },
+        // 排除规则与顺序无关，且优先于包含规则
+        { "sd*,!sda1", "sda1", false },
+        { "!sda1,sd*", "sda1", false },
+        { "!sda1,sd*", "sda", true },
+        { "!sda1,sd*", "vda", false },
+        { "!sda1", "vda", true },
+        // 字符类、范围、取反与转义
+        { "sd[a-c]", "sdb", true },
+        { "sd[a-c]", "sdd", false },
+        { "sd[a-c]", "sd-", false },
+        { "sd[!a-c]", "sdd", true },
+        { "sd[!a-c]", "sda", false },
+        { "[hsv]d[a-z]", "hdz", true },
+        { "[hsv]d[a-z]", "xda", false },
+        { "disk?", "disk1", true },
+        { "disk?", "disk", false },
+        { "a\\*b", "a*b", true },
+        { "a\\*b", "axb", false },
+        // 空规则放行所有设备
+        { "", "anything", true },
+    };
+
+    std::vector<DeviceFilter> filters(std::size(kCases));
+    for (size_t i = 0; i < std::size(kCases); ++i)
+    {
+        if (!filters[i].Compile(kCases[i].Rules))
+            bench::Fail("DeviceFilter: failed to compile " + std::string(kCases[i].Rules));
+    }
+    while (state.Loop())
+    {
+        for (size_t i = 0; i < std::size(kCases); ++i)
+        {
+            const auto& c = kCases[i];
+            if (filters[i].Accept(c.Name) != c.Accepted)
+            {
+                bench::Fail("DeviceFilter: '" + std::string(c.Rules) + "' should " + (c.Accepted ? "accept" : "reject") + " '" +
+                    std::string(c.Name) + "'");
+            }
+        }
+        state.AddCounter("names", static_cast<double>(std::size(kCases)));
+    }
+}
+
+// 需要设置 BENCH_CAPTURE，否则跳过
+PSM_BENCH("Data/Parse/Captured", 200)
+{
+    const auto* page = GetCapturedPage();
+    if (!page)
+        return;
+    while (state.Loop())
+    {
+        MetricsSampleThread::RawMetrics raw;
+        MetricsSampleThread::ParseMetrics(*page, raw);
+        state.AddCounter("bytes", static_cast<double>(page->size()));
+    }
+}
+
+PSM_BENCH("Data/Parse/TokenizeOnly", 200)
+{
+    const auto& page = GetSyntheticPage();
+    NullListener listener;
+    while (state.Loop())
+        MetricsParser::Parse(page, &listener);
+}
+
+PSM_BENCH("Data/ListenerDispatch", 200)
+{
+    const auto& page = GetSyntheticPage();
+    RecordingListener recorder;
+    MetricsParser::Parse(page, &recorder);
+
+    while (state.Loop())
+    {
+        MetricsSampleThread::RawMetrics raw;
+        MetricsParseListener listener(raw);
+        recorder.Replay(listener);
+        state.AddCounter("events", static_cast<double>(recorder.GetEventCount()));
+    }
+}
+
+PSM_BENCH("Data/ToDouble", 200)
+{
+    static const std::string_view kInputs[] = { "0", "1", "0.25", "12345.67", "1.7000000e+09", "4.294967296e+09",
+        "98765432101", "-3.5", "NaN", "+Inf" };
+    double sink = 0;
+    while (state.Loop())
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            for (const auto& input : kInputs)
+                sink += MetricsParseListener::ToDouble(input);
+        }
+        state.AddCounter("values", 100. * std::size(kInputs));
+    }
+    bench::DoNotOptimize(sink);
+}
+
+PSM_BENCH("Data/HistoryPush", 200)
+{
+    MetricsHistory histories[6] = { MetricsHistory(150), MetricsHistory(150), MetricsHistory(150),
+        MetricsHistory(150), MetricsHistory(150), MetricsHistory(150) };
+    double value = 0;
+    while (state.Loop())
+    {
+        // 与 App::OnFrame 一样，每次采样推入 6 条曲线
+        for (auto& history : histories)
+            history.Push(value);
+        value += 1.;
+    }
+}
+
+// 无头运行 App::OnFrame（不含光栅化），数据来自合成页面的实时回放
+PSM_BENCH("Data/HeadlessOnFrame", 300)
+{
+    auto capturePath = std::filesystem::temp_directory_path() / "psm_bench_capture.psmc";
+    std::error_code ec;
+    std::filesystem::remove(capturePath, ec);
+    {
+        SyntheticExporter exporter({});
+        MetricsCaptureWriter writer;
+        if (!writer.Open(capturePath.string()))
+            return;
+        for (uint64_t i = 0; i < 30; ++i)
+        {
+            auto timestamp = kStartTimestampMs + i * 1000;
+            if (!writer.Append(timestamp, exporter.Render(timestamp)))
+                return;
+        }
+    }
+    ::setenv("METRICS_REPLAY", capturePath.c_str(), 1);
+    ::setenv("METRICS_REPLAY_MODE", "realtime", 1);
+    ::setenv("METRICS_REPLAY_LOOP", "1", 1);
+
+    ImGui::CreateContext();
+    ImPlot::CreateContext();
+    auto& io = ImGui::GetIO();
+    io.IniFilename = nullptr;
+    io.DisplaySize = {480, 320};
+
+    {
+        // 析构时由 AppBase 销毁 ImGui/ImPlot 上下文
+        BenchApp app;
+        app.Start();
+        while (state.Loop())
+        {
+            io.DeltaTime = 1.f / 30.f;
+            ImGui::NewFrame();
+            app.Frame(io.DeltaTime);
+            ImGui::Render();
+            app.Presented();
+            state.AddCounter("vertices", static_cast<double>(ImGui::GetDrawData()->TotalVtxCount));
+        }
+        app.Stop();
+    }
+
+    ::unsetenv("METRICS_REPLAY");
+    ::unsetenv("METRICS_REPLAY_MODE");
+    ::unsetenv("METRICS_REPLAY_LOOP");
+    std::filesystem::remove(capturePath, ec);
+}
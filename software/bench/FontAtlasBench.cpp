@@ -0,0 +1,53 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include "Bench.hpp"
+
+#include <cstring>
+#include <imgui.h>
+#include <PrebakedFontAtlas.hpp>
+
+#include <whitrabt.ttf.inl>
+#include <Segment7-4Gml.otf.inl>
+#include <FontAtlas.bin.inl>
+
+using namespace std;
+
+// 旧的启动流程：解压并光栅化四个字体（另加默认字体），以 RGBA32 上传
+PSM_BENCH("FontAtlas/BuildFromTTF/RGBA32", 20)
+{
+    while (state.Loop())
+    {
+        ImFontAtlas atlas;
+        atlas.AddFontDefault();
+        for (const auto& desc : PrebakedFontAtlas::kFonts)
+        {
+            bool segment7 = ::strcmp(desc.AssetName, "Segment7-4Gml.otf") == 0;
+            atlas.AddFontFromMemoryCompressedTTF(segment7 ? kFontSegment7_compressed_data : kFontWhitrabt_compressed_data,
+                static_cast<int>(segment7 ? kFontSegment7_compressed_size : kFontWhitrabt_compressed_size), desc.SizePixels);
+        }
+
+        unsigned char* pixels = nullptr;
+        int width = 0, height = 0;
+        atlas.GetTexDataAsRGBA32(&pixels, &width, &height);
+        state.AddCounter("texture_bytes", static_cast<double>(width) * height * 4);
+    }
+}
+
+// 新的启动流程：装入预烘焙的 Alpha8 图集
+PSM_BENCH("FontAtlas/LoadPrebaked/Alpha8", 200)
+{
+    while (state.Loop())
+    {
+        ImFontAtlas atlas;
+        if (!PrebakedFontAtlas::Load(&atlas, kFontAtlas_data, kFontAtlas_size))
+            break;
+
+        unsigned char* pixels = nullptr;
+        int width = 0, height = 0;
+        atlas.GetTexDataAsAlpha8(&pixels, &width, &height);
+        state.AddCounter("texture_bytes", static_cast<double>(width) * height);
+    }
+}
@@ -0,0 +1,118 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include "Bench.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <imgui.h>
+#include <implot.h>
+#include <spdlog/spdlog.h>
+#include <AppBase.hpp>
+#include <FramebufferDisplay.hpp>
+
+using namespace std;
+
+namespace
+{
+    /**
+     * 绘制一个与主界面布局相近的测试帧
+     */
+    void DrawDashboard(int plotFrame, int valueFrame) noexcept
+    {
+        static double kHistory[150] = {};
+        for (size_t i = 0; i < std::size(kHistory); ++i)
+            kHistory[i] = 50.0 + 40.0 * std::sin(static_cast<double>(i + plotFrame) * 0.1);
+
+        const auto& io = ImGui::GetIO();
+        ImGui::SetNextWindowPos({0, 0});
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("Bench", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoMove);
+        if (ImGui::BeginTable("Metrics", 4))
+        {
+            for (int row = 0; row < 6; ++row)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("ROW%d", row);
+                ImGui::TableNextColumn();
+                ImGui::Text("%5.1f", kHistory[(row * 7 + valueFrame) % std::size(kHistory)]);
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted("%");
+                ImGui::TableNextColumn();
+                ImGui::PushID(row);
+                if (ImPlot::BeginPlot("##Plot", {-1, 40}, ImPlotFlags_CanvasOnly | ImPlotFlags_NoInputs))
+                {
+                    ImPlot::SetupAxes(nullptr, nullptr, ImPlotAxisFlags_NoDecorations, ImPlotAxisFlags_NoDecorations);
+                    ImPlot::SetupAxesLimits(0, std::size(kHistory), 0, 100, ImGuiCond_Always);
+                    ImPlot::PlotShaded("##Shaded", kHistory, std::size(kHistory));
+                    ImPlot::PlotLine("##Line", kHistory, std::size(kHistory));
+                    ImPlot::EndPlot();
+                }
+                ImGui::PopID();
+            }
+            ImGui::EndTable();
+        }
+        ImGui::End();
+    }
+
+    /**
+     * 在假 framebuffer 上反复绘制并输出
+     * @param state 测试上下文
+     * @param animate 为 false 时仅数值变化，模拟曲线不滚动的情况
+     */
+    void RunFramebufferBench(bench::State& state, bool animate)
+    {
+        auto path = std::filesystem::temp_directory_path() / "psm_fake_fb.bin";
+
+        ImGui::CreateContext();
+        ImPlot::CreateContext();
+        ImGui::GetIO().IniFilename = nullptr;
+
+        {
+            AppBaseConfig config;
+            config.InitialWidth = 480;
+            config.InitialHeight = 320;
+            config.DisplayDevice = path.string();
+
+            FramebufferDisplay display;
+            if (auto ret = display.Initialize(config); !ret)
+            {
+                spdlog::error("Failed to initialize fake framebuffer: {}", ret.GetError().message());
+            }
+            else
+            {
+                int frame = 0;
+                while (state.Loop())
+                {
+                    display.NewFrame();
+                    ImGui::NewFrame();
+                    DrawDashboard(animate ? frame : 0, frame);
+                    ++frame;
+                    ImGui::Render();
+                    display.Render(ImGui::GetDrawData());
+                    display.Present();
+
+                    state.AddCounter("bytes", static_cast<double>(display.GetLastPresentBytes()));
+                    state.AddCounter("rects", static_cast<double>(display.GetLastPresentRectCount()));
+                }
+            }
+        }
+
+        ImPlot::DestroyContext();
+        ImGui::DestroyContext();
+        std::filesystem::remove(path);
+    }
+}
+
+PSM_BENCH("Framebuffer/RenderPresent/480x320", 500)
+{
+    RunFramebufferBench(state, true);
+}
+
+PSM_BENCH("Framebuffer/RenderPresent/480x320/StaticPlot", 500)
+{
+    RunFramebufferBench(state, false);
+}
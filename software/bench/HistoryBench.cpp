@@ -0,0 +1,464 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <fmt/format.h>
+#include <CompressedSeries.hpp>
+#include <MetricsSampleThread.hpp>
+#include <QuantileSketch.hpp>
+#include <RollupSeries.hpp>
+#include <SparklineLod.hpp>
+#include <WindowedQuantileSketch.hpp>
+#include <SyntheticExporter.hpp>
+
+using namespace std;
+
+namespace
+{
+    constexpr uint64_t kStartTimestampMs = 1700000000000;
+    constexpr size_t kPointCount = 3600;  // 1 小时 1 秒间隔的数据，内存占用按比例折算到 24 小时
+    constexpr double kRawBytesPerPoint = sizeof(uint64_t) + sizeof(double);
+    constexpr const char* kSeriesNames[] = { "Cpu", "Memory", "DiskRead", "NetworkReceive", "Load1" };
+    constexpr int kSeriesFractionBits[] = { 8, 0, 0, 0, 8 };  // 与 App 中的设置一致
+
+    /**
+     * 按位比较，NaN 与 ±0 各自只与自身相等
+     */
+    bool SameBits(double a, double b) noexcept
+    {
+        return std::bit_cast<uint64_t>(a) == std::bit_cast<uint64_t>(b);
+    }
+
+    /**
+     * 一条测试序列
+     */
+    struct SeriesData
+    {
+        const char* Name;
+        int FractionBits;
+        std::vector<CompressedSeries::Point> Points;
+    };
+
+    /**
+     * 经过合成 exporter、解析与差分计算得到的序列，数值特征与实际运行时一致
+     */
+    const std::vector<SeriesData>& GetSeries()
+    {
+        static const std::vector<SeriesData> kSeries = []() {
+            std::vector<SeriesData> series;
+            for (size_t i = 0; i < std::size(kSeriesNames); ++i)
+                series.push_back({ kSeriesNames[i], kSeriesFractionBits[i], {} });
+
+            SyntheticExporter exporter({});
+            std::mt19937 rng(1);
+            std::uniform_int_distribution<int> jitter(-3, 3);  // 抓取时刻的抖动（毫秒）
+
+            MetricsSampleThread::RawMetrics last;
+            auto timestampMs = kStartTimestampMs;
+            MetricsSampleThread::ParseMetrics(exporter.Render(timestampMs), last);
+            last.Tick = last.TimestampMs = timestampMs;
+            for (size_t i = 0; i < kPointCount; ++i)
+            {
+                timestampMs += 1000 + jitter(rng);
+                MetricsSampleThread::RawMetrics raw;
+                MetricsSampleThread::ParseMetrics(exporter.Render(timestampMs), raw);
+                raw.Tick = raw.TimestampMs = timestampMs;
+
+                MetricsSampleThread::MetricsResult metrics;
+                MetricsSampleThread::ComputeMetrics(raw, last, metrics);
+                last = std::move(raw);
+
+                series[0].Points.push_back({ timestampMs, metrics.CpuUsage.empty() ? 0. : metrics.CpuUsage[0] });
+                series[1].Points.push_back({ timestampMs,
+                    static_cast<double>(metrics.MemoryTotalBytes - metrics.MemoryAvailableBytes) });
+                series[2].Points.push_back({ timestampMs, metrics.DiskReadBytesPerSecond.begin()->second });
+                series[3].Points.push_back({ timestampMs, metrics.NetworkReceiveBytesPerSecond.begin()->second });
+                series[4].Points.push_back({ timestampMs, metrics.Load1 });
+            }
+            return series;
+        }();
+        return kSeries;
+    }
+
+    CompressedSeries Compress(const SeriesData& data, int fractionBits)
+    {
+        CompressedSeries series(CompressedSeries::kDefaultRetentionMs, fractionBits);
+        for (const auto& point : data.Points)
+            series.Append(point.TimestampMs, point.Value);
+        return series;
+    }
+
+    void RunAppendBench(bench::State& state, const SeriesData& data, int fractionBits)
+    {
+        while (state.Loop())
+        {
+            auto series = Compress(data, fractionBits);
+            auto bytesPerPoint = static_cast<double>(series.GetMemoryBytes()) / static_cast<double>(series.GetSize());
+            state.AddCounter("bytes_per_point", bytesPerPoint);
+            state.AddCounter("compression_ratio", kRawBytesPerPoint / bytesPerPoint);
+            state.AddCounter("kib_per_day", bytesPerPoint * 86400. / 1024.);
+        }
+    }
+
+    void RunDecodeBench(bench::State& state, const SeriesData& data)
+    {
+        auto series = Compress(data, data.FractionBits);
+        std::vector<CompressedSeries::Point> out;
+        out.reserve(series.GetSize());
+
+        while (state.Loop())
+        {
+            auto start = chrono::steady_clock::now();
+            out.clear();
+            series.Decode(0, out);
+            auto us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+            bench::DoNotOptimize(out.back().Value);
+            state.AddCounter("mpoints_per_s", static_cast<double>(out.size()) / us);
+        }
+    }
+
+    // 序列在首次运行时才生成，未被选中时不产生开销
+    const bool kRegistered = []() {
+        for (size_t i = 0; i < std::size(kSeriesNames); ++i)
+        {
+            bench::GetRegistry().push_back({ fmt::format("History/Append/{}", kSeriesNames[i]), 50,
+                [i](bench::State& state) { RunAppendBench(state, GetSeries()[i], kSeriesFractionBits[i]); } });
+            bench::GetRegistry().push_back({ fmt::format("History/Append/{}/Lossless", kSeriesNames[i]), 50,
+                [i](bench::State& state) { RunAppendBench(state, GetSeries()[i], CompressedSeries::kLossless); } });
+            bench::GetRegistry().push_back({ fmt::format("History/Decode/{}", kSeriesNames[i]), 200,
+                [i](bench::State& state) { RunDecodeBench(state, GetSeries()[i]); } });
+        }
+        return true;
+    }();
+}
+
+PSM_BENCH("History/Window/Cached", 1000)
+{
+    auto series = Compress(GetSeries()[0], GetSeries()[0].FractionBits);
+    series.GetWindow(150);
+    while (state.Loop())
+        bench::DoNotOptimize(series.GetWindow(150).back());
+}
+
+PSM_BENCH("History/Window/DecodeLast", 1000)
+{
+    auto series = Compress(GetSeries()[0], GetSeries()[0].FractionBits);
+    std::vector<double> window;
+    while (state.Loop())
+    {
+        series.DecodeLast(150, window);
+        bench::DoNotOptimize(window.back());
+    }
+}
+
+PSM_BENCH("History/Rollup/Append", 50)
+{
+    const auto& data = GetSeries()[0];
+    while (state.Loop())
+    {
+        RollupSeries rollup;
+        for (const auto& point : data.Points)
+            rollup.Append(point.TimestampMs, point.Value);
+        bench::DoNotOptimize(rollup.GetBucketCount(RollupSeries::Tier::Minute));
+        state.AddCounter("points", static_cast<double>(data.Points.size()));
+    }
+}
+
+PSM_BENCH("History/Rollup/CopyRecent", 1000)
+{
+    RollupSeries rollup;
+    for (const auto& point : GetSeries()[0].Points)
+        rollup.Append(point.TimestampMs, point.Value);
+    std::vector<double> min, max, average;
+    auto tier = RollupSeries::SelectTier(24 * 60 * 60 * 1000, 300);
+    auto slots = (24 * 60 * 60 * 1000 + RollupSeries::GetTierWidthMs(tier) - 1) / RollupSeries::GetTierWidthMs(tier);
+    auto endMs = GetSeries()[0].Points.back().TimestampMs;
+    while (state.Loop())
+    {
+        rollup.CopyRecent(tier, endMs, slots, min, max, average);
+        bench::DoNotOptimize(average.back());
+    }
+}
+
+PSM_BENCH("History/Rollup/Gaps", 100)
+{
+    // 两段采样之间中断 1 小时，中断期间的槽应为空，各桶按起始时间放在对应的槽中
+    static const uint64_t kMinuteMs = 60 * 1000;
+    auto startMs = kStartTimestampMs - kStartTimestampMs % kMinuteMs;
+    RollupSeries rollup;
+    for (uint64_t i = 0; i < 10 * 60; ++i)
+        rollup.Append(startMs + i * 1000, 1.);
+    auto resumeMs = startMs + 70 * kMinuteMs;
+    for (uint64_t i = 0; i < 10 * 60; ++i)
+        rollup.Append(resumeMs + i * 1000, 2.);
+    auto endMs = resumeMs + 10 * 60 * 1000 - 1000;
+
+    std::vector<double> min, max, average;
+    while (state.Loop())
+    {
+        rollup.CopyRecent(RollupSeries::Tier::Minute, endMs, 120, min, max, average);
+        for (size_t i = 0; i < 120; ++i)
+        {
+            // 槽 i 的起始时间为 endMs 所在分钟之前 119 - i 分钟
+            auto slotStartMs = endMs - endMs % kMinuteMs - (119 - i) * kMinuteMs;
+            double expected = std::numeric_limits<double>::quiet_NaN();
+            if (slotStartMs >= startMs && slotStartMs < startMs + 10 * kMinuteMs)
+                expected = 1.;
+            else if (slotStartMs >= resumeMs)
+                expected = 2.;
+            if (average[i] != expected && !(std::isnan(average[i]) && std::isnan(expected)))
+                bench::Fail(fmt::format("Rollup/Gaps: slot {} is {}, expected {}", i, average[i], expected));
+        }
+    }
+}
+
+PSM_BENCH("History/Lod/Decimate", 1000)
+{
+    std::vector<double> values;
+    for (const auto& point : GetSeries()[0].Points)
+        values.push_back(point.Value);
+    std::vector<double> xs, ys;
+    while (state.Loop())
+    {
+        SparklineLod::Decimate(values.data(), values.size(), 300, 0, xs, ys);
+        bench::DoNotOptimize(ys.back());
+        state.AddCounter("points_out", static_cast<double>(xs.size()));
+    }
+}
+
+PSM_BENCH("History/Lod/PushAndOutput", 1000)
+{
+    // 模拟每次采样追加一个值后绘制一帧
+    const auto& points = GetSeries()[0].Points;
+    SparklineLod lod;
+    lod.Rebuild(nullptr, 0, points.size(), 300);
+    for (const auto& point : points)
+        lod.Push(point.Value);
+    size_t i = 0;
+    while (state.Loop())
+    {
+        lod.Push(points[i++ % points.size()].Value);
+        bench::DoNotOptimize(lod.GetY().back());
+        state.AddCounter("points_out", static_cast<double>(lod.GetX().size()));
+    }
+}
+
+PSM_BENCH("History/Quantile/Add", 50)
+{
+    const auto& data = GetSeries()[0];
+    while (state.Loop())
+    {
+        WindowedQuantileSketch sketch(10 * 60 * 1000);
+        for (const auto& point : data.Points)
+            sketch.Add(point.TimestampMs, point.Value);
+        bench::DoNotOptimize(sketch.GetMerged().GetCount());
+        state.AddCounter("points", static_cast<double>(data.Points.size()));
+    }
+}
+
+PSM_BENCH("History/Quantile/Merge", 1000)
+{
+    // 模拟按核心合并：同一序列的 64 份窗口估计合并后取 p99
+    const auto& data = GetSeries()[0];
+    WindowedQuantileSketch sketch(10 * 60 * 1000);
+    for (const auto& point : data.Points)
+        sketch.Add(point.TimestampMs, point.Value);
+    QuantileSketch merged;
+    while (state.Loop())
+    {
+        merged.Clear();
+        for (int i = 0; i < 64; ++i)
+            sketch.MergeInto(merged);
+        bench::DoNotOptimize(merged.GetQuantile(0.99));
+    }
+}
+
+namespace
+{
+    /**
+     * 逐点比较编码后再解码的结果，按位比较以覆盖 NaN 与 ±0
+     * @param name 用例名称
+     * @param points 输入
+     * @param fractionBits 见 CompressedSeries
+     */
+    void CheckRoundTrip(const char* name, const std::vector<CompressedSeries::Point>& points, int fractionBits)
+    {
+        static const size_t kWindowCount = CompressedSeries::kChunkPoints + 1;
+
+        // 保留时长足够长，不丢弃任何块
+        CompressedSeries series(1ull << 62, fractionBits);
+        std::vector<CompressedSeries::Point> expected;
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            series.Append(points[i].TimestampMs, points[i].Value);
+            auto value = points[i].Value;
+            if (fractionBits >= 0)
+                value = std::ldexp(std::nearbyint(std::ldexp(value, fractionBits)), -fractionBits);
+            expected.push_back({ points[i].TimestampMs, value });
+
+            // 写到一半时取一次窗口，之后由 Append 增量维护
+            if (i == points.size() / 2)
+                series.GetWindow(kWindowCount);
+        }
+        if (series.GetSize() != expected.size())
+            bench::Fail(fmt::format("{}: size {} != {}", name, series.GetSize(), expected.size()));
+
+        std::vector<CompressedSeries::Point> decoded;
+        series.Decode(0, decoded);
+        if (decoded.size() != expected.size())
+            bench::Fail(fmt::format("{}: decoded {} of {} points", name, decoded.size(), expected.size()));
+        for (size_t i = 0; i < expected.size(); ++i)
+        {
+            if (decoded[i].TimestampMs != expected[i].TimestampMs || !SameBits(decoded[i].Value, expected[i].Value))
+            {
+                bench::Fail(fmt::format("{}: point {} decoded as ({}, {}), expected ({}, {})", name, i, decoded[i].TimestampMs,
+                    decoded[i].Value, expected[i].TimestampMs, expected[i].Value));
+            }
+        }
+
+        // 从中间开始解码
+        if (!expected.empty())
+        {
+            auto from = expected[expected.size() / 3].TimestampMs;
+            auto first = std::lower_bound(expected.begin(), expected.end(), from,
+                [](const CompressedSeries::Point& point, uint64_t value) { return point.TimestampMs < value; });
+            decoded.clear();
+            series.Decode(from, decoded);
+            if (decoded.size() != static_cast<size_t>(expected.end() - first))
+                bench::Fail(fmt::format("{}: Decode({}) returned {} points", name, from, decoded.size()));
+        }
+
+        // 最近 N 个点，覆盖块边界两侧
+        auto checkTail = [&](const std::vector<double>& values, size_t count, const char* what) {
+            auto n = std::min(count, expected.size());
+            if (values.size() != n)
+                bench::Fail(fmt::format("{}: {}({}) returned {} points", name, what, count, values.size()));
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (!SameBits(values[i], expected[expected.size() - n + i].Value))
+                    bench::Fail(fmt::format("{}: {}({}) point {} mismatch", name, what, count, i));
+            }
+        };
+        std::vector<double> tail;
+        for (size_t count : { size_t(1), CompressedSeries::kChunkPoints - 1, CompressedSeries::kChunkPoints,
+            CompressedSeries::kChunkPoints + 1, expected.size(), expected.size() + 5 })
+        {
+            series.DecodeLast(count, tail);
+            checkTail(tail, count, "DecodeLast");
+        }
+        checkTail(series.GetWindow(kWindowCount), kWindowCount, "GetWindow");
+        const auto& timestamps = series.GetWindowTimestamps();
+        for (size_t i = 0; i < timestamps.size(); ++i)
+        {
+            if (timestamps[i] != expected[expected.size() - timestamps.size() + i].TimestampMs)
+                bench::Fail(fmt::format("{}: GetWindowTimestamps point {} mismatch", name, i));
+        }
+    }
+
+    using RoundTripCase = std::pair<const char*, std::vector<CompressedSeries::Point>>;
+
+    /**
+     * 各类边界输入
+     */
+    std::vector<RoundTripCase> GetRoundTripCases()
+    {
+        std::vector<RoundTripCase> cases;
+        std::mt19937_64 rng(42);
+
+        auto& constant = cases.emplace_back("constant", std::vector<CompressedSeries::Point>()).second;
+        for (uint64_t i = 0; i < 2000; ++i)
+            constant.push_back({ kStartTimestampMs + i * 1000, 42.5 });
+
+        // 任意位模式（包括 NaN 与非规格化数），时间戳带抖动
+        auto& random = cases.emplace_back("random", std::vector<CompressedSeries::Point>()).second;
+        auto timestampMs = kStartTimestampMs;
+        for (size_t i = 0; i < 3000; ++i)
+        {
+            timestampMs += 990 + rng() % 21;
+            random.push_back({ timestampMs, std::bit_cast<double>(rng()) });
+        }
+
+        const double kSpecial[] = { 0., -0., std::numeric_limits<double>::quiet_NaN(), -std::numeric_limits<double>::quiet_NaN(),
+            std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::denorm_min(),
+            std::numeric_limits<double>::max(), std::numeric_limits<double>::lowest(), 1., 1., -1., 0. };
+        auto& special = cases.emplace_back("nan_and_signed_zero", std::vector<CompressedSeries::Point>()).second;
+        for (size_t i = 0; i < 1100; ++i)
+            special.push_back({ kStartTimestampMs + i * 1000, kSpecial[(i * 7) % std::size(kSpecial)] });
+
+        // 二阶差分落在各编码区间的两端与之外，以及跨越数十年的跳变
+        const int64_t kDeltaOfDeltas[] = { 0, -63, 64, 65, -64, -255, 256, 257, -256, -2047, 2048, 2049, -2048, 1000000,
+            -1000000, int64_t(1) << 40, -(int64_t(1) << 40) };
+        auto& jumps = cases.emplace_back("timestamp_jumps", std::vector<CompressedSeries::Point>()).second;
+        timestampMs = kStartTimestampMs;
+        int64_t deltaMs = 1000;
+        for (size_t i = 0; i < 1200; ++i)
+        {
+            auto deltaOfDelta = kDeltaOfDeltas[i % std::size(kDeltaOfDeltas)];
+            if (deltaMs + deltaOfDelta >= 0)
+                deltaMs += deltaOfDelta;
+            timestampMs += static_cast<uint64_t>(deltaMs);
+            jumps.push_back({ timestampMs, static_cast<double>(i) });
+        }
+
+        // 恰好写满、多一个、少一个点的块
+        for (auto count : { CompressedSeries::kChunkPoints, CompressedSeries::kChunkPoints + 1, 2 * CompressedSeries::kChunkPoints - 1,
+            2 * CompressedSeries::kChunkPoints })
+        {
+            auto& boundary = cases.emplace_back("chunk_boundary", std::vector<CompressedSeries::Point>()).second;
+            for (size_t i = 0; i < count; ++i)
+                boundary.push_back({ kStartTimestampMs + i * 1000, static_cast<double>(rng() % 1000) / 8. });
+        }
+        return cases;
+    }
+}
+
+PSM_BENCH("History/RoundTrip", 5)
+{
+    // 手写的位级编解码器没有其他测试覆盖，每次运行都逐点校验，不一致时进程以非 0 退出
+    static const auto kCases = GetRoundTripCases();
+    while (state.Loop())
+    {
+        for (const auto& [name, points] : kCases)
+            CheckRoundTrip(name, points, CompressedSeries::kLossless);
+        for (const auto& data : GetSeries())
+            CheckRoundTrip(data.Name, data.Points, data.FractionBits);
+    }
+}
+
+PSM_BENCH("History/Retention", 5)
+{
+    // 超出保留时长的块整块丢弃，剩余的点仍与输入的末尾一致
+    static const uint64_t kRetentionMs = 10 * 60 * 1000;
+    const auto& points = GetSeries()[0].Points;
+    while (state.Loop())
+    {
+        CompressedSeries series(kRetentionMs, CompressedSeries::kLossless);
+        for (const auto& point : points)
+            series.Append(point.TimestampMs, point.Value);
+        if (series.GetSize() >= points.size())
+            bench::Fail("Retention: nothing was dropped");
+        if (points[points.size() - series.GetSize() - 1].TimestampMs + kRetentionMs >= points.back().TimestampMs)
+            bench::Fail("Retention: dropped points still within the retention");
+
+        std::vector<CompressedSeries::Point> decoded;
+        series.Decode(0, decoded);
+        if (decoded.size() != series.GetSize())
+            bench::Fail("Retention: decoded size mismatch");
+        auto offset = points.size() - decoded.size();
+        for (size_t i = 0; i < decoded.size(); ++i)
+        {
+            if (decoded[i].TimestampMs != points[offset + i].TimestampMs || !SameBits(decoded[i].Value, points[offset + i].Value))
+                bench::Fail(fmt::format("Retention: point {} mismatch", i));
+        }
+    }
+}
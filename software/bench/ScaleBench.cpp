@@ -0,0 +1,202 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include "Bench.hpp"
+
+#include <fmt/format.h>
+#include <ColumnStore.hpp>
+#include <MetricsSampleThread.hpp>
+#include <SyntheticExporter.hpp>
+
+using namespace std;
+
+namespace
+{
+    struct HostSize
+    {
+        const char* Name;
+        int CpuCount;
+        int DiskCount;
+        int NetworkCount;
+    };
+
+    // 从树莓派到大型服务器（大量 dm-* 卷与容器 veth）
+    constexpr HostSize kHostSizes[] = {
+        { "4cpu", 4, 2, 2 },
+        { "32cpu", 32, 16, 16 },
+        { "128cpu", 128, 128, 128 },
+        { "256cpu", 256, 512, 512 },
+    };
+
+    constexpr uint64_t kStartTimestampMs = 1700000000000;
+    constexpr uint64_t kIntervalMs = 1000;
+
+    SyntheticExporter CreateExporter(const HostSize& size)
+    {
+        SyntheticExporter::Config config;
+        config.CpuCount = size.CpuCount;
+        config.DiskCount = size.DiskCount;
+        config.NetworkCount = size.NetworkCount;
+        return SyntheticExporter(config);
+    }
+
+    void RunParseBench(bench::State& state, const HostSize& size)
+    {
+        auto exporter = CreateExporter(size);
+        auto body = exporter.Render(kStartTimestampMs);
+
+        while (state.Loop())
+        {
+            MetricsSampleThread::RawMetrics raw;
+            MetricsSampleThread::ParseMetrics(body, raw);
+            state.AddCounter("bytes", static_cast<double>(body.size()));
+        }
+    }
+
+    void RunComputeBench(bench::State& state, const HostSize& size)
+    {
+        auto exporter = CreateExporter(size);
+        MetricsSampleThread::RawMetrics last, raw;
+        MetricsSampleThread::ParseMetrics(exporter.Render(kStartTimestampMs), last);
+        last.Tick = 0;
+        MetricsSampleThread::ParseMetrics(exporter.Render(kStartTimestampMs + kIntervalMs), raw);
+        raw.Tick = kIntervalMs;
+
+        while (state.Loop())
+        {
+            MetricsSampleThread::MetricsResult metrics;
+            MetricsSampleThread::ComputeMetrics(raw, last, metrics);
+        }
+    }
+
+    void RunRenderBench(bench::State& state, const HostSize& size)
+    {
+        auto exporter = CreateExporter(size);
+        auto timestamp = kStartTimestampMs;
+
+        while (state.Loop())
+        {
+            auto body = exporter.Render(timestamp);
+            timestamp += kIntervalMs;
+            state.AddCounter("bytes", static_cast<double>(body.size()));
+        }
+    }
+
+    MetricsSampleThread::MetricsResult ComputeOnce(const HostSize& size)
+    {
+        auto exporter = CreateExporter(size);
+        MetricsSampleThread::RawMetrics last, raw;
+        MetricsSampleThread::ParseMetrics(exporter.Render(kStartTimestampMs), last);
+        last.Tick = 0;
+        MetricsSampleThread::ParseMetrics(exporter.Render(kStartTimestampMs + kIntervalMs), raw);
+        raw.Tick = kIntervalMs;
+        MetricsSampleThread::MetricsResult metrics;
+        MetricsSampleThread::ComputeMetrics(raw, last, metrics);
+        return metrics;
+    }
+
+    void RunColumnAppendBench(bench::State& state, const HostSize& size)
+    {
+        // 每次采样写入全部核心与设备的列，并得到界面所需的汇总值
+        auto metrics = ComputeOnce(size);
+        ColumnStore cpu(150), diskRead(150), diskWrite(150), networkReceive(150), networkTransmit(150);
+
+        while (state.Loop())
+        {
+            cpu.AppendRow(metrics.CpuUsage);
+            diskRead.AppendRow(metrics.DiskReadBytesPerSecond);
+            diskWrite.AppendRow(metrics.DiskWrittenBytesPerSecond);
+            networkReceive.AppendRow(metrics.NetworkReceiveBytesPerSecond);
+            networkTransmit.AppendRow(metrics.NetworkTransmitBytesPerSecond);
+            bench::DoNotOptimize(cpu.MeanLatest() + diskRead.SumLatest() + diskWrite.SumLatest() + networkReceive.SumLatest() +
+                networkTransmit.SumLatest());
+            state.AddCounter("entities", static_cast<double>(cpu.GetEntityCount() + diskRead.GetEntityCount() +
+                diskWrite.GetEntityCount() + networkReceive.GetEntityCount() + networkTransmit.GetEntityCount()));
+        }
+    }
+
+    void RunColumnReduceBench(bench::State& state, const HostSize& size)
+    {
+        // 最近一行上的求和，以及每列整段历史的平均值与最大值
+        auto metrics = ComputeOnce(size);
+        ColumnStore diskRead(150);
+        for (int i = 0; i < 150; ++i)
+            diskRead.AppendRow(metrics.DiskReadBytesPerSecond);
+
+        while (state.Loop())
+        {
+            auto sum = diskRead.SumLatest();
+            for (size_t i = 0; i < diskRead.GetEntityCount(); ++i)
+            {
+                sum += ColumnStore::Mean(diskRead.GetColumn(i), diskRead.GetCapacity()) +
+                    ColumnStore::Max(diskRead.GetColumn(i), diskRead.GetCapacity());
+            }
+            bench::DoNotOptimize(sum);
+            state.AddCounter("values", static_cast<double>(diskRead.GetEntityCount() * (diskRead.GetCapacity() + 2)));
+        }
+    }
+
+    void RunColumnChurnBench(bench::State& state, const HostSize& size)
+    {
+        // 容器网卡持续更替：每次采样一半设备沿用，另一半换成新名称，旧设备缺失满一个窗口后应被移除
+        static const size_t kCapacity = 150;
+        auto count = static_cast<size_t>(size.NetworkCount);
+        ColumnStore networkReceive(kCapacity);
+        std::map<std::string, double> row;
+        size_t generation = 0;
+
+        while (state.Loop())
+        {
+            for (int i = 0; i < 10; ++i, ++generation)
+            {
+                row.clear();
+                for (size_t j = 0; j < count; ++j)
+                {
+                    auto name = j < count / 2 ? fmt::format("eth{}", j) : fmt::format("veth{}", generation * count + j);
+                    row.emplace(std::move(name), static_cast<double>(j));
+                }
+                networkReceive.AppendRow(row);
+            }
+
+            // 最多保留窗口内出现过的实体
+            auto limit = count / 2 + (kCapacity + 1) * (count - count / 2);
+            if (networkReceive.GetEntityCount() > limit)
+                bench::Fail(fmt::format("ColumnChurn: {} entities after {} rows, expected at most {}", networkReceive.GetEntityCount(),
+                    generation, limit));
+            state.AddCounter("entities", static_cast<double>(networkReceive.GetEntityCount()));
+        }
+
+        // 固定的设备最先加入，移除其他实体后仍位于最前且保留完整的历史，值不随时间变化
+        for (size_t j = 0; j < count / 2; ++j)
+        {
+            const auto* column = networkReceive.GetColumn(j);
+            for (size_t k = 0; k < kCapacity; ++k)
+            {
+                if (column[k] != networkReceive.GetLatestRow()[j])
+                    bench::Fail(fmt::format("ColumnChurn: column {} history corrupted at {}", j, k));
+            }
+        }
+    }
+
+    // 按主机规模展开注册
+    const bool kRegistered = []() {
+        for (const auto& size : kHostSizes)
+        {
+            bench::GetRegistry().push_back({ fmt::format("Scale/Parse/{}", size.Name), 50,
+                [&size](bench::State& state) { RunParseBench(state, size); } });
+            bench::GetRegistry().push_back({ fmt::format("Scale/Compute/{}", size.Name), 200,
+                [&size](bench::State& state) { RunComputeBench(state, size); } });
+            bench::GetRegistry().push_back({ fmt::format("Scale/ExporterRender/{}", size.Name), 50,
+                [&size](bench::State& state) { RunRenderBench(state, size); } });
+            bench::GetRegistry().push_back({ fmt::format("Scale/ColumnAppend/{}", size.Name), 200,
+                [&size](bench::State& state) { RunColumnAppendBench(state, size); } });
+            bench::GetRegistry().push_back({ fmt::format("Scale/ColumnReduce/{}", size.Name), 200,
+                [&size](bench::State& state) { RunColumnReduceBench(state, size); } });
+            bench::GetRegistry().push_back({ fmt::format("Scale/ColumnChurn/{}", size.Name), 20,
+                [&size](bench::State& state) { RunColumnChurnBench(state, size); } });
+        }
+        return true;
+    }();
+}
@@ -4,10 +4,23 @@
  * @date 2024/11/17
  */
 #pragma once
+#include <array>
+#include <map>
+#include <string>
+#include <string_view>
 #include <thread>
 #include <imgui.h>
 #include "AppBase.hpp"
+#include "ColumnStore.hpp"
+#include "CompressedSeries.hpp"
+#include "HeatmapTexture.hpp"
+#include "HistoryFile.hpp"
+#include "MetricsHistory.hpp"
 #include "MetricsSampleThread.hpp"
+#include "RollupSeries.hpp"
+#include "SparklineLod.hpp"
+#include "StackedHistory.hpp"
+#include "WindowedQuantileSketch.hpp"
 
 class App :
     public AppBase
@@ -19,24 +32,128 @@ protected: // AppBase
     void OnStart() noexcept override;
     void OnFrame(double delta) noexcept override;
     void OnStop() noexcept override;
+    void OnFramePresented(uint64_t presentTick) noexcept override;
 
 private:
-    static const size_t kHistorySampleCount = 150;
+    static const size_t kHistorySampleCount = 150;  // 默认值，可通过 HISTORY_SAMPLES 调整
+    static const uint64_t kDefaultQuantileWindowMs = 0;  // 默认不显示，可通过 QUANTILE_WINDOW_S 开启
+    static const size_t kSeriesCount = 6;  // 汇总序列：CPU、内存、磁盘读写、网络收发
+
+    /**
+     * 按设备统计的分位数估计
+     */
+    struct DeviceSketch
+    {
+        WindowedQuantileSketch Sketch;
+        uint64_t LastTimestampMs = 0;  // 最后一次记录的时间，设备消失超过窗口后释放
+    };
+
+    using DeviceSketchMap = std::map<std::string, DeviceSketch, std::less<>>;
+    using DeviceSeriesMap = std::map<std::string, CompressedSeries, std::less<>>;
+
+    /**
+     * 将本次采样的汇总值以及每个核心、每个设备的值记录到长期历史，并更新分位数估计
+     */
+    void RecordAllSeries();
+
+    /**
+     * 记录一个核心或设备的长期历史
+     * @param index 所属汇总序列的下标，与 kSeriesNames 一致
+     * @param key 核心序号或设备名
+     */
+    void RecordDeviceSeries(size_t index, std::string_view key, double value);
+
+    /**
+     * 记录一个核心或设备的值
+     * @param sketches 所属汇总序列的按设备估计
+     * @param key 核心序号或设备名
+     */
+    void RecordDeviceSketch(DeviceSketchMap& sketches, std::string_view key, double value);
+
+    /**
+     * 更新各行显示的 p50/p95/p99
+     *
+     * 默认使用汇总序列自身的分布；按设备模式下将每个核心、每个设备的估计合并，反映单个核心、设备的分布。
+     */
+    void UpdateQuantiles();
+
+    /**
+     * 磁盘详情页：按 %util 从高到低列出各设备的使用率、IOPS、await 与队列深度
+     */
+    void DrawDiskPage() noexcept;
 
     ImFont* m_pDefaultFont = nullptr;
     ImFont* m_pNumericFont = nullptr;
     ImFont* m_pDefaultTinyFont = nullptr;
     ImFont* m_pNumericTinyFont = nullptr;
 
+    uint64_t m_uStartTick = 0;  // OnStart 时的 SDL_GetPerformanceCounter
+    bool m_bFirstValidFrameRecorded = false;
+    int m_iProfilerPage = 0;  // 性能 HUD，0 为关闭，按 F1 依次切换帧耗时、采样延迟页面
+    int m_iHistoryRange = 0;  // 曲线时间范围，0 为最近的采样，按 F2 依次切换更长的范围
+    bool m_bQuantilePerDevice = false;  // 分位数按核心、设备统计，按 F3 切换
+    bool m_bShowDiskPage = false;  // 按 F4 切换主页面与磁盘详情页
+
     MetricsSampleThread m_stSampleThread;
     std::thread m_stSampleThreadHandle;
 
     // 采样数据
     MetricsSampleThread::MetricsResult m_stCurrentMetrics;
-    std::vector<double> m_stCpuUsageHistory;
-    std::vector<double> m_stMemoryUsageHistory;
-    std::vector<double> m_stIoReadHistory;
-    std::vector<double> m_stIoWriteHistory;
-    std::vector<double> m_stNetworkReceiveHistory;
-    std::vector<double> m_stNetworkTransmitHistory;
+    size_t m_uHistorySampleCount = kHistorySampleCount;
+    std::vector<MetricsSampleThread::LatencyTimestamps> m_stPendingLatency;  // 本帧取出、尚未显示的结果
+    ColumnStore m_stCpuCoreColumns { kHistorySampleCount };  // 每个核心、每个设备的历史，汇总值由其归约得到
+    ColumnStore m_stIoReadColumns { kHistorySampleCount };
+    ColumnStore m_stIoWriteColumns { kHistorySampleCount };
+    ColumnStore m_stNetworkReceiveColumns { kHistorySampleCount };
+    ColumnStore m_stNetworkTransmitColumns { kHistorySampleCount };
+    MetricsHistory m_stCpuUsageHistory { kHistorySampleCount };
+    MetricsHistory m_stMemoryUsageHistory { kHistorySampleCount };
+    MetricsHistory m_stIoReadHistory { kHistorySampleCount };
+    MetricsHistory m_stIoWriteHistory { kHistorySampleCount };
+    MetricsHistory m_stNetworkReceiveHistory { kHistorySampleCount };
+    MetricsHistory m_stNetworkTransmitHistory { kHistorySampleCount };
+    RollupSeries m_stCpuUsageRollup;  // 较长时间范围使用的降采样历史
+    RollupSeries m_stMemoryUsageRollup;
+    RollupSeries m_stIoReadRollup;
+    RollupSeries m_stIoWriteRollup;
+    RollupSeries m_stNetworkReceiveRollup;
+    RollupSeries m_stNetworkTransmitRollup;
+    SparklineLod m_stCpuUsageLod;  // 采样数超过曲线像素宽度时使用
+    SparklineLod m_stMemoryUsageLod;
+    SparklineLod m_stIoReadLod;
+    SparklineLod m_stIoWriteLod;
+    SparklineLod m_stNetworkReceiveLod;
+    SparklineLod m_stNetworkTransmitLod;
+    CompressedSeries m_stCpuUsageSeries;  // 长期历史（压缩存储），1 小时以内的范围直接绘制其中的原始采样
+    CompressedSeries m_stMemoryUsageSeries;
+    CompressedSeries m_stIoReadSeries;
+    CompressedSeries m_stIoWriteSeries;
+    CompressedSeries m_stNetworkReceiveSeries;
+    CompressedSeries m_stNetworkTransmitSeries;
+    std::array<DeviceSeriesMap, kSeriesCount> m_stDeviceSeries;  // 每个核心、每个设备的长期历史，设备消失超过保留时长后释放
+    StackedHistory m_stCpuModeHistory;  // 按 CPU 模式堆叠，各层见 kCpuModeLayers
+    bool m_bShowCpuModes = false;  // 默认不显示，可通过 CPU_MODES 开启
+    HeatmapTexture m_stCpuHeatmap;  // 每个核心的使用率
+    int m_iCpuHeatmapHeight = 0;  // 像素，0 为不显示（默认）
+    StackedHistory m_stMemoryLayerHistory;  // 按内存构成堆叠，各层见 kMemoryLayers
+    ColumnStore m_stMemoryFaultColumns { kHistorySampleCount };  // 主缺页、换入页、换出页的速率
+    bool m_bShowMemoryDetail = false;  // 默认不显示，可通过 MEM_DETAIL 开启
+    ColumnStore m_stPressureColumns { kHistorySampleCount };  // PSI，前三列为各资源的 some，后三列为 full，顺序见 kPressureLayers
+    bool m_bShowPressure = true;
+    std::vector<const std::pair<const std::string, MetricsSampleThread::DiskStats>*> m_stDiskRanking;  // 指向 m_stCurrentMetrics.Disks
+    std::vector<double> m_stRollupMin;  // 绘制降采样历史时的临时缓冲区
+    std::vector<double> m_stRollupMax;
+    std::vector<double> m_stRollupAverage;
+    std::vector<double> m_stLodFillX;
+    std::vector<double> m_stLodFillY;
+    std::vector<double> m_stLodLineX;
+    std::vector<double> m_stLodLineY;
+    HistoryFile m_stHistoryFile;  // 持久化上述历史，重启后可直接恢复
+    uint64_t m_uSeriesRetentionMs = CompressedSeries::kDefaultRetentionMs;
+    double m_dSampleIntervalMs = 1000.;  // 用于将时间范围换算为长期历史中的点数
+    uint64_t m_uQuantileWindowMs = kDefaultQuantileWindowMs;
+    std::vector<WindowedQuantileSketch> m_stSketches;  // 各汇总序列的分位数估计，顺序见 kSeriesNames
+    std::array<DeviceSketchMap, kSeriesCount> m_stDeviceSketches;  // 每个核心、每个设备的估计，按 F3 合并显示
+    std::map<std::string, std::array<double, 3>> m_stQuantiles;  // 各行显示的 p50/p95/p99，按汇总序列名索引
+    QuantileSketch m_stQuantileScratch;
 };
@@ -4,18 +4,49 @@
  * @date 2024/11/14
  */
 #pragma once
+#include <memory>
+#include <string>
 #include <SDL.h>
 #include "Result.hpp"
+#include "IDisplay.hpp"
+#include "FrameProfiler.hpp"
+
+/**
+ * 显示后端类型
+ */
+enum class DisplayType
+{
+    SDL,  // SDL 窗口 + OpenGL 2，需要桌面环境
+    Kms,  // DRM/KMS + GBM + EGL + GLES2，无需桌面环境
+    Framebuffer,  // CPU 光栅化后直接写入 /dev/fbN
+    Headless,  // CPU 光栅化到内存，运行指定帧数后退出，用于基准测试与图像比对
+};
+
+/**
+ * 无头模式配置
+ */
+struct HeadlessConfig
+{
+    int Frames = 100;  // 渲染帧数，到达后请求退出
+    int WarmupFrames = 1;  // 不计入统计的起始帧数
+    std::string DumpDirectory;  // PNG 输出目录，为空时不输出
+    int DumpEvery = 0;  // 每隔多少帧输出一次 PNG，为 0 时仅输出最后一帧
+    std::string StatsPath;  // 帧耗时统计 JSON 输出路径，"-" 表示标准输出，为空时不输出
+    double FixedDeltaTime = 0;  // 固定帧间隔（秒），为 0 时使用真实时间
+};
 
 struct AppBaseConfig
 {
     std::string Title;
     int InitialWidth = 1280;
     int InitialHeight = 720;
-    double TargetFPS = 10;
+    double TargetFPS = 10;  // 为 0 时不限制帧率
     bool Resizable = false;
     bool Borderless = true;
     bool FullScreen = false;
+    DisplayType Display = DisplayType::SDL;
+    std::string DisplayDevice;  // 显示设备路径，为空时自动探测
+    HeadlessConfig Headless;
 };
 
 class AppBase
@@ -34,9 +65,23 @@ protected:
     virtual void OnStop() noexcept = 0;
     virtual void OnExitRequest(bool& doExit) noexcept;
 
+    /**
+     * 一帧提交完成后调用
+     * @param presentTick 提交完成的时间（SDL_GetPerformanceCounter）
+     */
+    virtual void OnFramePresented(uint64_t presentTick) noexcept;
+
+protected:
+    FrameProfiler& GetProfiler() noexcept { return m_stProfiler; }
+
+    /**
+     * 当前的显示后端，Initialize 成功后有效
+     */
+    IDisplay* GetDisplay() noexcept { return m_pDisplay.get(); }
+
 private:
-    ::SDL_Window* m_pMainWindow = nullptr;
-    ::SDL_GLContext m_pGLContext = nullptr;
+    std::unique_ptr<IDisplay> m_pDisplay;
     bool m_bExit = false;
     double m_dTargetFps = 10;
+    FrameProfiler m_stProfiler;
 };
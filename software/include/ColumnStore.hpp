@@ -0,0 +1,95 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * 按核心、按设备的列式历史
+ *
+ * 一个实例对应一项指标（如磁盘读取速率），每个实体（核心、设备）一列，保存最近 Capacity 个采样。
+ * 每列占用 2 × Capacity 的连续空间，写入时同时写到 head 与 head + Capacity 两处，任何时刻
+ * [head, head + Capacity) 都是从旧到新的连续窗口，可直接交给 ImPlot 或归约函数而无需复制。
+ * 另外单独保存最近一行，跨实体的求和、平均值都在这段连续内存上进行。
+ *
+ * 某次采样中缺失的实体记为 0，新出现的实体之前的历史同样为 0。连续缺失满 Capacity 次的实体，其窗口内已全部为 0，
+ * 此时将其移除，之后的实体下标前移，热插拔的设备与容器网卡不会无限累积。
+ */
+class ColumnStore
+{
+public:
+    /**
+     * 求和，使用多个累加器，便于编译器向量化
+     */
+    static double Sum(const double* values, size_t count) noexcept;
+
+    /**
+     * 平均值，count 为 0 时返回 0
+     */
+    static double Mean(const double* values, size_t count) noexcept;
+
+    /**
+     * 最大值，count 为 0 时返回 0
+     */
+    static double Max(const double* values, size_t count) noexcept;
+
+public:
+    explicit ColumnStore(size_t capacity = 0);
+
+public:
+    /**
+     * 修改每列保存的采样数，清空已有历史
+     */
+    void Reset(size_t capacity);
+
+    /**
+     * 追加一行，第 i 个值属于第 i 个实体（如 CPU 核心）
+     *
+     * 只有末尾的实体会缺失，移除后其余实体的下标不变。
+     */
+    void AppendRow(const std::vector<double>& values);
+
+    /**
+     * 追加一行，按名称对应到实体（如磁盘、网卡）
+     */
+    void AppendRow(const std::map<std::string, double>& values);
+
+    size_t GetCapacity() const noexcept { return m_uCapacity; }
+    size_t GetEntityCount() const noexcept { return m_stNames.size(); }
+
+    /**
+     * 某个实体的历史，共 GetCapacity() 个值，从旧到新
+     */
+    const double* GetColumn(size_t index) const noexcept;
+
+    /**
+     * 最近一行，共 GetEntityCount() 个值
+     */
+    const double* GetLatestRow() const noexcept { return m_stLatest.data(); }
+
+    double SumLatest() const noexcept { return Sum(m_stLatest.data(), m_stLatest.size()); }
+    double MeanLatest() const noexcept { return Mean(m_stLatest.data(), m_stLatest.size()); }
+
+private:
+    size_t AddEntity(const std::string& name);
+    void WriteRow();
+    void EvictAbsent();
+
+private:
+    size_t m_uCapacity = 0;
+    size_t m_uHead = 0;  // 下一次写入的位置
+    uint64_t m_uRowCount = 0;  // 已写入的行数
+    std::vector<std::string> m_stNames;
+    std::unordered_map<std::string, uint32_t> m_stIndex;
+    std::vector<double> m_stData;  // 第 i 列位于 [i × 2 × Capacity, (i + 1) × 2 × Capacity)
+    std::vector<double> m_stLatest;
+    std::vector<uint64_t> m_stLastSeenRows;  // 各实体最后一次出现时的行号
+    std::vector<uint32_t> m_stLastOrder;  // 上一次按名称追加时各项对应的实体，名称不变时跳过查找
+};
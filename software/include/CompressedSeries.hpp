@@ -0,0 +1,125 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+/**
+ * 压缩存储的时间序列
+ *
+ * 采用 Gorilla 编码：时间戳记录二阶差分，值记录与上一个值的异或结果中的有效位。每 kChunkPoints 个点为一块，
+ * 写满后封存且不再修改，超出保留时长的块整块丢弃。变化平缓或取值重复的序列每个点只需 1~2 字节。
+ *
+ * 派生出的速率等数值尾数位基本是随机的，几乎无法压缩。可指定 fractionBits 将值舍入到 2^-fractionBits 的整数倍，
+ * 使低位为 0 后再编码，例如字节速率取 0（整数）、百分比取 8（约 0.004%）。
+ *
+ * 最近一段数据可通过 GetWindow 以连续的 double 数组取得，结果会被缓存并随 Append 增量更新，绘制时无需每帧解码。
+ */
+class CompressedSeries
+{
+public:
+    static constexpr size_t kChunkPoints = 512;
+    static constexpr uint64_t kDefaultRetentionMs = 24ull * 60 * 60 * 1000;
+    static constexpr int kLossless = -1;
+
+    struct Point
+    {
+        uint64_t TimestampMs = 0;
+        double Value = 0;
+    };
+
+public:
+    /**
+     * @param retentionMs 保留时长
+     * @param fractionBits 保留的二进制小数位数，kLossless 表示不舍入
+     */
+    explicit CompressedSeries(uint64_t retentionMs = kDefaultRetentionMs, int fractionBits = kLossless) noexcept
+        : m_uRetentionMs(retentionMs), m_iFractionBits(fractionBits) {}
+
+public:
+    /**
+     * 追加一个点，时间戳应递增
+     * @param timestampMs UNIX 时间（毫秒）
+     * @param value 值，按 fractionBits 舍入后保存
+     */
+    void Append(uint64_t timestampMs, double value);
+
+    /**
+     * 按时间顺序解码不早于 fromMs 的点
+     * @param fromMs 起始时间
+     * @param[out] out 结果，追加在末尾
+     */
+    void Decode(uint64_t fromMs, std::vector<Point>& out) const;
+
+    /**
+     * 按时间顺序解码最近 count 个点的值
+     * @param count 数量，不足时返回全部
+     * @param[out] out 结果，会被清空
+     * @param[out] timestamps 可选，对应的时间戳，会被清空
+     */
+    void DecodeLast(size_t count, std::vector<double>& out, std::vector<uint64_t>* timestamps = nullptr) const;
+
+    /**
+     * 最近 count 个点的值（缓存）
+     *
+     * count 不变时，只有首次调用或丢弃旧数据后才会解码，之后由 Append 增量维护。
+     */
+    const std::vector<double>& GetWindow(size_t count);
+
+    /**
+     * 上一次 GetWindow 返回的各点的时间戳，用于按时间放置并识别采样中断
+     */
+    const std::vector<uint64_t>& GetWindowTimestamps() const noexcept { return m_stWindowTimestamps; }
+
+    /**
+     * 清空
+     */
+    void Clear() noexcept;
+
+    size_t GetSize() const noexcept { return m_uSize; }
+    uint64_t GetRetentionMs() const noexcept { return m_uRetentionMs; }
+    uint64_t GetFirstTimestampMs() const noexcept { return m_stChunks.empty() ? 0 : m_stChunks.front().FirstTimestampMs; }
+    uint64_t GetLastTimestampMs() const noexcept { return m_stChunks.empty() ? 0 : m_stChunks.back().LastTimestampMs; }
+
+    /**
+     * 压缩数据占用的字节数（不含窗口缓存）
+     */
+    size_t GetMemoryBytes() const noexcept;
+
+private:
+    struct Chunk
+    {
+        uint64_t FirstTimestampMs = 0;
+        uint64_t LastTimestampMs = 0;
+        uint32_t Count = 0;
+        uint64_t BitCount = 0;
+        std::vector<uint64_t> Words;  // 按位从高到低依次写入
+    };
+
+    void WriteBits(Chunk& chunk, uint64_t value, unsigned bits);
+    void DropExpired();
+
+private:
+    uint64_t m_uRetentionMs = 0;
+    int m_iFractionBits = kLossless;
+    std::deque<Chunk> m_stChunks;
+    size_t m_uSize = 0;
+
+    // 当前块的编码状态
+    int64_t m_iLastDeltaMs = 0;
+    uint64_t m_uLastValueBits = 0;
+    unsigned m_uLastLeadingZeros = 0;
+    unsigned m_uLastTrailingZeros = 0;
+    bool m_bHasLastWindow = false;  // 是否有可复用的有效位区间
+
+    // 窗口缓存
+    std::vector<double> m_stWindow;
+    std::vector<uint64_t> m_stWindowTimestamps;
+    size_t m_uWindowCount = 0;
+    bool m_bWindowValid = false;
+};
@@ -0,0 +1,60 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "Result.hpp"
+
+/**
+ * 设备名过滤器
+ *
+ * 规则为逗号分隔的通配符列表，支持 `*`、`?`、`[abc]`、`[a-z]`、`[!0-9]` 与 `\` 转义，以 `!` 开头的为排除规则。
+ * 设备被保留当且仅当：没有包含规则或至少匹配一条包含规则，并且不匹配任何排除规则。
+ *
+ * 所有规则在 Compile 时合并编译为一个 DFA（字节先归并为等价类以缩小转移表），匹配时每个字节只查一次表，
+ * 一旦进入死状态（不可能再匹配任何规则）立即返回，因此开销与规则数量无关，通常只需检查设备名的前几个字节。
+ * 未编译或规则为空时放行所有设备。
+ */
+class DeviceFilter
+{
+public:
+    /**
+     * 默认的磁盘规则：排除 loop、ram、光驱、device-mapper 与分区，避免与所在磁盘重复计算
+     */
+    static constexpr std::string_view kDefaultDiskRules =
+        "!loop*,!ram*,!zram*,!fd*,!sr*,!dm-*,!md*,!nbd*,"
+        "![hsv]d[a-z]*[0-9],!xvd[a-z]*[0-9],!nvme*p[0-9]*,!mmcblk*p[0-9]*";
+
+    /**
+     * 默认的网络接口规则：排除回环与容器、网桥、隧道等虚拟接口
+     */
+    static constexpr std::string_view kDefaultNetworkRules =
+        "!lo,!veth*,!docker*,!br-*,!virbr*,!cni*,!flannel*,!cali*,!vxlan*,!kube-*";
+
+public:
+    /**
+     * 编译规则，失败时保持原有规则不变
+     * @param rules 逗号分隔的规则列表，为空时放行所有设备
+     */
+    Result<void> Compile(std::string_view rules) noexcept;
+
+    /**
+     * 检查设备是否保留
+     */
+    bool Accept(std::string_view name) const noexcept;
+
+    bool IsEmpty() const noexcept { return m_stAccept.empty(); }
+    size_t GetStateCount() const noexcept { return m_stAccept.size(); }
+
+private:
+    std::array<uint8_t, 256> m_stByteClass {};  // 字节到等价类的映射
+    size_t m_uClassCount = 0;
+    std::vector<uint16_t> m_stTransitions;  // 状态 × 等价类，状态 0 为死状态，1 为初始状态
+    std::vector<uint8_t> m_stAccept;  // 各状态匹配到的规则种类（kMatchInclude / kMatchExclude）
+    bool m_bHasInclude = false;
+};
@@ -0,0 +1,102 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <array>
+#include <cstddef>
+#include <imgui.h>
+
+/**
+ * 分阶段耗时统计
+ *
+ * 每个阶段使用固定长度的环形缓冲区保存最近的耗时，用于计算 p50/p99/max 并在 HUD 中显示。
+ * 仅在 UI 线程使用，采样线程各阶段的耗时随 MetricsResult 传回后再记录。
+ */
+class FrameProfiler
+{
+public:
+    enum class Phase
+    {
+        PollEvents,
+        NewFrame,
+        OnFrame,
+        ImGuiRender,
+        RenderDrawData,
+        Present,
+        Frame,  // 整帧耗时，不含休眠
+        SampleFetch,
+        SampleParse,
+        SampleCompute,
+
+        // 采样到显示的延迟，按采样结果记录
+        LatencyFirstByte,  // 发起请求 -> 收到响应头
+        LatencyParse,  // 收到响应头 -> 解析完成（含接收响应体）
+        LatencyEnqueue,  // 解析完成 -> 推入结果队列
+        LatencyQueue,  // 推入结果队列 -> UI 线程取出
+        LatencyDisplay,  // UI 线程取出 -> 首次显示的帧提交完成
+        LatencyTotal,  // 发起请求 -> 首次显示
+        FirstValidFrame,  // 启动 -> 第一次显示有效数据的帧提交完成，每次启动只记录一次
+        Count,
+    };
+
+    /**
+     * HUD 页面
+     */
+    enum class OverlayPage
+    {
+        Frame,  // 帧各阶段与采样线程耗时
+        Latency,  // 采样到显示的延迟
+    };
+
+    static constexpr size_t kRingSize = 256;
+
+    struct Stats
+    {
+        double Last = 0;  // 秒
+        double P50 = 0;
+        double P99 = 0;
+        double Max = 0;
+        size_t Count = 0;  // 环中有效样本数
+    };
+
+public:
+    static const char* GetPhaseName(Phase phase) noexcept;
+
+public:
+    /**
+     * 记录一次耗时
+     * @param phase 阶段
+     * @param seconds 耗时（秒）
+     */
+    void Record(Phase phase, double seconds) noexcept;
+
+    /**
+     * 统计环中样本
+     * @param phase 阶段
+     */
+    Stats GetStats(Phase phase) const noexcept;
+
+    /**
+     * 清空所有样本
+     */
+    void Reset() noexcept;
+
+    /**
+     * 绘制 HUD
+     * @param font 字体，为空时使用当前字体
+     * @param page 显示的页面
+     */
+    void DrawOverlay(ImFont* font = nullptr, OverlayPage page = OverlayPage::Frame) const noexcept;
+
+private:
+    struct Ring
+    {
+        std::array<double, kRingSize> Samples {};
+        size_t Head = 0;
+        size_t Count = 0;
+    };
+
+    std::array<Ring, static_cast<size_t>(Phase::Count)> m_stRings;
+};
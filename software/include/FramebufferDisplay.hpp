@@ -0,0 +1,91 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <string>
+#include <vector>
+#include "IDisplay.hpp"
+#include "ImGuiSoftwareBackend.hpp"
+
+/**
+ * 基于 Linux framebuffer 的显示后端
+ *
+ * 使用 CPU 光栅化输出 RGB565，并通过 mmap 直接写入 /dev/fbN（例如 SPI 屏幕对应的 /dev/fb1）。
+ * 若设备路径是普通文件，则按配置的分辨率将其视为 16 位 framebuffer，便于在没有屏幕的环境下测试。
+ */
+class FramebufferDisplay :
+    public IDisplay
+{
+public:
+    FramebufferDisplay() noexcept = default;
+    ~FramebufferDisplay() noexcept override;
+
+public: // IDisplay
+    Result<void> Initialize(const AppBaseConfig& config) noexcept override;
+    void PollEvents(bool& exitRequest) noexcept override;
+    ImTextureID CreateTexture(int width, int height) noexcept override;
+    void UpdateTexture(ImTextureID texture, int x, int y, int width, int height, const uint32_t* pixels) noexcept override;
+    void DestroyTexture(ImTextureID texture) noexcept override;
+    void NewFrame() noexcept override;
+    void Render(ImDrawData* drawData) noexcept override;
+    void Present() noexcept override;
+
+public:
+    int GetWidth() const noexcept { return m_iWidth; }
+    int GetHeight() const noexcept { return m_iHeight; }
+
+    /**
+     * 上一次 Present 写入设备的字节数
+     */
+    size_t GetLastPresentBytes() const noexcept { return m_uLastPresentBytes; }
+
+    /**
+     * 上一次 Present 写入的矩形数量
+     */
+    size_t GetLastPresentRectCount() const noexcept { return m_stDirtyRects.size(); }
+
+private:
+    struct DirtyRect
+    {
+        int X = 0;
+        int Y = 0;
+        int Width = 0;
+        int Height = 0;
+    };
+
+    /**
+     * 打开 framebuffer 设备或文件
+     * @param path 设备路径
+     * @param width 当设备不支持 ioctl 查询时使用的宽度
+     * @param height 当设备不支持 ioctl 查询时使用的高度
+     */
+    Result<void> Open(const std::string& path, int width, int height) noexcept;
+
+    /**
+     * 按块比较后备缓冲区与上一次输出的画面，合并出需要写入设备的矩形
+     */
+    void CollectDirtyRects() noexcept;
+
+private:
+    int m_iFd = -1;
+    uint8_t* m_pMapped = nullptr;
+    size_t m_uMappedSize = 0;
+    int m_iWidth = 0;
+    int m_iHeight = 0;
+    size_t m_uLineLength = 0;  // 设备每行字节数
+
+    std::vector<uint16_t> m_stBackBuffer;
+    std::vector<uint16_t> m_stFrontBuffer;  // 上一次输出到设备的画面
+    bool m_bFrontBufferValid = false;
+    ImGuiSoftwareBackend::Target m_stBackBufferTarget;
+
+    std::vector<uint8_t> m_stDirtyTiles;
+    std::vector<DirtyRect> m_stDirtyRects;
+    std::vector<DirtyRect> m_stOpenRects;
+    size_t m_uLastPresentBytes = 0;
+
+    uint64_t m_uLastTick = 0;
+    bool m_bBackendInitialized = false;
+};
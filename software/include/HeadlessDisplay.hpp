@@ -0,0 +1,65 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <string>
+#include <vector>
+#include "AppBase.hpp"
+#include "IDisplay.hpp"
+#include "ImGuiSoftwareBackend.hpp"
+
+/**
+ * 无头显示后端
+ *
+ * 使用 CPU 光栅化将界面渲染到内存中的 RGB565 缓冲区，不依赖任何显示设备或 GPU。
+ * 渲染指定帧数后请求退出，可按需输出 PNG 截图与帧耗时统计（JSON），用于在 CI 中发现渲染开销回归。
+ */
+class HeadlessDisplay :
+    public IDisplay
+{
+public:
+    HeadlessDisplay() noexcept = default;
+    ~HeadlessDisplay() noexcept override;
+
+public: // IDisplay
+    Result<void> Initialize(const AppBaseConfig& config) noexcept override;
+    void PollEvents(bool& exitRequest) noexcept override;
+    ImTextureID CreateTexture(int width, int height) noexcept override;
+    void UpdateTexture(ImTextureID texture, int x, int y, int width, int height, const uint32_t* pixels) noexcept override;
+    void DestroyTexture(ImTextureID texture) noexcept override;
+    void NewFrame() noexcept override;
+    void Render(ImDrawData* drawData) noexcept override;
+    void Present() noexcept override;
+    void AttachProfiler(const FrameProfiler* profiler) noexcept override { m_pProfiler = profiler; }
+
+public:
+    int GetFrameCount() const noexcept { return m_iFrameIndex; }
+    const ImGuiSoftwareBackend::Target& GetTarget() const noexcept { return m_stTarget; }
+
+private:
+    void DumpFrame(const std::string& name) noexcept;
+    void WriteStats() noexcept;
+
+private:
+    HeadlessConfig m_stConfig;
+    const FrameProfiler* m_pProfiler = nullptr;
+    int m_iWidth = 0;
+    int m_iHeight = 0;
+    std::vector<uint16_t> m_stPixels;
+    ImGuiSoftwareBackend::Target m_stTarget;
+
+    int m_iFrameIndex = 0;
+    bool m_bFinished = false;
+    uint64_t m_uLastTick = 0;
+    uint64_t m_uFrameStartTick = 0;
+
+    // 统计，单位秒
+    std::vector<double> m_stFrameTimes;
+    std::vector<double> m_stRasterTimes;
+    double m_dTotalVertices = 0;
+    double m_dTotalIndices = 0;
+
+    bool m_bBackendInitialized = false;
+};
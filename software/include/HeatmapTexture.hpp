@@ -0,0 +1,70 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <imgui.h>
+
+class IDisplay;
+
+/**
+ * 滚动热力图
+ *
+ * 纹理的每一列是一次采样、每一行是一个实体（如 CPU 核心），颜色表示数值。纹理按列环形写入，
+ * 每次采样只上传新的一列（glTexSubImage2D），绘制时用同一纹理的两个矩形拼出从旧到新的顺序，
+ * ImGui 会将两者合并到同一个绘制命令中，开销与实体数量无关。
+ *
+ * 实体数多于纹理行数时，每行显示一组实体中的最大值，单个实体跑满仍然可见。
+ */
+class HeatmapTexture
+{
+public:
+    HeatmapTexture() noexcept = default;
+    ~HeatmapTexture() noexcept;
+
+    HeatmapTexture(const HeatmapTexture&) = delete;
+    HeatmapTexture& operator=(const HeatmapTexture&) = delete;
+
+public:
+    /**
+     * 按给定尺寸重新创建纹理，清空已有内容
+     * @param display 显示后端，不支持纹理时 IsValid() 为 false
+     * @param columns 列数（保留的采样数）
+     * @param rows 行数
+     */
+    void Reset(IDisplay* display, size_t columns, size_t rows) noexcept;
+
+    /**
+     * 释放纹理，须在显示后端销毁前调用
+     */
+    void Release() noexcept;
+
+    /**
+     * 追加一列
+     * @param values 各实体的值
+     * @param count 实体数量
+     * @param maxValue 对应颜色表最右端的值
+     */
+    void PushColumn(const double* values, size_t count, double maxValue) noexcept;
+
+    /**
+     * 在当前光标位置绘制
+     */
+    void Draw(const ImVec2& size) const noexcept;
+
+    bool IsValid() const noexcept { return m_uTexture != 0; }
+    size_t GetColumns() const noexcept { return m_uColumns; }
+    size_t GetRows() const noexcept { return m_uRows; }
+
+private:
+    IDisplay* m_pDisplay = nullptr;
+    ImTextureID m_uTexture = 0;
+    size_t m_uColumns = 0;
+    size_t m_uRows = 0;
+    size_t m_uHead = 0;  // 下一次写入的列
+    std::vector<uint32_t> m_stColumnPixels;
+};
@@ -0,0 +1,153 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CompressedSeries.hpp"
+#include "MetricsHistory.hpp"
+#include "Result.hpp"
+#include "RollupSeries.hpp"
+
+/**
+ * 历史数据文件格式
+ *
+ * 定长布局，整体通过 mmap 映射（小端序）：
+ *   - 文件头：Magic(u32)、Version(u32)、SeriesCount(u32)、Capacity(u32)
+ *   - 序列名：SeriesCount 个 32 字节、以 0 结尾的名称
+ *   - 槽位：Capacity 个 { Seq(u64)、TimestampMs(u64, UNIX 毫秒)、Values(f64 × SeriesCount) }
+ *   - 降采样桶：按序列、按 RollupSeries 的级别依次排列，每级 GetTierCapacity 个
+ *     { StartMs(u64)、Min、Max、Sum、Last(f64)、Count(u64) }
+ *
+ * 槽位按 (Seq - 1) % Capacity 环形写入。写入时先将 Seq 清零，写完数据后再写入新的 Seq，
+ * 因此进程在写入中途退出时，该槽位会因为 Seq 不匹配而被忽略。降采样桶按 StartMs / 桶宽 % 容量放置，
+ * 每次采样覆盖各级当前的桶，同样先将 StartMs 清零再写入。
+ *
+ * 上述顺序只在进程崩溃时成立：映射页由内核择机写回，断电或重启时不保证写回的顺序。为此每写入 60 个槽位
+ * 在后台调用一次 fdatasync，关闭时再调用一次，断电时最多丢失最近一分钟（按 1 秒采样）的数据，
+ * 刷新期间断电还可能留下部分写入的槽位。
+ */
+struct HistoryFileFormat
+{
+    static constexpr uint32_t kMagic = 0x484D5350;  // "PSMH"
+    static constexpr uint32_t kVersion = 2;
+    static constexpr size_t kMaxNameLength = 32;
+};
+
+/**
+ * 持久化的历史数据
+ *
+ * 启动时以只读方式映射并直接读取槽位，无需解析；之后每次采样写入一个槽位以及各级当前的降采样桶，
+ * 只定期在后台刷新到存储设备。
+ */
+class HistoryFile
+{
+public:
+    HistoryFile() noexcept = default;
+    ~HistoryFile() noexcept;
+
+    HistoryFile(const HistoryFile&) = delete;
+    HistoryFile& operator=(const HistoryFile&) = delete;
+
+public:
+    /**
+     * 打开文件，不存在时创建
+     *
+     * 布局与参数不一致的文件会在第一次写入时被重新初始化。
+     * @param path 路径
+     * @param seriesNames 各序列名称，决定 Append 与 Restore 中的顺序
+     * @param capacity 保留的采样数
+     */
+    Result<void> Open(const std::string& path, const std::vector<std::string>& seriesNames, size_t capacity) noexcept;
+
+    /**
+     * 关闭文件
+     */
+    void Close() noexcept;
+
+    /**
+     * 是否已打开
+     */
+    bool IsOpen() const noexcept { return m_pMapped != nullptr; }
+
+    /**
+     * 将文件中的数据按时间对齐后填入历史
+     *
+     * 只使用最近 capacity × intervalMs 内的数据点，时间晚于当前时间（时钟回拨）的点会被丢弃，缺失的采样以 0 填充。
+     * 同样的数据点按时间顺序追加到长期历史中。
+     * @param nowMs 当前 UNIX 时间
+     * @param intervalMs 采样间隔
+     * @param[out] histories 与 seriesNames 顺序一致的历史，为空的项会被跳过
+     * @param[out] series 与 seriesNames 顺序一致的长期历史，可以为空
+     * @return 恢复的数据点数量
+     */
+    size_t Restore(uint64_t nowMs, double intervalMs, const std::vector<MetricsHistory*>& histories,
+        const std::vector<CompressedSeries*>& series = {}) const noexcept;
+
+    /**
+     * 恢复降采样桶
+     *
+     * 只使用各级保留时长内的桶，起始时间晚于当前时间的桶会被丢弃。
+     * @param nowMs 当前 UNIX 时间
+     * @param[out] rollups 与 seriesNames 顺序一致，为空的项会被跳过
+     * @return 恢复的桶数量
+     */
+    size_t RestoreRollups(uint64_t nowMs, const std::vector<RollupSeries*>& rollups) const noexcept;
+
+    /**
+     * 追加一次采样
+     * @param timestampMs 采集时间
+     * @param values 与 seriesNames 顺序一致的值
+     */
+    void Append(uint64_t timestampMs, const double* values) noexcept;
+
+    /**
+     * 写入各级当前的降采样桶，在 RollupSeries::Append 之后调用
+     * @param rollups 与 seriesNames 顺序一致
+     */
+    void StoreRollups(const RollupSeries* const* rollups) noexcept;
+
+private:
+    struct SlotHeader
+    {
+        uint64_t Seq;
+        uint64_t TimestampMs;
+    };  // 之后紧跟 SeriesCount 个 double
+
+    struct RollupRecord
+    {
+        uint64_t StartMs;  // 0 表示空或正在写入
+        double Min;
+        double Max;
+        double Sum;
+        double Last;
+        uint64_t Count;
+    };
+
+    SlotHeader* GetSlot(size_t index) const noexcept;
+    RollupRecord* GetRollupRecords(size_t series, RollupSeries::Tier tier) const noexcept;
+    static double* GetSlotValues(SlotHeader* slot) noexcept { return reinterpret_cast<double*>(slot + 1); }
+    bool PrepareWrite() noexcept;
+    void RequestSync() noexcept;
+
+private:
+    int m_iFd = -1;
+    uint8_t* m_pMapped = nullptr;
+    size_t m_uMappedSize = 0;
+    std::vector<std::string> m_stSeriesNames;
+    size_t m_uCapacity = 0;
+    size_t m_uSlotsOffset = 0;
+    size_t m_uSlotStride = 0;
+    size_t m_uRollupsOffset = 0;
+    bool m_bLayoutValid = false;  // 文件头与参数一致
+    bool m_bWritable = false;
+    bool m_bWriteFailed = false;
+    uint64_t m_uLastSeq = 0;
+    std::thread m_stSyncThread;  // 后台 fdatasync
+    std::atomic<bool> m_bSyncing = false;
+};
@@ -0,0 +1,67 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstdint>
+#include <imgui.h>
+#include "Result.hpp"
+
+struct AppBaseConfig;
+class FrameProfiler;
+
+/**
+ * 显示后端接口
+ *
+ * 负责创建绘图表面、处理平台事件并将 ImGui 的绘制数据呈现到屏幕上。
+ */
+class IDisplay
+{
+public:
+    virtual ~IDisplay() noexcept = default;
+
+public:
+    /**
+     * 初始化显示后端
+     * 调用时 ImGui 上下文已经创建。
+     */
+    virtual Result<void> Initialize(const AppBaseConfig& config) noexcept = 0;
+
+    /**
+     * 处理平台事件
+     * @param exitRequest 当收到退出请求时置为 true
+     */
+    virtual void PollEvents(bool& exitRequest) noexcept = 0;
+
+    /**
+     * 当前是否不需要绘制（例如窗口最小化）
+     */
+    virtual bool IsSuspended() const noexcept { return false; }
+
+    /**
+     * 关联分阶段耗时统计，后端可以将其用于输出报告
+     */
+    virtual void AttachProfiler(const FrameProfiler* profiler) noexcept {}
+
+    /**
+     * 创建 RGBA32 纹理，初始内容全透明，可用于 ImDrawList::AddImage
+     * @return 失败或不支持时返回 0
+     */
+    virtual ImTextureID CreateTexture(int width, int height) noexcept { return 0; }
+
+    /**
+     * 更新纹理中的一个矩形区域
+     * @param pixels RGBA32（IM_COL32），按行紧密排列
+     */
+    virtual void UpdateTexture(ImTextureID texture, int x, int y, int width, int height, const uint32_t* pixels) noexcept {}
+
+    /**
+     * 销毁 CreateTexture 创建的纹理
+     */
+    virtual void DestroyTexture(ImTextureID texture) noexcept {}
+
+    virtual void NewFrame() noexcept = 0;
+    virtual void Render(ImDrawData* drawData) noexcept = 0;
+    virtual void Present() noexcept = 0;
+};
@@ -0,0 +1,38 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstdint>
+#include <imgui.h>
+#include <Result.hpp>
+
+/**
+ * OpenGL ES 2.0 渲染后端
+ *
+ * 供 KMS/DRM 直出使用，与 ImGuiOpenGLBackend 接口保持一致。
+ */
+class ImGuiGLES2Backend
+{
+public:
+    static void Initialize();
+    static void Shutdown() noexcept;
+
+    /**
+     * 纹理管理，见 IDisplay::CreateTexture
+     */
+    static ImTextureID CreateTexture(int width, int height) noexcept;
+    static void UpdateTexture(ImTextureID texture, int x, int y, int width, int height, const uint32_t* pixels) noexcept;
+    static void DestroyTexture(ImTextureID texture) noexcept;
+
+    static void NewFrame() noexcept;
+    static void RenderDrawData(ImDrawData* drawData) noexcept;
+    static void Clear(int width, int height) noexcept;
+
+private:
+    static void CreateFontsTexture() noexcept;
+    static void DestroyFontsTexture() noexcept;
+    static bool CreateDeviceObjects() noexcept;
+    static void DestroyDeviceObjects() noexcept;
+};
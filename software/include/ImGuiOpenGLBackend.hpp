@@ -4,6 +4,7 @@
  * @date 2024/11/17
  */
 #pragma once
+#include <cstdint>
 #include <imgui.h>
 #include <Result.hpp>
 
@@ -13,6 +14,13 @@ public:
     static void Initialize();
     static void Shutdown() noexcept;
 
+    /**
+     * 纹理管理，见 IDisplay::CreateTexture
+     */
+    static ImTextureID CreateTexture(int width, int height) noexcept;
+    static void UpdateTexture(ImTextureID texture, int x, int y, int width, int height, const uint32_t* pixels) noexcept;
+    static void DestroyTexture(ImTextureID texture) noexcept;
+
     static void NewFrame() noexcept;
     static void RenderDrawData(ImDrawData* drawData) noexcept;
     static void Clear(int width, int height) noexcept;
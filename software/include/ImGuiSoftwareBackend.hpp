@@ -0,0 +1,60 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <imgui.h>
+
+/**
+ * CPU 光栅化渲染后端
+ *
+ * 将 ImDrawData 直接光栅化到 RGB565 缓冲区，支持纹理/顶点色三角形与裁剪矩形。
+ * 在支持 NEON 的平台上使用 NEON 完成混合与颜色转换。
+ */
+class ImGuiSoftwareBackend
+{
+public:
+    /**
+     * 渲染目标（RGB565）
+     */
+    struct Target
+    {
+        uint16_t* Pixels = nullptr;
+        int Width = 0;
+        int Height = 0;
+        int Stride = 0;  // 每行像素数
+    };
+
+    /**
+     * CPU 纹理
+     */
+    struct Texture
+    {
+        int Width = 0;
+        int Height = 0;
+        int BytesPerPixel = 1;  // 1: Alpha8, 4: RGBA32
+        std::vector<uint8_t> Pixels;
+    };
+
+public:
+    static void Initialize();
+    static void Shutdown() noexcept;
+
+    /**
+     * 纹理管理，见 IDisplay::CreateTexture
+     */
+    static ImTextureID CreateTexture(int width, int height) noexcept;
+    static void UpdateTexture(ImTextureID texture, int x, int y, int width, int height, const uint32_t* pixels) noexcept;
+    static void DestroyTexture(ImTextureID texture) noexcept;
+
+    static void NewFrame() noexcept;
+    static void RenderDrawData(ImDrawData* drawData, const Target& target) noexcept;
+    static void Clear(const Target& target) noexcept;
+
+private:
+    static void CreateFontsTexture() noexcept;
+    static void DestroyFontsTexture() noexcept;
+};
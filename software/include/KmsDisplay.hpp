@@ -0,0 +1,80 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <string>
+#include <EGL/egl.h>
+#include <xf86drmMode.h>
+#include "IDisplay.hpp"
+
+struct gbm_device;
+struct gbm_surface;
+struct gbm_bo;
+
+/**
+ * 基于 DRM/KMS + GBM + EGL 的显示后端
+ *
+ * 不依赖 X11/Wayland，直接通过 KMS 翻页输出到屏幕。
+ * 当找不到可用的 DRM 设备时，退化为离屏 EGL 渲染（EGL_PLATFORM_DEVICE/SURFACELESS），用于无显示环境下运行。
+ */
+class KmsDisplay :
+    public IDisplay
+{
+public:
+    KmsDisplay() noexcept = default;
+    ~KmsDisplay() noexcept override;
+
+public: // IDisplay
+    Result<void> Initialize(const AppBaseConfig& config) noexcept override;
+    void PollEvents(bool& exitRequest) noexcept override;
+    ImTextureID CreateTexture(int width, int height) noexcept override;
+    void UpdateTexture(ImTextureID texture, int x, int y, int width, int height, const uint32_t* pixels) noexcept override;
+    void DestroyTexture(ImTextureID texture) noexcept override;
+    void NewFrame() noexcept override;
+    void Render(ImDrawData* drawData) noexcept override;
+    void Present() noexcept override;
+
+public:
+    /**
+     * 是否处于离屏模式
+     */
+    bool IsOffscreen() const noexcept { return m_iDrmFd < 0; }
+
+private:
+    bool OpenDrmDevice(const std::string& path, int width, int height) noexcept;
+    bool InitializeKmsEgl() noexcept;
+    bool InitializeOffscreenEgl(int width, int height) noexcept;
+    bool CreateContext(EGLint surfaceType) noexcept;
+    uint32_t GetFramebufferForBo(gbm_bo* bo) noexcept;
+    void WaitPageFlip() noexcept;
+
+private:
+    // DRM/KMS
+    int m_iDrmFd = -1;
+    uint32_t m_uConnectorId = 0;
+    uint32_t m_uCrtcId = 0;
+    drmModeModeInfo m_stMode {};
+    drmModeCrtc* m_pSavedCrtc = nullptr;
+    gbm_device* m_pGbmDevice = nullptr;
+    gbm_surface* m_pGbmSurface = nullptr;
+    gbm_bo* m_pFrontBo = nullptr;
+    bool m_bCrtcSet = false;
+    bool m_bFlipPending = false;
+
+    // EGL
+    EGLDisplay m_pEglDisplay = EGL_NO_DISPLAY;
+    EGLConfig m_pEglConfig = nullptr;
+    EGLContext m_pEglContext = EGL_NO_CONTEXT;
+    EGLSurface m_pEglSurface = EGL_NO_SURFACE;
+
+    // 离屏模式下的渲染目标
+    unsigned m_uOffscreenFbo = 0;
+    unsigned m_uOffscreenColor = 0;
+
+    int m_iWidth = 0;
+    int m_iHeight = 0;
+    uint64_t m_uLastTick = 0;
+    bool m_bBackendInitialized = false;
+};
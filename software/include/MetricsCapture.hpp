@@ -0,0 +1,100 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include "Result.hpp"
+
+/**
+ * 采集文件格式
+ *
+ * 只追加写入，由文件头与若干记录组成（小端序）：
+ *   - 文件头：Magic、Version
+ *   - 记录：TimestampMs(u64, UNIX 毫秒)、原始长度(u32)、压缩后长度(u32)、zlib 压缩的响应体
+ *
+ * 进程异常退出导致的不完整尾记录在读取时会被忽略。
+ */
+struct MetricsCaptureFormat
+{
+    static constexpr uint32_t kMagic = 0x434D5350;  // "PSMC"
+    static constexpr uint32_t kVersion = 1;
+};
+
+/**
+ * 采集记录
+ */
+struct MetricsCaptureRecord
+{
+    uint64_t TimestampMs = 0;
+    std::string Body;
+};
+
+/**
+ * 采集文件写入器
+ */
+class MetricsCaptureWriter
+{
+public:
+    MetricsCaptureWriter() noexcept = default;
+    ~MetricsCaptureWriter() noexcept;
+
+    MetricsCaptureWriter(const MetricsCaptureWriter&) = delete;
+    MetricsCaptureWriter& operator=(const MetricsCaptureWriter&) = delete;
+
+public:
+    /**
+     * 打开文件，已存在时校验文件头后在末尾追加，文件头不一致时返回错误
+     * @param path 路径
+     */
+    Result<void> Open(const std::string& path) noexcept;
+
+    /**
+     * 追加一条记录并立即刷新到文件
+     * @param timestampMs 采集时间
+     * @param body 响应体
+     */
+    Result<void> Append(uint64_t timestampMs, const std::string& body) noexcept;
+
+private:
+    FILE* m_pFile = nullptr;
+};
+
+/**
+ * 采集文件读取器
+ */
+class MetricsCaptureReader
+{
+public:
+    MetricsCaptureReader() noexcept = default;
+    ~MetricsCaptureReader() noexcept;
+
+    MetricsCaptureReader(const MetricsCaptureReader&) = delete;
+    MetricsCaptureReader& operator=(const MetricsCaptureReader&) = delete;
+
+public:
+    /**
+     * 打开文件
+     * @param path 路径
+     */
+    Result<void> Open(const std::string& path) noexcept;
+
+    /**
+     * 读取下一条记录
+     * @param[out] record 记录
+     * @return 到达文件末尾或遇到损坏的记录时返回 false
+     */
+    bool Next(MetricsCaptureRecord& record) noexcept;
+
+    /**
+     * 回到第一条记录
+     */
+    void Rewind() noexcept;
+
+private:
+    FILE* m_pFile = nullptr;
+    std::string m_stCompressed;
+};
@@ -0,0 +1,44 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/**
+ * 定长历史数据
+ *
+ * 保存最近 Capacity 个采样值，初始时以 0 填满。与 StackedHistory 一样使用 2 × Capacity 的缓冲区，每个值同时写入
+ * Head 与 Head + Capacity 两处，从 Head 开始的 Capacity 个值即为按时间从旧到新的连续数组，可直接交给 ImPlot 绘制，
+ * 追加时无需移动数据。
+ */
+class MetricsHistory
+{
+public:
+    explicit MetricsHistory(size_t capacity = 0);
+
+public:
+    /**
+     * 追加一个采样值，超出容量时丢弃最旧的值
+     */
+    void Push(double value) noexcept;
+
+    /**
+     * 整体替换为给定的采样值，按时间从旧到新排列
+     *
+     * 多于容量时只保留最新的部分，少于容量时在前面以 0 填充。
+     */
+    void Assign(const double* values, size_t count);
+
+    const double* GetData() const noexcept { return m_stValues.data() + m_uHead; }
+    size_t GetSize() const noexcept { return m_uCapacity; }
+    size_t GetCapacity() const noexcept { return m_uCapacity; }
+    double GetLatest() const noexcept { return m_uCapacity == 0 ? 0. : m_stValues[m_uHead + m_uCapacity - 1]; }
+
+private:
+    size_t m_uCapacity = 0;
+    size_t m_uHead = 0;  // 最旧的值，也是下一次写入的位置
+    std::vector<double> m_stValues;  // 2 × Capacity
+};
@@ -0,0 +1,56 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "DeviceFilter.hpp"
+#include "MetricsParser.hpp"
+#include "MetricsSampleThread.hpp"
+
+/**
+ * 将 MetricsParser 的解析事件填入 RawMetrics
+ *
+ * 指标名以 string_view 形式引用响应体，因此响应体需要在解析期间保持有效。
+ * 被过滤器排除的磁盘与网络接口不会写入 RawMetrics，也不会解析其数值。
+ */
+class MetricsParseListener :
+    public MetricsParser::IListener
+{
+public:
+    /**
+     * 解析数值，非法输入返回 0
+     */
+    static double ToDouble(std::string_view input) noexcept;
+    static int64_t ToInteger(std::string_view input) noexcept;
+
+public:
+    /**
+     * @param raw 输出
+     * @param diskFilter 磁盘过滤器，为空时保留所有磁盘
+     * @param networkFilter 网络接口过滤器，为空时保留所有接口
+     */
+    MetricsParseListener(MetricsSampleThread::RawMetrics& raw, const DeviceFilter* diskFilter = nullptr,
+        const DeviceFilter* networkFilter = nullptr)
+        : m_stRawMetrics(raw), m_pDiskFilter(diskFilter), m_pNetworkFilter(networkFilter) {}
+
+public: // IListener
+    void OnMetricsBegin(std::string_view name) override;
+    void OnMetricsLabel(std::string_view name, std::string_view value) override;
+    void OnMetricsValue(std::string_view value) override;
+    void OnMetricsEnd() override;
+
+private:
+    MetricsSampleThread::RawMetrics& m_stRawMetrics;
+    const DeviceFilter* m_pDiskFilter = nullptr;
+    const DeviceFilter* m_pNetworkFilter = nullptr;
+
+    std::string_view m_stCurrentMetricsName;
+    int m_iCurrentCpuIndex = -1;
+    std::string m_stCurrentCpuMode;
+    std::string m_stCurrentDeviceName;
+    bool m_bCurrentDeviceExcluded = false;
+};
@@ -5,10 +5,14 @@
  */
 #pragma once
 #include <map>
+#include <memory>
 #include <optional>
+#include <string>
 #include <variant>
 #include <vector>
 #include <concurrentqueue/concurrentqueue.h>
+#include "DeviceFilter.hpp"
+#include "MetricsCapture.hpp"
 
 class MetricsSampleThread
 {
@@ -21,13 +25,112 @@ public:
     {
         std::string Url;
         double RefreshIntervalMs = 1000;
+        double PrimeIntervalMs = 200;  // 切换后立即抓取，并在该间隔后再抓取一次以尽快得到速率，0 表示等待完整刷新间隔
     };
 
-    using Command = std::variant<QuitCommand, ChangeUrlCommand>;
+    /**
+     * 将每次成功抓取的响应体追加到采集文件，Path 为空时停止记录
+     */
+    struct RecordCommand
+    {
+        std::string Path;
+    };
+
+    /**
+     * 从采集文件回放，代替网络抓取
+     */
+    struct ReplayCommand
+    {
+        std::string Path;
+        bool RealTime = true;  // 按记录时间间隔回放，否则尽快回放
+        bool Loop = false;  // 结束后从头开始
+    };
+
+    /**
+     * 更换磁盘与网络接口过滤器，被排除的设备在解析时即被丢弃
+     */
+    struct ChangeDeviceFilterCommand
+    {
+        DeviceFilter Disk;
+        DeviceFilter Network;
+    };
+
+    using Command = std::variant<QuitCommand, ChangeUrlCommand, RecordCommand, ReplayCommand, ChangeDeviceFilterCommand>;
+
+    /**
+     * 从发起请求到显示在屏幕上的各时间点（SDL_GetPerformanceCounter），0 表示尚未发生
+     */
+    struct LatencyTimestamps
+    {
+        uint64_t RequestStart = 0;
+        uint64_t FirstByte = 0;  // 收到响应头，回放时为读出记录
+        uint64_t ParseEnd = 0;
+        uint64_t Enqueue = 0;
+        uint64_t Dequeue = 0;  // 以下由 UI 线程填写
+        uint64_t Present = 0;  // 首次显示该结果的帧提交完成
+    };
+
+    /**
+     * 各模式占全部核心时间的百分比，之和等于各核心 CpuUsage 的平均值（不含 Idle）
+     */
+    struct CpuModeUsage
+    {
+        double User = 0;
+        double Nice = 0;
+        double System = 0;
+        double IoWait = 0;
+        double Irq = 0;
+        double SoftIrq = 0;
+        double Steal = 0;
+    };
+
+    /**
+     * 单个磁盘的负载，与 iostat -x 的对应列含义相同
+     */
+    struct DiskStats
+    {
+        double Utilization = 0;  // %util，设备忙碌时间占比（0~100）
+        double ReadIops = 0;  // r/s
+        double WriteIops = 0;  // w/s
+        double ReadAwaitMs = 0;  // r_await，本周期内平均每次读的耗时（含排队），无读请求时为 0
+        double WriteAwaitMs = 0;  // w_await
+        double QueueDepth = 0;  // aqu-sz，平均队列深度
+    };
+
+    /**
+     * 压力阻塞信息（PSI），本周期内至少一个任务（Some）或全部非空闲任务（Full）因等待该资源而阻塞的时间占比（0~100）
+     */
+    struct PressureUsage
+    {
+        double CpuSome = 0;
+        double CpuFull = 0;  // 仅 cgroup 或 5.13 之后的内核提供
+        double MemorySome = 0;
+        double MemoryFull = 0;
+        double IoSome = 0;
+        double IoFull = 0;
+    };
+
+    /**
+     * 内存构成与换页情况
+     */
+    struct MemoryBreakdown
+    {
+        uint64_t AnonBytes = 0;  // 匿名页（进程堆、栈等）
+        uint64_t BuffersBytes = 0;
+        uint64_t CachedBytes = 0;  // 页缓存
+        uint64_t SwapTotalBytes = 0;
+        uint64_t SwapUsedBytes = 0;
+        uint64_t ZramOriginalBytes = 0;  // 所有 zram 设备中数据的原始大小
+        uint64_t ZramCompressedBytes = 0;  // 压缩后实际占用的内存
+        double MajorFaultsPerSecond = 0;
+        double SwapInPagesPerSecond = 0;
+        double SwapOutPagesPerSecond = 0;
+    };
 
     struct MetricsResult
     {
         uint64_t Tick = 0;
+        uint64_t TimestampMs = 0;  // 采集时的 UNIX 时间
         double BootTimeSeconds = 0;
         double Load1 = 0;
         double Load5 = 0;
@@ -35,11 +138,24 @@ public:
         uint64_t MemoryAvailableBytes = 0;
         uint64_t MemoryTotalBytes = 0;
         uint64_t MemoryFreeBytes = 0;
+        MemoryBreakdown Memory;
+        bool HasVmstat = false;  // 换页速率是否有效
         std::vector<double> CpuUsage;
+        CpuModeUsage CpuModes;
+        PressureUsage Pressure;
+        bool HasPressure = false;  // 内核或 node_exporter 不支持 PSI 时为 false
         std::map<std::string, double> DiskReadBytesPerSecond;
         std::map<std::string, double> DiskWrittenBytesPerSecond;
+        std::map<std::string, DiskStats> Disks;
         std::map<std::string, double> NetworkReceiveBytesPerSecond;
         std::map<std::string, double> NetworkTransmitBytesPerSecond;
+
+        // 本次采样各阶段耗时（秒）
+        double FetchSeconds = 0;
+        double ParseSeconds = 0;
+        double ComputeSeconds = 0;
+
+        LatencyTimestamps Timestamps;
     };
 
     using Result = std::variant<std::monostate, MetricsResult>;
@@ -61,9 +177,23 @@ public:
         }
     };
 
+    /**
+     * node_pressure_*_seconds_total，Waiting 对应 some，Stalled 对应 full
+     */
+    struct RawPressureMetrics
+    {
+        double CpuWaiting = 0;
+        double CpuStalled = 0;
+        double MemoryWaiting = 0;
+        double MemoryStalled = 0;
+        double IoWaiting = 0;
+        double IoStalled = 0;
+    };
+
     struct RawMetrics
     {
         uint64_t Tick = 0;
+        uint64_t TimestampMs = 0;  // 采集时的 UNIX 时间
         uint64_t BootTimestamp = 0;
         double Load1 = 0;
         double Load5 = 0;
@@ -71,12 +201,28 @@ public:
         uint64_t MemoryAvailableBytes = 0;
         uint64_t MemoryTotalBytes = 0;
         uint64_t MemoryFreeBytes = 0;
+        uint64_t MemoryAnonBytes = 0;
+        uint64_t MemoryBuffersBytes = 0;
+        uint64_t MemoryCachedBytes = 0;
+        uint64_t SwapTotalBytes = 0;
+        uint64_t SwapFreeBytes = 0;
+        uint64_t ZramOriginalBytes = 0;  // 各设备之和
+        uint64_t ZramCompressedBytes = 0;
+        double VmstatMajorFaults = 0;
+        double VmstatSwapIn = 0;
+        double VmstatSwapOut = 0;
+        bool HasVmstat = false;
         std::map<int, RawCpuMetrics> CpuSecondsTotal;
+        RawPressureMetrics PressureSecondsTotal;
+        bool HasPressure = false;
         std::map<std::string, double> DiskIoTimeSecondsTotal;
         std::map<std::string, double> DiskReadTimeSecondsTotal;
         std::map<std::string, double> DiskWriteTimeSecondsTotal;
         std::map<std::string, double> DiskReadBytesTotal;
         std::map<std::string, double> DiskWrittenBytesTotal;
+        std::map<std::string, double> DiskReadsCompletedTotal;
+        std::map<std::string, double> DiskWritesCompletedTotal;
+        std::map<std::string, double> DiskIoTimeWeightedSecondsTotal;
         std::map<std::string, double> NetworkReceiveBytesTotal;
         std::map<std::string, double> NetworkTransmitBytesTotal;
     };
@@ -86,9 +232,52 @@ public:
     void EnqueueCommand(Command&& cmd);
     bool TryDequeueResult(Result& result);
 
+    /**
+     * 解析响应体
+     * @param body 响应体
+     * @param[out] raw 原始指标
+     * @param diskFilter 磁盘过滤器，为空时保留所有磁盘
+     * @param networkFilter 网络接口过滤器，为空时保留所有接口
+     */
+    static void ParseMetrics(const std::string& body, RawMetrics& raw, const DeviceFilter* diskFilter = nullptr,
+        const DeviceFilter* networkFilter = nullptr);
+
+    /**
+     * 与上次采样比较，计算速率等结果
+     * @param raw 本次原始指标
+     * @param last 上次原始指标
+     * @param[out] metrics 结果
+     */
+    static void ComputeMetrics(const RawMetrics& raw, const RawMetrics& last, MetricsResult& metrics);
+
 private:
     void RefreshMetrics();
 
+    /**
+     * 回放采集文件中到期的记录
+     * @return 是否还有待回放的记录
+     */
+    bool ReplayMetrics();
+
+    /**
+     * 解析响应体并与上次结果比较，产生 MetricsResult
+     * @param body 响应体，抓取失败时为空
+     * @param tick 单调时间（毫秒），用于计算速率
+     * @param timestampMs UNIX 时间（毫秒）
+     * @param fetchSeconds 抓取耗时
+     * @param timestamps 已记录请求开始与首字节时间
+     */
+    void ProcessMetrics(const std::string* body, uint64_t tick, uint64_t timestampMs, double fetchSeconds,
+        LatencyTimestamps timestamps);
+
+    /**
+     * 请求 node_exporter
+     * @param[out] firstByteTick 收到响应头的时间
+     * @return 响应体，失败时为空
+     */
+    std::optional<std::string> FetchMetrics(uint64_t& firstByteTick);
+
+
 private:
     moodycamel::ConcurrentQueue<Command> m_stCommandQueue;
     moodycamel::ConcurrentQueue<Result> m_stResultQueue;
@@ -98,4 +287,16 @@ private:
 
     std::string m_stUrl;
     double m_dRefreshIntervalMs = 1000.;
+    double m_dPrimeIntervalMs = 0.;
+    DeviceFilter m_stDiskFilter;
+    DeviceFilter m_stNetworkFilter;
+
+    // 记录与回放
+    std::unique_ptr<MetricsCaptureWriter> m_pRecorder;
+    std::unique_ptr<MetricsCaptureReader> m_pReplayer;
+    bool m_bReplayRealTime = true;
+    bool m_bReplayLoop = false;
+    uint64_t m_uReplayStartTick = 0;
+    uint64_t m_uReplayFirstTimestampMs = 0;
+    std::optional<MetricsCaptureRecord> m_stPendingRecord;
 };
@@ -0,0 +1,29 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstdint>
+#include <string>
+#include "Result.hpp"
+
+/**
+ * 最小 PNG 编码器
+ *
+ * 仅输出 8 位 RGB 图像，使用 zlib 压缩，用于保存离屏渲染结果以做图像比对。
+ */
+class PngWriter
+{
+public:
+    /**
+     * 将 RGB565 图像保存为 PNG
+     * @param path 输出路径
+     * @param pixels 像素
+     * @param width 宽度
+     * @param height 高度
+     * @param stride 每行像素数
+     */
+    static Result<void> WriteRGB565(const std::string& path, const uint16_t* pixels, int width, int height,
+        int stride) noexcept;
+};
@@ -0,0 +1,86 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstdint>
+#include <imgui.h>
+#include "Result.hpp"
+
+/**
+ * 构建期预烘焙的字体图集
+ *
+ * 构建时由 FontAtlasBaker 按 kFonts 列出的字体与字号生成 Alpha8 图集和字形表，运行时直接装入 ImFontAtlas，
+ * 省去每次启动时解压与光栅化 TTF 的开销。
+ *
+ * 数据格式（小端序）：
+ *   - 头部：Magic、Version、TexWidth、TexHeight、TexUvWhitePixel(2f)、TexUvLines 数量、TexUvLines(4f * N)、字体数量
+ *   - 每个字体：FontSize(f)、Ascent(f)、Descent(f)、字形数量，随后每个字形为 Codepoint 与
+ *     AdvanceX、X0、Y0、X1、Y1、U0、V0、U1、V1(9f)
+ *   - 尾部：TexWidth * TexHeight 字节的 Alpha8 像素
+ */
+class PrebakedFontAtlas
+{
+public:
+    enum class FontId
+    {
+        Default = 0,
+        Numeric,
+        DefaultTiny,
+        NumericTiny,
+        Count,
+    };
+
+    struct FontDesc
+    {
+        const char* AssetName;  // assets 目录下的文件名
+        float SizePixels;
+    };
+
+    static constexpr float kDefaultFontSize = 40.f;
+    static constexpr float kNumericFontSize = 42.f;
+
+    /**
+     * 需要烘焙的字体，顺序与 FontId 一致
+     */
+    static constexpr FontDesc kFonts[] = {
+        { "whitrabt.ttf", kDefaultFontSize },
+        { "Segment7-4Gml.otf", kNumericFontSize },
+        { "whitrabt.ttf", kDefaultFontSize / 2.5f },
+        { "Segment7-4Gml.otf", kNumericFontSize / 2.5f },
+    };
+
+    /**
+     * 界面只使用可打印 ASCII 字符
+     */
+    static constexpr ImWchar kGlyphRanges[] = { 0x0020, 0x007E, 0 };
+
+    static constexpr uint32_t kMagic = 0x46424150;  // "PABF"
+    static constexpr uint32_t kVersion = 1;
+
+    static_assert(sizeof(kFonts) / sizeof(kFonts[0]) == static_cast<size_t>(FontId::Count));
+
+public:
+    /**
+     * 将预烘焙数据装入图集
+     *
+     * 装入后图集视为已构建（TexReady），不可再调用 Build()。
+     *
+     * @param atlas 目标图集，必须为空
+     * @param data 数据
+     * @param size 数据长度
+     */
+    static Result<void> Load(ImFontAtlas* atlas, const void* data, size_t size) noexcept;
+
+    /**
+     * 获取装入的字体
+     * @param atlas 图集
+     * @param id 字体
+     */
+    static ImFont* GetFont(ImFontAtlas* atlas, FontId id) noexcept
+    {
+        auto index = static_cast<int>(id);
+        return index < atlas->Fonts.Size ? atlas->Fonts[index] : nullptr;
+    }
+};
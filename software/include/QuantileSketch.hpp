@@ -0,0 +1,82 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 流式分位数估计（DDSketch）
+ *
+ * 将正数按 log_γ(v) 向上取整映射到桶，γ = (1 + α) / (1 - α)，任意分位数的相对误差不超过 α。
+ * 每次 Add 只做一次对数运算与一次计数，合并只需按桶相加，因此每个核心、每个设备的结果可以直接合并为整体的分布。
+ *
+ * 桶以连续数组存储，桶数超过 kMaxBins 时合并最小的一端，此时只有低分位数的精度会下降。
+ * 小于 kMinPositiveValue 的值（包括 0 与负数）计入单独的零桶。
+ */
+class QuantileSketch
+{
+public:
+    static constexpr double kDefaultRelativeAccuracy = 0.01;
+    static constexpr double kMinPositiveValue = 1e-9;
+    static constexpr size_t kMaxBins = 2048;
+
+public:
+    explicit QuantileSketch(double relativeAccuracy = kDefaultRelativeAccuracy) noexcept;
+
+public:
+    /**
+     * 加入一个值
+     */
+    void Add(double value);
+
+    /**
+     * 合并另一个估计，两者的精度必须相同
+     */
+    void Merge(const QuantileSketch& other);
+
+    /**
+     * 清空，保留已分配的内存
+     */
+    void Clear() noexcept;
+
+    /**
+     * 估计分位数
+     * @param q 0~1
+     * @return 没有数据时返回 0
+     */
+    double GetQuantile(double q) const noexcept;
+
+    uint64_t GetCount() const noexcept { return m_uCount; }
+    double GetRelativeAccuracy() const noexcept { return m_dRelativeAccuracy; }
+
+    /**
+     * 桶数组占用的内存
+     */
+    size_t GetMemoryBytes() const noexcept { return m_stBins.capacity() * sizeof(uint32_t); }
+
+private:
+    int32_t GetKey(double value) const noexcept;
+    double GetValue(int32_t key) const noexcept;
+
+    /**
+     * 扩展桶数组使其包含 [minKey, maxKey]，超出 kMaxBins 时合并最小的一端
+     * @return 实际可用的最小 key
+     */
+    int32_t Extend(int32_t minKey, int32_t maxKey);
+
+private:
+    double m_dRelativeAccuracy = 0;
+    double m_dGamma = 0;
+    double m_dInvLogGamma = 0;
+
+    std::vector<uint32_t> m_stBins;  // m_stBins[i] 对应 key = m_iMinKey + i
+    int32_t m_iMinKey = 0;
+    uint64_t m_uZeroCount = 0;
+    uint64_t m_uCount = 0;
+    double m_dMin = 0;  // 精确的最小、最大值，用于限制估计结果
+    double m_dMax = 0;
+};
@@ -0,0 +1,116 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 多级降采样历史
+ *
+ * 按 1 分钟、10 分钟两级时间桶聚合，每个桶保存最小、最大、平均与最后一个值。每次采样只更新各级当前的桶，
+ * 代价与历史长度无关。绘制长时间范围时按屏幕宽度选择点数合适的一级，不需要扫描原始采样。
+ * 1 小时以内的范围直接绘制 CompressedSeries 中的原始采样，因此不设更细的级别。
+ */
+class RollupSeries
+{
+public:
+    enum class Tier
+    {
+        Minute,
+        TenMinutes,
+        Count,
+    };
+
+    struct Bucket
+    {
+        uint64_t StartMs = 0;  // 桶起始的 UNIX 时间
+        double Min = 0;
+        double Max = 0;
+        double Sum = 0;
+        double Last = 0;
+        uint32_t Count = 0;
+
+        double GetAverage() const noexcept { return Count == 0 ? 0. : Sum / static_cast<double>(Count); }
+    };
+
+public:
+    /**
+     * 桶宽度
+     */
+    static uint64_t GetTierWidthMs(Tier tier) noexcept;
+
+    /**
+     * 保留的桶数量：1 分钟级 24 小时、10 分钟级 7 天
+     */
+    static size_t GetTierCapacity(Tier tier) noexcept;
+
+    /**
+     * 选择显示 spanMs 时间范围所用的级别
+     *
+     * 返回点数不超过 maxPoints 的最精细一级，所有级别都超出时返回最粗的一级。
+     * @param spanMs 时间范围
+     * @param maxPoints 最多点数，通常为绘图区域的像素宽度
+     */
+    static Tier SelectTier(uint64_t spanMs, size_t maxPoints) noexcept;
+
+public:
+    RollupSeries();
+
+public:
+    /**
+     * 追加一个采样，更新各级当前的桶
+     * @param timestampMs UNIX 时间（毫秒）
+     * @param value 值
+     */
+    void Append(uint64_t timestampMs, double value) noexcept;
+
+    /**
+     * 某一级中的桶数量
+     */
+    size_t GetBucketCount(Tier tier) const noexcept { return m_stTiers[static_cast<size_t>(tier)].Count; }
+
+    /**
+     * 替换某一级的全部桶，用于从文件恢复
+     * @param tier 级别
+     * @param buckets 按起始时间递增排列的桶，超出容量时只保留最新的部分
+     * @param count 数量
+     */
+    void Assign(Tier tier, const Bucket* buckets, size_t count) noexcept;
+
+    /**
+     * 获取桶
+     * @param tier 级别
+     * @param index 序号，0 为最旧
+     */
+    const Bucket& GetBucket(Tier tier, size_t index) const noexcept;
+
+    /**
+     * 复制某一级截至 endMs 的 count 个时间槽
+     *
+     * 第 i 个槽对应起始时间为 endMs 所在桶之前 count - 1 - i 个桶宽的桶，按桶的起始时间而不是顺序放置，
+     * 采样中断（如程序未运行）期间没有桶的槽填充 NaN。
+     * @param tier 级别
+     * @param endMs 最后一个槽所在的时间，通常为最新采样的时间
+     * @param count 槽数量
+     * @param[out] min 最小值
+     * @param[out] max 最大值
+     * @param[out] average 平均值
+     */
+    void CopyRecent(Tier tier, uint64_t endMs, size_t count, std::vector<double>& min, std::vector<double>& max,
+        std::vector<double>& average) const;
+
+private:
+    struct Ring
+    {
+        std::vector<Bucket> Buckets;
+        size_t Head = 0;  // 最旧的桶
+        size_t Count = 0;
+    };
+
+    std::array<Ring, static_cast<size_t>(Tier::Count)> m_stTiers;
+};
@@ -0,0 +1,37 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <SDL.h>
+#include "IDisplay.hpp"
+
+/**
+ * 基于 SDL 窗口 + OpenGL 2 的显示后端
+ *
+ * 需要桌面环境（X11/Wayland），适合在开发机上调试。
+ */
+class SDLDisplay :
+    public IDisplay
+{
+public:
+    SDLDisplay() noexcept = default;
+    ~SDLDisplay() noexcept override;
+
+public: // IDisplay
+    Result<void> Initialize(const AppBaseConfig& config) noexcept override;
+    void PollEvents(bool& exitRequest) noexcept override;
+    bool IsSuspended() const noexcept override;
+    ImTextureID CreateTexture(int width, int height) noexcept override;
+    void UpdateTexture(ImTextureID texture, int x, int y, int width, int height, const uint32_t* pixels) noexcept override;
+    void DestroyTexture(ImTextureID texture) noexcept override;
+    void NewFrame() noexcept override;
+    void Render(ImDrawData* drawData) noexcept override;
+    void Present() noexcept override;
+
+private:
+    ::SDL_Window* m_pMainWindow = nullptr;
+    ::SDL_GLContext m_pGLContext = nullptr;
+    bool m_bBackendInitialized = false;
+};
@@ -0,0 +1,81 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstddef>
+#include <string>
+#include "FrameProfiler.hpp"
+#include "Result.hpp"
+
+/**
+ * 程序自身的运行指标
+ *
+ * 各线程通过原子计数器记录，不分配内存也不加锁，可在渲染线程中调用。
+ * 可选启动一个 HTTP 服务，以 Prometheus 文本格式在 /metrics 上输出，格式化只发生在服务线程。
+ */
+class SelfMetrics
+{
+public:
+    /**
+     * 记录一次抓取
+     * @param seconds 耗时
+     * @param success 是否成功
+     */
+    static void ObserveScrape(double seconds, bool success) noexcept;
+
+    /**
+     * 记录一次解析
+     * @param bytes 响应体大小
+     * @param seconds 耗时
+     */
+    static void ObserveParse(size_t bytes, double seconds) noexcept;
+
+    /**
+     * 记录阶段耗时，由 FrameProfiler::Record 调用
+     */
+    static void ObservePhase(FrameProfiler::Phase phase, double seconds) noexcept;
+
+    /**
+     * 记录结果入队与出队，两者之差即队列深度
+     */
+    static void ObserveResultEnqueued() noexcept;
+    static void ObserveResultDequeued() noexcept;
+
+    /**
+     * 记录一帧
+     * @param rendered 是否渲染，显示被挂起时为 false
+     * @param late 是否超出目标帧间隔
+     */
+    static void ObserveFrame(bool rendered, bool late) noexcept;
+
+    /**
+     * 记录一次 framebuffer 提交
+     * @param bytes 本帧写入 framebuffer 的字节数（只含脏区域）
+     */
+    static void ObservePresent(size_t bytes) noexcept;
+
+    /**
+     * 设置长期历史的内存占用
+     * @param bytes 压缩数据字节数
+     * @param seriesCount 序列数
+     */
+    static void SetHistoryBytes(size_t bytes, size_t seriesCount) noexcept;
+
+    /**
+     * 启动 HTTP 服务
+     * @param listen 监听地址，形如 "0.0.0.0:9101" 或 "9101"
+     */
+    static Result<void> StartServer(const std::string& listen) noexcept;
+
+    /**
+     * 停止 HTTP 服务
+     */
+    static void StopServer() noexcept;
+
+    /**
+     * 以 Prometheus 文本格式输出全部指标
+     */
+    static std::string Format();
+};
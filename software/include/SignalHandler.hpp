@@ -0,0 +1,25 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+
+/**
+ * 进程信号处理
+ *
+ * 不经过 SDL 的显示后端（KMS、framebuffer 等）需要自行响应 SIGINT/SIGTERM。
+ */
+class SignalHandler
+{
+public:
+    /**
+     * 安装 SIGINT/SIGTERM 处理函数
+     */
+    static void Install() noexcept;
+
+    /**
+     * 检查并清除退出请求
+     */
+    static bool ConsumeExitRequest() noexcept;
+};
@@ -0,0 +1,87 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+/**
+ * 曲线降采样
+ *
+ * 将任意长度的历史按像素分桶，每个桶只保留最小值与最大值两个点（按出现顺序），输出不超过约 2 × 宽度个点，
+ * 短时的尖峰不会因平均而消失。
+ *
+ * 实例按采样序号将新值增量并入最新的桶，并丢弃完全滑出窗口的桶，每次采样与每帧的开销只与宽度有关。
+ * 由于桶按绝对序号对齐，窗口最左侧的桶可能仍包含刚滑出窗口的至多 BucketSize - 1 个值。
+ */
+class SparklineLod
+{
+public:
+    /**
+     * 对一段数据做一次性降采样
+     * @param values 数据
+     * @param count 数量
+     * @param width 目标宽度（桶数）
+     * @param xStart 第一个点的 X 坐标，之后每个点递增 1
+     * @param[out] xs X 坐标
+     * @param[out] ys 值
+     */
+    static void Decimate(const double* values, size_t count, size_t width, double xStart, std::vector<double>& xs,
+        std::vector<double>& ys);
+
+public:
+    /**
+     * 重新设置窗口与宽度，并以已有数据初始化
+     * @param values 已有数据，按时间从旧到新
+     * @param count 数量
+     * @param capacity 窗口长度（采样数）
+     * @param width 目标宽度（像素）
+     */
+    void Rebuild(const double* values, size_t count, size_t capacity, size_t width);
+
+    /**
+     * 追加一个采样，尚未 Rebuild 时忽略
+     */
+    void Push(double value);
+
+    size_t GetCapacity() const noexcept { return m_uCapacity; }
+    size_t GetWidth() const noexcept { return m_uWidth; }
+
+    /**
+     * 降采样结果，X 坐标为在窗口中的位置（0 ~ capacity）
+     */
+    const std::vector<double>& GetX();
+    const std::vector<double>& GetY();
+
+    /**
+     * 结果中的最大值
+     */
+    double GetMax();
+
+private:
+    struct Bucket
+    {
+        uint64_t MinIndex = 0;
+        uint64_t MaxIndex = 0;
+        double Min = 0;
+        double Max = 0;
+    };
+
+    void UpdateOutput();
+
+private:
+    size_t m_uCapacity = 0;
+    size_t m_uWidth = 0;
+    size_t m_uBucketSize = 1;
+    uint64_t m_uNextIndex = 0;  // 下一个采样的序号
+    std::deque<Bucket> m_stBuckets;
+
+    bool m_bOutputDirty = true;
+    std::vector<double> m_stX;
+    std::vector<double> m_stY;
+    double m_dMax = 0;
+};
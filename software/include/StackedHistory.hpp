@@ -0,0 +1,54 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/**
+ * 堆叠历史
+ *
+ * 保存若干层数据的累加边界：第 i 层的下边界为前 i 层之和，上边界为前 i + 1 层之和。累加在 Push 时完成，
+ * 每次采样 O(层数)，绘制时各层的上下边界都是现成的连续数组，可直接交给 ImPlot::PlotShaded，不需要每帧重新堆叠。
+ *
+ * 与 ColumnStore 相同，每条边界占用 2 × Capacity 的空间，[head, head + Capacity) 始终是从旧到新的连续窗口。
+ * 初始时以 0 填满。
+ */
+class StackedHistory
+{
+public:
+    StackedHistory(size_t layerCount = 0, size_t capacity = 0);
+
+public:
+    /**
+     * 追加一个采样
+     * @param values 各层的值，共 GetLayerCount() 个，负数按 0 处理
+     */
+    void Push(const double* values) noexcept;
+
+    size_t GetLayerCount() const noexcept { return m_uLayerCount; }
+    size_t GetCapacity() const noexcept { return m_uCapacity; }
+
+    /**
+     * 第 layer 层的下边界与上边界，共 GetCapacity() 个值，从旧到新
+     */
+    const double* GetLower(size_t layer) const noexcept { return GetBoundary(layer); }
+    const double* GetUpper(size_t layer) const noexcept { return GetBoundary(layer + 1); }
+
+    /**
+     * X 坐标 0 ~ Capacity - 1
+     */
+    const double* GetX() const noexcept { return m_stX.data(); }
+
+private:
+    const double* GetBoundary(size_t index) const noexcept;
+
+private:
+    size_t m_uLayerCount = 0;
+    size_t m_uCapacity = 0;
+    size_t m_uHead = 0;  // 下一次写入的位置
+    std::vector<double> m_stBoundaries;  // 第 i 条边界位于 [i × 2 × Capacity, (i + 1) × 2 × Capacity)，第 0 条恒为 0
+    std::vector<double> m_stX;
+};
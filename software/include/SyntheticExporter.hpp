@@ -0,0 +1,79 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * 合成 node_exporter 指标
+ *
+ * 按配置的 CPU、磁盘、网卡数量生成与 node_exporter 格式一致的页面，用于在没有大型主机的情况下
+ * 测试抓取、解析与差分计算随主机规模增长的开销。计数器每次生成时按随机速率单调递增。
+ */
+class SyntheticExporter
+{
+public:
+    struct Config
+    {
+        int CpuCount = 4;
+        int DiskCount = 2;  // 依次为 sda..sdz、dm-N
+        int NetworkCount = 2;  // 依次为 eth0、vethXXXXXXX
+        int ExtraMetricCount = 0;  // 额外的 node_synthetic_* 序列，模拟程序不关心的指标
+        uint32_t Seed = 1;
+        double DiskBytesPerSecond = 8. * 1024 * 1024;  // 磁盘读写速率的上限
+        double NetworkBytesPerSecond = 4. * 1024 * 1024;  // 网卡收发速率的上限
+    };
+
+public:
+    explicit SyntheticExporter(const Config& config);
+
+public:
+    const Config& GetConfig() const noexcept { return m_stConfig; }
+
+    /**
+     * 推进计数器并生成页面
+     * @param timestampMs UNIX 时间（毫秒），与上次调用的差值决定计数器的增量
+     * @return 页面内容
+     */
+    std::string Render(uint64_t timestampMs);
+
+private:
+    struct CpuCounters
+    {
+        double Seconds[8] = {};  // 顺序与 kCpuModes 一致
+    };
+
+    struct DeviceCounters
+    {
+        std::string Name;
+        double Counters[8] = {};  // 磁盘：io/read/write 时间、读/写字节、读/写次数、加权 io 时间；网卡：收/发字节
+    };
+
+    void Advance(double seconds);
+
+private:
+    Config m_stConfig;
+    std::mt19937 m_stRandom;
+    uint64_t m_uBootTimestampMs = 0;
+    uint64_t m_uLastTimestampMs = 0;
+    double m_dLoad1 = 0;
+    double m_dLoad5 = 0;
+    double m_dLoad15 = 0;
+    uint64_t m_uMemoryTotalBytes = 0;
+    uint64_t m_uMemoryAvailableBytes = 0;
+    uint64_t m_uSwapTotalBytes = 0;
+    uint64_t m_uSwapUsedBytes = 0;
+    double m_dMajorFaults = 0;
+    double m_dSwapIn = 0;
+    double m_dSwapOut = 0;
+    double m_stPressureSeconds[5] = {};  // 顺序与 kPressureMetrics 一致
+    std::vector<CpuCounters> m_stCpus;
+    std::vector<DeviceCounters> m_stDisks;
+    std::vector<DeviceCounters> m_stNetworks;
+    std::vector<double> m_stExtras;
+};
@@ -0,0 +1,93 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstdint>
+#include <string>
+#include "Result.hpp"
+
+/**
+ * 时间线追踪
+ *
+ * 每个线程将事件写入自己的定长环形缓冲区（无锁，仅首次使用时注册一次），在收到 SIGUSR1 或运行指定时长后
+ * 输出为 Chrome trace event 格式的 JSON，可在 Perfetto / chrome://tracing 中查看。
+ *
+ * 仅在定义 PSM_ENABLE_TRACE 时 PSM_TRACE_* 宏才会产生代码。
+ */
+class Trace
+{
+public:
+    /**
+     * 记录一个已结束的事件
+     * @param name 名称，必须是静态字符串
+     * @param startNs 开始时间
+     * @param endNs 结束时间
+     */
+    static void Record(const char* name, uint64_t startNs, uint64_t endNs) noexcept;
+
+    /**
+     * 设置当前线程在时间线上显示的名称
+     * @param name 名称，必须是静态字符串
+     */
+    static void SetThreadName(const char* name) noexcept;
+
+    /**
+     * 当前时间（纳秒，单调时钟）
+     */
+    static uint64_t Now() noexcept;
+
+    /**
+     * 设置输出文件并安装 SIGUSR1 处理函数
+     * @param path 输出路径
+     * @param durationSeconds 大于 0 时在运行该时长后自动输出一次
+     */
+    static void Install(const std::string& path, double durationSeconds) noexcept;
+
+    /**
+     * 检查是否需要输出，在 UI 线程每帧调用
+     *
+     * UI 线程只复制各线程的缓冲区，格式化与写文件在后台线程中进行。
+     */
+    static void Poll() noexcept;
+
+    /**
+     * 将所有线程缓冲区中的事件写入文件（同步）
+     * @param path 输出路径
+     */
+    static Result<void> Flush(const std::string& path) noexcept;
+};
+
+/**
+ * 作用域事件
+ */
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* name) noexcept
+        : m_pName(name), m_uStartNs(Trace::Now()) {}
+
+    ~TraceScope() noexcept
+    {
+        Trace::Record(m_pName, m_uStartNs, Trace::Now());
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_pName;
+    uint64_t m_uStartNs;
+};
+
+#define PSM_TRACE_CONCAT_IMPL(A, B) A##B
+#define PSM_TRACE_CONCAT(A, B) PSM_TRACE_CONCAT_IMPL(A, B)
+
+#if defined(PSM_ENABLE_TRACE) && PSM_ENABLE_TRACE
+#define PSM_TRACE_SCOPE(NAME) TraceScope PSM_TRACE_CONCAT(traceScope_, __LINE__)(NAME)
+#define PSM_TRACE_THREAD_NAME(NAME) Trace::SetThreadName(NAME)
+#else
+#define PSM_TRACE_SCOPE(NAME) do {} while (false)
+#define PSM_TRACE_THREAD_NAME(NAME) do {} while (false)
+#endif
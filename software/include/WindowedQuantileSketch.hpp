@@ -0,0 +1,64 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "QuantileSketch.hpp"
+
+/**
+ * 滑动时间窗口内的分位数估计
+ *
+ * 窗口按时间均分为若干片，每片一个 QuantileSketch。新采样只加入当前片，进入新的时间片时清空最旧的片，
+ * 因此每次采样的代价为 O(1)，窗口以片宽为粒度滑动。查询时将各片合并，结果缓存到下一次 Add。
+ */
+class WindowedQuantileSketch
+{
+public:
+    static constexpr size_t kDefaultSliceCount = 6;
+
+public:
+    /**
+     * 构造
+     * @param windowMs 窗口长度
+     * @param sliceCount 分片数量，越多窗口滑动越平滑，查询越慢
+     * @param relativeAccuracy 见 QuantileSketch
+     */
+    explicit WindowedQuantileSketch(uint64_t windowMs, size_t sliceCount = kDefaultSliceCount,
+        double relativeAccuracy = QuantileSketch::kDefaultRelativeAccuracy);
+
+public:
+    /**
+     * 加入一个采样，时钟回拨时计入当前片
+     * @param timestampMs UNIX 时间（毫秒）
+     * @param value 值
+     */
+    void Add(uint64_t timestampMs, double value);
+
+    /**
+     * 将窗口内的数据合并到 out 中，用于按核心、按设备汇总
+     */
+    void MergeInto(QuantileSketch& out) const;
+
+    /**
+     * 窗口内数据的估计
+     */
+    const QuantileSketch& GetMerged();
+
+    /**
+     * 各片占用的内存
+     */
+    size_t GetMemoryBytes() const noexcept;
+
+private:
+    uint64_t m_uSliceWidthMs = 0;
+    std::vector<QuantileSketch> m_stSlices;  // 环形，按片起始时间 / 片宽取模
+    std::vector<uint64_t> m_stSliceStartMs;
+    uint64_t m_uCurrentStartMs = 0;
+
+    bool m_bMergedDirty = true;
+    QuantileSketch m_stMerged;
+};
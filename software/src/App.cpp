@@ -5,36 +5,27 @@
  */
 #include <App.hpp>
 
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
 #include <implot.h>
+#include <spdlog/spdlog.h>
+#include <PrebakedFontAtlas.hpp>
+#include <SelfMetrics.hpp>
+#include <Trace.hpp>
 
-#include <whitrabt.ttf.inl>
-#include <Segment7-4Gml.otf.inl>
+#include <FontAtlas.bin.inl>
 
 using namespace std;
 
-static const float kFontSize1 = 40.f;
-static const float kFontSize2 = 42.f;
+static const float kFontSize1 = PrebakedFontAtlas::kDefaultFontSize;
 
 namespace
 {
-    double CalculateTotalCpuUsage(std::vector<double>& cpuUsage) noexcept
-    {
-        double total = 0;
-        for (auto& usage : cpuUsage)
-            total += usage;
-        if (cpuUsage.empty())
-            return 0;
-        return total / static_cast<double>(cpuUsage.size());
-    }
-
-    double SumAllMetricsValue(std::map<std::string, double>& metrics) noexcept
-    {
-        double total = 0;
-        for (const auto& [_, value] : metrics)
-            total += value;
-        return total;
-    }
-
     std::tuple<int, const char*> AutoUnit(double bytes) noexcept
     {
         if (bytes < 1000.)
@@ -48,6 +39,107 @@ namespace
         return {static_cast<int>(bytes / 1000 / 1000 / 1000 / 1000), "T"};
     }
 
+    /**
+     * 历史数据文件路径，HISTORY_FILE 为空字符串时不持久化
+     */
+    std::string GetHistoryFilePath() noexcept
+    {
+        if (const char* path = ::getenv("HISTORY_FILE"))
+            return path;
+        if (const char* cacheHome = ::getenv("XDG_CACHE_HOME"); cacheHome && *cacheHome)
+            return fmt::format("{}/PiSystemMonitor/history.psmh", cacheHome);
+        if (const char* home = ::getenv("HOME"); home && *home)
+            return fmt::format("{}/.cache/PiSystemMonitor/history.psmh", home);
+        return {};
+    }
+
+    /**
+     * 曲线可选的时间范围
+     */
+    struct HistoryRange
+    {
+        const char* Label;
+        uint64_t SpanMs;  // 0 表示直接显示最近的采样
+    };
+
+    constexpr HistoryRange kHistoryRanges[] = {
+        { "", 0 },
+        { "10M", 10ull * 60 * 1000 },
+        { "1H", 60ull * 60 * 1000 },
+        { "24H", 24ull * 60 * 60 * 1000 },
+        { "7D", 7ull * 24 * 60 * 60 * 1000 },
+    };
+    constexpr int kHistoryRangeCount = static_cast<int>(std::size(kHistoryRanges));
+    constexpr size_t kMaxRawWindowPoints = 60 * 60;  // 点数不超过该值的范围直接绘制长期历史中的原始采样，否则使用降采样桶
+    constexpr double kMaxGapIntervals = 2.5;  // 相邻采样间隔超过采样周期的这么多倍时视为中断，曲线在此断开
+
+    /**
+     * 汇总序列名，用于分位数与 HISTORY_FILE 的列名
+     */
+    constexpr const char* kSeriesNames[] = { "cpu", "memory", "io_read", "io_write", "net_receive", "net_transmit" };
+
+    // 长期历史中百分比保留 8 位二进制小数，字节数与速率取整，以便压缩
+    constexpr int kPercentFractionBits = 8;
+    constexpr int kBytesFractionBits = 0;
+
+    /**
+     * CPU 模式堆叠图的各层，顺序与 MetricsSampleThread::CpuModeUsage 的字段一致
+     */
+    struct CpuModeLayer
+    {
+        const char* PlotName;
+        const char* Unit;  // 单个字母，显示在数值右侧
+        ImVec4 Color;
+    };
+
+    const CpuModeLayer kCpuModeLayers[] = {
+        { "cpu_mode_user", "U", ImVec4{255 / 255.f, 140 / 255.f, 140 / 255.f, 200 / 255.f} },
+        { "cpu_mode_nice", "N", ImVec4{255 / 255.f, 190 / 255.f, 200 / 255.f, 200 / 255.f} },
+        { "cpu_mode_system", "S", ImVec4{100 / 255.f, 149 / 255.f, 237 / 255.f, 200 / 255.f} },
+        { "cpu_mode_iowait", "W", ImVec4{255 / 255.f, 215 / 255.f, 0 / 255.f, 200 / 255.f} },
+        { "cpu_mode_irq", "I", ImVec4{186 / 255.f, 85 / 255.f, 211 / 255.f, 200 / 255.f} },
+        { "cpu_mode_softirq", "Q", ImVec4{0 / 255.f, 255 / 255.f, 127 / 255.f, 200 / 255.f} },
+        { "cpu_mode_steal", "T", ImVec4{220 / 255.f, 220 / 255.f, 220 / 255.f, 200 / 255.f} },
+    };
+    constexpr size_t kCpuModeCount = std::size(kCpuModeLayers);
+
+    /**
+     * 内存堆叠图的各层，前四层位于物理内存中，最后一层为已用的交换空间
+     */
+    struct MemoryLayer
+    {
+        const char* PlotName;
+        ImVec4 Color;
+    };
+
+    const MemoryLayer kMemoryLayers[] = {
+        { "mem_anon", ImVec4{135 / 255.f, 206 / 255.f, 250 / 255.f, 220 / 255.f} },
+        { "mem_zram", ImVec4{186 / 255.f, 85 / 255.f, 211 / 255.f, 220 / 255.f} },
+        { "mem_buffers", ImVec4{100 / 255.f, 149 / 255.f, 237 / 255.f, 160 / 255.f} },
+        { "mem_cached", ImVec4{135 / 255.f, 206 / 255.f, 250 / 255.f, 90 / 255.f} },
+        { "mem_swap", ImVec4{255 / 255.f, 165 / 255.f, 0 / 255.f, 200 / 255.f} },
+    };
+    constexpr size_t kMemoryLayerCount = std::size(kMemoryLayers);
+
+    /**
+     * PSI 行的各资源，颜色与对应的 CPU、MEM、I/O 行一致
+     */
+    struct PressureLayer
+    {
+        const char* PlotName;
+        const char* FullPlotName;
+        const char* Unit;  // 单个字母，显示在数值右侧
+        ImVec4 Color;
+    };
+
+    const PressureLayer kPressureLayers[] = {
+        { "psi_cpu", "psi_cpu_full", "C", ImVec4{255 / 255.f, 140 / 255.f, 140 / 255.f, 255 / 255.f} },
+        { "psi_memory", "psi_memory_full", "M", ImVec4{135 / 255.f, 206 / 255.f, 250 / 255.f, 255 / 255.f} },
+        { "psi_io", "psi_io_full", "I", ImVec4{255 / 255.f, 215 / 255.f, 0 / 255.f, 255 / 255.f} },
+    };
+    constexpr size_t kPressureCount = std::size(kPressureLayers);
+    constexpr double kPressureMinScale = 10;  // 纵轴至少显示到 10%，避免轻微的阻塞被放大成满格
+
     std::tuple<int, int, int, int> UptimeToDHMS(double t) noexcept
     {
         auto d = floor(t / (24 * 60 * 60));
@@ -77,38 +169,203 @@ Result<void> App::Initialize() noexcept
     config.InitialHeight = 320;
     config.FullScreen = fullScreen;
     config.TargetFPS = 5;  // 5fps is enough
+
+    // 选择显示后端
+    if (const char* backend = ::getenv("DISPLAY_BACKEND"))
+    {
+        if (::strcmp(backend, "kms") == 0)
+            config.Display = DisplayType::Kms;
+        else if (::strcmp(backend, "fbdev") == 0)
+            config.Display = DisplayType::Framebuffer;
+        else if (::strcmp(backend, "headless") == 0)
+            config.Display = DisplayType::Headless;
+    }
+    if (const char* device = ::getenv("DISPLAY_DEVICE"))
+        config.DisplayDevice = device;
+
+    // 无头模式
+    if (config.Display == DisplayType::Headless)
+    {
+        config.TargetFPS = 0;  // 默认不限制帧率
+        if (const char* fps = ::getenv("HEADLESS_FPS"))
+            config.TargetFPS = ::atof(fps);
+        if (const char* frames = ::getenv("HEADLESS_FRAMES"))
+            config.Headless.Frames = ::atoi(frames);
+        if (const char* warmup = ::getenv("HEADLESS_WARMUP"))
+            config.Headless.WarmupFrames = ::atoi(warmup);
+        if (const char* dir = ::getenv("HEADLESS_DUMP_DIR"))
+            config.Headless.DumpDirectory = dir;
+        if (const char* every = ::getenv("HEADLESS_DUMP_EVERY"))
+            config.Headless.DumpEvery = ::atoi(every);
+        if (const char* stats = ::getenv("HEADLESS_STATS"))
+            config.Headless.StatsPath = stats;
+        if (const char* dt = ::getenv("HEADLESS_FIXED_DT"))
+            config.Headless.FixedDeltaTime = ::atof(dt);
+    }
     return AppBase::Initialize(config);
 }
 
 void App::OnStart() noexcept
 {
+    m_uStartTick = ::SDL_GetPerformanceCounter();
     auto& io = ImGui::GetIO();
 
-    // 加载字体
-    io.Fonts->AddFontDefault();
-    m_pDefaultFont = io.Fonts->AddFontFromMemoryCompressedTTF(kFontWhitrabt_compressed_data,
-        static_cast<int>(kFontWhitrabt_compressed_size), kFontSize1);
-    m_pNumericFont = io.Fonts->AddFontFromMemoryCompressedTTF(kFontSegment7_compressed_data,
-        static_cast<int>(kFontSegment7_compressed_size), kFontSize2);
-    m_pDefaultTinyFont = io.Fonts->AddFontFromMemoryCompressedTTF(kFontWhitrabt_compressed_data,
-        static_cast<int>(kFontWhitrabt_compressed_size), kFontSize1 / 2.5f);
-    m_pNumericTinyFont = io.Fonts->AddFontFromMemoryCompressedTTF(kFontSegment7_compressed_data,
-        static_cast<int>(kFontSegment7_compressed_size), kFontSize2 / 2.5f);
+    // 加载构建期烘焙的字体图集
+    auto fontLoadStart = chrono::steady_clock::now();
+    if (auto ret = PrebakedFontAtlas::Load(io.Fonts, kFontAtlas_data, kFontAtlas_size); ret)
+    {
+        m_pDefaultFont = PrebakedFontAtlas::GetFont(io.Fonts, PrebakedFontAtlas::FontId::Default);
+        m_pNumericFont = PrebakedFontAtlas::GetFont(io.Fonts, PrebakedFontAtlas::FontId::Numeric);
+        m_pDefaultTinyFont = PrebakedFontAtlas::GetFont(io.Fonts, PrebakedFontAtlas::FontId::DefaultTiny);
+        m_pNumericTinyFont = PrebakedFontAtlas::GetFont(io.Fonts, PrebakedFontAtlas::FontId::NumericTiny);
+
+        auto elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - fontLoadStart).count();
+        spdlog::info("Font atlas loaded in {:.2f}ms, {}x{} Alpha8, {} KiB", elapsed, io.Fonts->TexWidth, io.Fonts->TexHeight,
+            io.Fonts->TexWidth * io.Fonts->TexHeight / 1024);
+    }
+    else
+    {
+        spdlog::error("Failed to load prebaked font atlas, fallback to default font");
+        io.Fonts->Clear();
+        m_pDefaultFont = m_pNumericFont = m_pDefaultTinyFont = m_pNumericTinyFont = io.Fonts->AddFontDefault();
+    }
+
+    // 曲线显示的采样数
+    if (const char* samples = ::getenv("HISTORY_SAMPLES"))
+    {
+        m_uHistorySampleCount = static_cast<size_t>(std::max(2, ::atoi(samples)));
+        for (auto* history : { &m_stCpuUsageHistory, &m_stMemoryUsageHistory, &m_stIoReadHistory, &m_stIoWriteHistory,
+            &m_stNetworkReceiveHistory, &m_stNetworkTransmitHistory })
+        {
+            *history = MetricsHistory(m_uHistorySampleCount);
+        }
+        for (auto* columns : { &m_stCpuCoreColumns, &m_stIoReadColumns, &m_stIoWriteColumns, &m_stNetworkReceiveColumns,
+            &m_stNetworkTransmitColumns, &m_stMemoryFaultColumns, &m_stPressureColumns })
+        {
+            columns->Reset(m_uHistorySampleCount);
+        }
+    }
+
+    // 设备过滤，设为空字符串时不过滤
+    {
+        MetricsSampleThread::ChangeDeviceFilterCommand filterCmd;
+        const char* diskRules = ::getenv("DISK_FILTER");
+        if (!filterCmd.Disk.Compile(diskRules ? diskRules : DeviceFilter::kDefaultDiskRules))
+        {
+            spdlog::error("Invalid DISK_FILTER: {}, fallback to default", diskRules);
+            filterCmd.Disk.Compile(DeviceFilter::kDefaultDiskRules);
+        }
+        const char* networkRules = ::getenv("NET_FILTER");
+        if (!filterCmd.Network.Compile(networkRules ? networkRules : DeviceFilter::kDefaultNetworkRules))
+        {
+            spdlog::error("Invalid NET_FILTER: {}, fallback to default", networkRules);
+            filterCmd.Network.Compile(DeviceFilter::kDefaultNetworkRules);
+        }
+        m_stSampleThread.EnqueueCommand(std::move(filterCmd));
+    }
+
+    // 长期历史保留时长
+    if (const char* retention = ::getenv("HISTORY_RETENTION_S"))
+        m_uSeriesRetentionMs = static_cast<uint64_t>(std::max(60., ::atof(retention)) * 1000.);
+    m_stCpuUsageSeries = CompressedSeries(m_uSeriesRetentionMs, kPercentFractionBits);
+    m_stMemoryUsageSeries = CompressedSeries(m_uSeriesRetentionMs, kBytesFractionBits);
+    m_stIoReadSeries = CompressedSeries(m_uSeriesRetentionMs, kBytesFractionBits);
+    m_stIoWriteSeries = CompressedSeries(m_uSeriesRetentionMs, kBytesFractionBits);
+    m_stNetworkReceiveSeries = CompressedSeries(m_uSeriesRetentionMs, kBytesFractionBits);
+    m_stNetworkTransmitSeries = CompressedSeries(m_uSeriesRetentionMs, kBytesFractionBits);
 
     // 启动采样线程
-    const char* url = ::getenv("METRICS_URL");
-    if (!url)
-        url = "http://localhost:9100/metrics";
-    m_stSampleThread.EnqueueCommand(MetricsSampleThread::ChangeUrlCommand { url });
+    if (const char* record = ::getenv("METRICS_RECORD"))
+        m_stSampleThread.EnqueueCommand(MetricsSampleThread::RecordCommand { record });
+    if (const char* replay = ::getenv("METRICS_REPLAY"))
+    {
+        MetricsSampleThread::ReplayCommand replayCmd;
+        replayCmd.Path = replay;
+        if (const char* mode = ::getenv("METRICS_REPLAY_MODE"))
+            replayCmd.RealTime = ::strcmp(mode, "fast") != 0;
+        if (const char* loop = ::getenv("METRICS_REPLAY_LOOP"))
+            replayCmd.Loop = ::strcmp(loop, "1") == 0;
+        m_stSampleThread.EnqueueCommand(std::move(replayCmd));
+    }
+    else
+    {
+        const char* url = ::getenv("METRICS_URL");
+        if (!url)
+            url = "http://localhost:9100/metrics";
+        MetricsSampleThread::ChangeUrlCommand changeUrlCmd { url };
+        if (const char* interval = ::getenv("METRICS_INTERVAL_MS"))
+            changeUrlCmd.RefreshIntervalMs = std::max(10., ::atof(interval));
+        m_dSampleIntervalMs = changeUrlCmd.RefreshIntervalMs;
+        if (const char* prime = ::getenv("METRICS_PRIME_MS"))
+            changeUrlCmd.PrimeIntervalMs = std::max(0., ::atof(prime));
+
+        // 恢复上次运行的历史数据，回放时数据来自采集文件，不做持久化
+        if (auto path = GetHistoryFilePath(); !path.empty())
+        {
+            std::error_code ec;
+            std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+            std::vector<std::string> names(std::begin(kSeriesNames), std::end(kSeriesNames));
+            if (m_stHistoryFile.Open(path, names, m_uHistorySampleCount))
+            {
+                auto nowMs = static_cast<uint64_t>(chrono::duration_cast<chrono::milliseconds>(
+                    chrono::system_clock::now().time_since_epoch()).count());
+                auto restored = m_stHistoryFile.Restore(nowMs, changeUrlCmd.RefreshIntervalMs, { &m_stCpuUsageHistory,
+                    &m_stMemoryUsageHistory, &m_stIoReadHistory, &m_stIoWriteHistory, &m_stNetworkReceiveHistory,
+                    &m_stNetworkTransmitHistory }, { &m_stCpuUsageSeries, &m_stMemoryUsageSeries, &m_stIoReadSeries,
+                    &m_stIoWriteSeries, &m_stNetworkReceiveSeries, &m_stNetworkTransmitSeries });
+                auto restoredBuckets = m_stHistoryFile.RestoreRollups(nowMs, { &m_stCpuUsageRollup, &m_stMemoryUsageRollup,
+                    &m_stIoReadRollup, &m_stIoWriteRollup, &m_stNetworkReceiveRollup, &m_stNetworkTransmitRollup });
+                spdlog::info("Restored {} history samples and {} rollup buckets from {}", restored, restoredBuckets, path);
+            }
+        }
+        m_stSampleThread.EnqueueCommand(std::move(changeUrlCmd));
+    }
     m_stSampleThreadHandle = thread([this]() { m_stSampleThread.Run(); });
 
-    // 填充数据
-    m_stCpuUsageHistory.resize(kHistorySampleCount);
-    m_stMemoryUsageHistory.resize(kHistorySampleCount);
-    m_stIoReadHistory.resize(kHistorySampleCount);
-    m_stIoWriteHistory.resize(kHistorySampleCount);
-    m_stNetworkReceiveHistory.resize(kHistorySampleCount);
-    m_stNetworkTransmitHistory.resize(kHistorySampleCount);
+#if defined(PSM_ENABLE_TRACE) && PSM_ENABLE_TRACE
+    // 时间线追踪
+    if (const char* traceFile = ::getenv("TRACE_FILE"))
+    {
+        const char* traceSeconds = ::getenv("TRACE_SECONDS");
+        Trace::Install(traceFile, traceSeconds ? ::atof(traceSeconds) : 0.);
+    }
+#endif
+
+    // 自身指标
+    if (const char* listen = ::getenv("SELF_METRICS_LISTEN"))
+        SelfMetrics::StartServer(listen);
+
+    // CPU 模式堆叠图
+    if (const char* modes = ::getenv("CPU_MODES"))
+        m_bShowCpuModes = ::atoi(modes) != 0;
+    m_stCpuModeHistory = StackedHistory(kCpuModeCount, m_uHistorySampleCount);
+
+    // 内存构成与缺页
+    if (const char* detail = ::getenv("MEM_DETAIL"))
+        m_bShowMemoryDetail = ::atoi(detail) != 0;
+    m_stMemoryLayerHistory = StackedHistory(kMemoryLayerCount, m_uHistorySampleCount);
+
+    // PSI 行
+    if (const char* psi = ::getenv("PSI"))
+        m_bShowPressure = ::atoi(psi) != 0;
+
+    // 核心热力图
+    if (const char* heatmap = ::getenv("CPU_HEATMAP_HEIGHT"))
+        m_iCpuHeatmapHeight = std::max(0, ::atoi(heatmap));
+
+    // 分位数窗口
+    if (const char* window = ::getenv("QUANTILE_WINDOW_S"))
+        m_uQuantileWindowMs = static_cast<uint64_t>(std::max(0., ::atof(window)) * 1000.);
+    if (m_uQuantileWindowMs != 0)
+        m_stSketches.assign(kSeriesCount, WindowedQuantileSketch(m_uQuantileWindowMs));
+
+    // 曲线时间范围
+    if (const char* range = ::getenv("HISTORY_RANGE"))
+        m_iHistoryRange = std::clamp(::atoi(range), 0, kHistoryRangeCount - 1);
+
+    // 性能 HUD
+    if (const char* hud = ::getenv("PROFILER_HUD"))
+        m_iProfilerPage = std::clamp(::atoi(hud), 0, 2);
 
     // 隐藏鼠标
     SDL_ShowCursor(SDL_DISABLE);
@@ -119,34 +376,102 @@ void App::OnFrame(double delta) noexcept
     try
     {
         // 从采样线程接收数据
-        MetricsSampleThread::Result sampleThreadResult;
-        while (m_stSampleThread.TryDequeueResult(sampleThreadResult))
         {
-            if (std::holds_alternative<MetricsSampleThread::MetricsResult>(sampleThreadResult))
+            PSM_TRACE_SCOPE("Dequeue");
+            MetricsSampleThread::Result sampleThreadResult;
+            while (m_stSampleThread.TryDequeueResult(sampleThreadResult))
             {
-                auto& metrics = std::get<MetricsSampleThread::MetricsResult>(sampleThreadResult);
-                m_stCurrentMetrics = std::move(metrics);
-
-                // 记录历史数据
-                m_stCpuUsageHistory.push_back(CalculateTotalCpuUsage(m_stCurrentMetrics.CpuUsage));
-                m_stMemoryUsageHistory.push_back(static_cast<double>(m_stCurrentMetrics.MemoryTotalBytes -
-                    m_stCurrentMetrics.MemoryAvailableBytes));
-                m_stIoReadHistory.push_back(SumAllMetricsValue(m_stCurrentMetrics.DiskReadBytesPerSecond));
-                m_stIoWriteHistory.push_back(SumAllMetricsValue(m_stCurrentMetrics.DiskWrittenBytesPerSecond));
-                m_stNetworkReceiveHistory.push_back(SumAllMetricsValue(m_stCurrentMetrics.NetworkReceiveBytesPerSecond));
-                m_stNetworkTransmitHistory.push_back(SumAllMetricsValue(m_stCurrentMetrics.NetworkTransmitBytesPerSecond));
-                if (m_stCpuUsageHistory.size() > kHistorySampleCount)
-                    m_stCpuUsageHistory.erase(m_stCpuUsageHistory.begin());
-                if (m_stMemoryUsageHistory.size() > kHistorySampleCount)
-                    m_stMemoryUsageHistory.erase(m_stMemoryUsageHistory.begin());
-                if (m_stIoReadHistory.size() > kHistorySampleCount)
-                    m_stIoReadHistory.erase(m_stIoReadHistory.begin());
-                if (m_stIoWriteHistory.size() > kHistorySampleCount)
-                    m_stIoWriteHistory.erase(m_stIoWriteHistory.begin());
-                if (m_stNetworkReceiveHistory.size() > kHistorySampleCount)
-                    m_stNetworkReceiveHistory.erase(m_stNetworkReceiveHistory.begin());
-                if (m_stNetworkTransmitHistory.size() > kHistorySampleCount)
-                    m_stNetworkTransmitHistory.erase(m_stNetworkTransmitHistory.begin());
+                if (std::holds_alternative<MetricsSampleThread::MetricsResult>(sampleThreadResult))
+                {
+                    auto& metrics = std::get<MetricsSampleThread::MetricsResult>(sampleThreadResult);
+                    SelfMetrics::ObserveResultDequeued();
+                    GetProfiler().Record(FrameProfiler::Phase::SampleFetch, metrics.FetchSeconds);
+                    GetProfiler().Record(FrameProfiler::Phase::SampleParse, metrics.ParseSeconds);
+                    GetProfiler().Record(FrameProfiler::Phase::SampleCompute, metrics.ComputeSeconds);
+                    metrics.Timestamps.Dequeue = ::SDL_GetPerformanceCounter();
+                    m_stPendingLatency.push_back(metrics.Timestamps);
+                    m_stCurrentMetrics = std::move(metrics);
+
+                    // 记录历史数据
+                    m_stCpuCoreColumns.AppendRow(m_stCurrentMetrics.CpuUsage);
+                    m_stIoReadColumns.AppendRow(m_stCurrentMetrics.DiskReadBytesPerSecond);
+                    m_stIoWriteColumns.AppendRow(m_stCurrentMetrics.DiskWrittenBytesPerSecond);
+                    m_stNetworkReceiveColumns.AppendRow(m_stCurrentMetrics.NetworkReceiveBytesPerSecond);
+                    m_stNetworkTransmitColumns.AppendRow(m_stCurrentMetrics.NetworkTransmitBytesPerSecond);
+                    m_stDiskRanking.clear();
+                    for (const auto& disk : m_stCurrentMetrics.Disks)
+                        m_stDiskRanking.push_back(&disk);
+                    std::stable_sort(m_stDiskRanking.begin(), m_stDiskRanking.end(), [](const auto* a, const auto* b) {
+                        return a->second.Utilization > b->second.Utilization;
+                    });
+                    if (m_iCpuHeatmapHeight != 0 && !m_stCurrentMetrics.CpuUsage.empty())
+                    {
+                        // 尺寸变化时重建纹理，之后每次采样只上传一列
+                        auto rows = std::min(m_stCurrentMetrics.CpuUsage.size(), static_cast<size_t>(m_iCpuHeatmapHeight));
+                        auto columns = std::min<size_t>(m_uHistorySampleCount, 1024);
+                        if (m_stCpuHeatmap.GetRows() != rows || m_stCpuHeatmap.GetColumns() != columns)
+                            m_stCpuHeatmap.Reset(GetDisplay(), columns, rows);
+                        m_stCpuHeatmap.PushColumn(m_stCurrentMetrics.CpuUsage.data(), m_stCurrentMetrics.CpuUsage.size(), 100);
+                    }
+
+                    // 有核心下线时实体数会多于本次采样的核心数，平均值只统计本次采样中的核心
+                    m_stCpuUsageHistory.Push(ColumnStore::Mean(m_stCpuCoreColumns.GetLatestRow(), m_stCurrentMetrics.CpuUsage.size()));
+                    const auto& modes = m_stCurrentMetrics.CpuModes;
+                    const double modeValues[] = { modes.User, modes.Nice, modes.System, modes.IoWait, modes.Irq, modes.SoftIrq,
+                        modes.Steal };
+                    static_assert(std::size(modeValues) == kCpuModeCount);
+                    m_stCpuModeHistory.Push(modeValues);
+                    if (m_stCurrentMetrics.HasPressure)
+                    {
+                        const auto& pressure = m_stCurrentMetrics.Pressure;
+                        m_stPressureColumns.AppendRow({ pressure.CpuSome, pressure.MemorySome, pressure.IoSome, pressure.CpuFull,
+                            pressure.MemoryFull, pressure.IoFull });
+                    }
+                    m_stMemoryUsageHistory.Push(static_cast<double>(m_stCurrentMetrics.MemoryTotalBytes -
+                        m_stCurrentMetrics.MemoryAvailableBytes));
+                    const auto& memory = m_stCurrentMetrics.Memory;
+                    const double memoryValues[] = { static_cast<double>(memory.AnonBytes),
+                        static_cast<double>(memory.ZramCompressedBytes), static_cast<double>(memory.BuffersBytes),
+                        static_cast<double>(memory.CachedBytes), static_cast<double>(memory.SwapUsedBytes) };
+                    static_assert(std::size(memoryValues) == kMemoryLayerCount);
+                    m_stMemoryLayerHistory.Push(memoryValues);
+                    if (m_stCurrentMetrics.HasVmstat)
+                    {
+                        m_stMemoryFaultColumns.AppendRow({ memory.MajorFaultsPerSecond, memory.SwapInPagesPerSecond,
+                            memory.SwapOutPagesPerSecond });
+                    }
+                    m_stIoReadHistory.Push(m_stIoReadColumns.SumLatest());
+                    m_stIoWriteHistory.Push(m_stIoWriteColumns.SumLatest());
+                    m_stNetworkReceiveHistory.Push(m_stNetworkReceiveColumns.SumLatest());
+                    m_stNetworkTransmitHistory.Push(m_stNetworkTransmitColumns.SumLatest());
+                    if (m_stHistoryFile.IsOpen())
+                    {
+                        const double values[] = { m_stCpuUsageHistory.GetLatest(), m_stMemoryUsageHistory.GetLatest(),
+                            m_stIoReadHistory.GetLatest(), m_stIoWriteHistory.GetLatest(),
+                            m_stNetworkReceiveHistory.GetLatest(), m_stNetworkTransmitHistory.GetLatest() };
+                        m_stHistoryFile.Append(m_stCurrentMetrics.TimestampMs, values);
+                    }
+                    auto timestampMs = m_stCurrentMetrics.TimestampMs;
+                    m_stCpuUsageRollup.Append(timestampMs, m_stCpuUsageHistory.GetLatest());
+                    m_stMemoryUsageRollup.Append(timestampMs, m_stMemoryUsageHistory.GetLatest());
+                    m_stIoReadRollup.Append(timestampMs, m_stIoReadHistory.GetLatest());
+                    m_stIoWriteRollup.Append(timestampMs, m_stIoWriteHistory.GetLatest());
+                    m_stNetworkReceiveRollup.Append(timestampMs, m_stNetworkReceiveHistory.GetLatest());
+                    m_stNetworkTransmitRollup.Append(timestampMs, m_stNetworkTransmitHistory.GetLatest());
+                    if (m_stHistoryFile.IsOpen())
+                    {
+                        const RollupSeries* rollups[] = { &m_stCpuUsageRollup, &m_stMemoryUsageRollup, &m_stIoReadRollup,
+                            &m_stIoWriteRollup, &m_stNetworkReceiveRollup, &m_stNetworkTransmitRollup };
+                        m_stHistoryFile.StoreRollups(rollups);
+                    }
+                    m_stCpuUsageLod.Push(m_stCpuUsageHistory.GetLatest());
+                    m_stMemoryUsageLod.Push(m_stMemoryUsageHistory.GetLatest());
+                    m_stIoReadLod.Push(m_stIoReadHistory.GetLatest());
+                    m_stIoWriteLod.Push(m_stIoWriteHistory.GetLatest());
+                    m_stNetworkReceiveLod.Push(m_stNetworkReceiveHistory.GetLatest());
+                    m_stNetworkTransmitLod.Push(m_stNetworkTransmitHistory.GetLatest());
+                    RecordAllSeries();
+                }
             }
         }
 
@@ -176,15 +501,25 @@ void App::OnFrame(double delta) noexcept
                 ImGui::Text("%s", timeStr);
                 ImGui::SameLine(0, 60);
                 ImGui::Text("%s", uptimeStr);
+                ImGui::SameLine(0, 30);
+                ImGui::Text("LA %.2f %.2f %.2f", m_stCurrentMetrics.Load1, m_stCurrentMetrics.Load5, m_stCurrentMetrics.Load15);
+                if (m_iHistoryRange != 0)
+                {
+                    ImGui::SameLine(0, 30);
+                    ImGui::Text("%s", kHistoryRanges[m_iHistoryRange].Label);
+                }
                 ImGui::PopFont();
             }
             ImGui::EndGroup();
 
             // 图表
-            if (ImGui::BeginTable("metrics_table", 4, ImGuiTableFlags_SizingFixedFit))
+            auto showQuantiles = m_uQuantileWindowMs != 0;
+            if (!m_bShowDiskPage && ImGui::BeginTable("metrics_table", showQuantiles ? 5 : 4, ImGuiTableFlags_SizingFixedFit))
             {
-                auto drawMetricRow = [&](const char* label, int value, const char* unit, const char* plotCanvasName, const char* plotName,
-                    double* data, size_t count, optional<double> maxY = {}, optional<ImVec4> lineColor = {},
+                auto drawMetricRow = [&](const char* label, int value, const char* unit, const char* series, const char* plotCanvasName,
+                    const char* plotName, const MetricsHistory& history, const RollupSeries& rollup, SparklineLod& lod, CompressedSeries& longHistory,
+                    optional<double> maxY = {},
+                    optional<ImVec4> lineColor = {},
                     optional<ImVec4> fillColor = {}) {
                     ImGui::TableNextRow();
                     ImGui::PushFont(m_pDefaultFont);
@@ -204,7 +539,40 @@ void App::OnFrame(double delta) noexcept
                     ImGui::Text("%s", unit);
                     ImGui::PopStyleColor();
 
-                    ImGui::TableSetColumnIndex(3);
+                    if (showQuantiles)
+                    {
+                        // 窗口内的 p50/p95/p99，字节数与单位分别取整
+                        ImGui::TableSetColumnIndex(3);
+                        ImGui::PushFont(m_pDefaultTinyFont);
+                        ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(150 / 255., 150 / 255., 150 / 255., 1.f));
+                        auto isPercent = ::strcmp(series, "cpu") == 0;
+                        ImGui::Text("%s%s", isPercent ? "P50 P95 P99" : "P50  P95  P99 ", m_bQuantilePerDevice ? "/D" : "");
+                        ImGui::PopStyleColor();
+                        if (auto it = m_stQuantiles.find(series); it != m_stQuantiles.end())
+                        {
+                            char text[64];
+                            auto* p = text;
+                            for (auto quantile : it->second)
+                            {
+                                if (p != text)
+                                    *p++ = ' ';
+                                if (isPercent)
+                                {
+                                    p += ::snprintf(p, static_cast<size_t>(text + sizeof(text) - p), "%3d", static_cast<int>(quantile));
+                                }
+                                else
+                                {
+                                    auto autoUnit = AutoUnit(quantile);
+                                    p += ::snprintf(p, static_cast<size_t>(text + sizeof(text) - p), "%3d%s", std::get<0>(autoUnit),
+                                        std::get<1>(autoUnit));
+                                }
+                            }
+                            ImGui::Text("%s", text);
+                        }
+                        ImGui::PopFont();
+                    }
+
+                    ImGui::TableSetColumnIndex(showQuantiles ? 4 : 3);
                     auto plotWidth = displaySize.x - ImGui::GetCursorScreenPos().x;
                     ImPlot::PushStyleVar(ImPlotStyleVar_PlotPadding, ImVec2(0, 0));
                     ImPlot::PushStyleColor(ImPlotCol_PlotBorder, ImVec4(0, 0, 0, 0));
@@ -214,16 +582,123 @@ void App::OnFrame(double delta) noexcept
                         ImPlot::PushStyleColor(ImPlotCol_Fill, *fillColor);
                     if (ImPlot::BeginPlot(plotCanvasName, {plotWidth, kFontSize1}, ImPlotFlags_CanvasOnly))
                     {
-                        if (!maxY)
+                        ImPlot::SetupAxes(nullptr, nullptr, ImPlotAxisFlags_NoDecorations, ImPlotAxisFlags_NoDecorations);
+                        const auto& range = kHistoryRanges[m_iHistoryRange];
+                        auto pixelWidth = static_cast<size_t>(std::max(1.f, plotWidth));
+
+                        // 绘制连续的一段：第 i 个点位于 xStart + i，整个图宽 xSpan 个点，超过像素宽度时按比例取最小/最大值，
+                        // 填充与折线为同一组数据时只降采样一次
+                        auto plotSegment = [&](const double* fill, const double* line, size_t count, double xStart, size_t xSpan) {
+                            if (xSpan <= pixelWidth)
+                            {
+                                ImPlot::PlotShaded(plotName, fill, static_cast<int>(count), 0, 1, xStart);
+                                ImPlot::PlotLine(plotName, line, static_cast<int>(count), 1, xStart);
+                                return;
+                            }
+                            auto width = std::max<size_t>(1, count * pixelWidth / xSpan);
+                            SparklineLod::Decimate(fill, count, width, xStart, m_stLodFillX, m_stLodFillY);
+                            ImPlot::PlotShaded(plotName, m_stLodFillX.data(), m_stLodFillY.data(), static_cast<int>(m_stLodFillX.size()));
+                            if (line == fill)
+                            {
+                                ImPlot::PlotLine(plotName, m_stLodFillX.data(), m_stLodFillY.data(), static_cast<int>(m_stLodFillX.size()));
+                                return;
+                            }
+                            SparklineLod::Decimate(line, count, width, xStart, m_stLodLineX, m_stLodLineY);
+                            ImPlot::PlotLine(plotName, m_stLodLineX.data(), m_stLodLineY.data(), static_cast<int>(m_stLodLineX.size()));
+                        };
+                        if (range.SpanMs == 0 && history.GetSize() <= pixelWidth)
                         {
-                            for (size_t i = 0; i < count; ++i)
-                                maxY = maxY ? std::max(*maxY, data[i]) : data[i];
+                            const auto* data = history.GetData();
+                            auto count = history.GetSize();
+                            if (!maxY)
+                            {
+                                for (size_t i = 0; i < count; ++i)
+                                    maxY = maxY ? std::max(*maxY, data[i]) : data[i];
+                            }
+
+                            ImPlot::SetupAxesLimits(0, static_cast<double>(history.GetCapacity()), 0, *maxY, ImPlotCond_Always);
+                            ImPlot::PlotShaded(plotName, data, static_cast<int>(count));
+                            ImPlot::PlotLine(plotName, data, static_cast<int>(count));
                         }
+                        else if (range.SpanMs == 0)
+                        {
+                            // 采样数超过像素宽度，使用增量维护的最小/最大值降采样结果
+                            if (lod.GetWidth() != pixelWidth || lod.GetCapacity() != history.GetCapacity())
+                                lod.Rebuild(history.GetData(), history.GetSize(), history.GetCapacity(), pixelWidth);
+                            const auto& xs = lod.GetX();
+                            const auto& ys = lod.GetY();
+                            if (!maxY)
+                                maxY = lod.GetMax();
 
-                        ImPlot::SetupAxes(nullptr, nullptr, ImPlotAxisFlags_NoDecorations, ImPlotAxisFlags_NoDecorations);
-                        ImPlot::SetupAxesLimits(0, kHistorySampleCount, 0, *maxY, ImPlotCond_Always);
-                        ImPlot::PlotShaded(plotName, data, static_cast<int>(count));
-                        ImPlot::PlotLine(plotName, data, static_cast<int>(count));
+                            ImPlot::SetupAxesLimits(0, static_cast<double>(history.GetCapacity()), 0, *maxY, ImPlotCond_Always);
+                            ImPlot::PlotShaded(plotName, xs.data(), ys.data(), static_cast<int>(xs.size()));
+                            ImPlot::PlotLine(plotName, xs.data(), ys.data(), static_cast<int>(xs.size()));
+                        }
+                        else if (auto windowPoints = static_cast<size_t>(static_cast<double>(range.SpanMs) / m_dSampleIntervalMs);
+                            range.SpanMs <= m_uSeriesRetentionMs && windowPoints <= kMaxRawWindowPoints)
+                        {
+                            // 原始采样，解码结果由 GetWindow 缓存并随采样增量更新。按时间戳放置，右端为最新采样，
+                            // 窗口中早于时间范围的点（采样中断前的数据）不显示，相邻两点间隔过大时断开
+                            const auto& window = longHistory.GetWindow(windowPoints);
+                            const auto& timestamps = longHistory.GetWindowTimestamps();
+                            auto endMs = timestamps.empty() ? 0 : timestamps.back();
+                            auto startMs = endMs - std::min(endMs, range.SpanMs);
+                            auto first = static_cast<size_t>(std::lower_bound(timestamps.begin(), timestamps.end(), startMs) -
+                                timestamps.begin());
+                            if (!maxY)
+                            {
+                                maxY = 0.;
+                                for (auto i = first; i < window.size(); ++i)
+                                    maxY = std::max(*maxY, window[i]);
+                            }
+
+                            ImPlot::SetupAxesLimits(0, static_cast<double>(windowPoints), 0, *maxY, ImPlotCond_Always);
+                            auto maxGapMs = static_cast<uint64_t>(kMaxGapIntervals * m_dSampleIntervalMs);
+                            for (auto begin = first; begin < window.size();)
+                            {
+                                auto end = begin + 1;
+                                while (end < window.size() && timestamps[end] - timestamps[end - 1] <= maxGapMs)
+                                    ++end;
+                                auto xStart = static_cast<double>(timestamps[begin] - startMs) / m_dSampleIntervalMs;
+                                plotSegment(window.data() + begin, window.data() + begin, end - begin, xStart, windowPoints);
+                                begin = end;
+                            }
+                        }
+                        else
+                        {
+                            // 按像素宽度选择降采样级别，填充显示每个桶的最大值，折线显示平均值。按桶的起始时间放置，
+                            // 右端为最新采样所在的桶，没有数据的桶留空
+                            auto tier = RollupSeries::SelectTier(range.SpanMs, pixelWidth);
+                            auto tierWidthMs = RollupSeries::GetTierWidthMs(tier);
+                            auto slots = static_cast<size_t>((range.SpanMs + tierWidthMs - 1) / tierWidthMs);
+                            rollup.CopyRecent(tier, m_stCurrentMetrics.TimestampMs, slots, m_stRollupMin, m_stRollupMax,
+                                m_stRollupAverage);
+                            if (!maxY)
+                            {
+                                maxY = 0.;
+                                for (auto value : m_stRollupMax)
+                                {
+                                    if (!std::isnan(value))
+                                        maxY = std::max(*maxY, value);
+                                }
+                            }
+
+                            ImPlot::SetupAxesLimits(0, static_cast<double>(slots), 0, *maxY, ImPlotCond_Always);
+                            for (size_t begin = 0; begin < slots;)
+                            {
+                                if (std::isnan(m_stRollupMax[begin]))
+                                {
+                                    ++begin;
+                                    continue;
+                                }
+                                auto end = begin + 1;
+                                while (end < slots && !std::isnan(m_stRollupMax[end]))
+                                    ++end;
+                                plotSegment(m_stRollupMax.data() + begin, m_stRollupAverage.data() + begin, end - begin,
+                                    static_cast<double>(begin), slots);
+                                begin = end;
+                            }
+                        }
                         ImPlot::EndPlot();
                     }
                     ImPlot::PopStyleColor();
@@ -249,37 +724,301 @@ void App::OnFrame(double delta) noexcept
                 static const ImVec4 kNetworkTransmitPlotColor = ImVec4{0 / 255.f, 255 / 255.f, 127 / 255.f, 255 / 255.f};
                 static const ImVec4 kNetworkTransmitPlotColorFill = ImVec4{0 / 255.f, 255 / 255.f, 127 / 255.f, 50 / 255.f};
 
-                drawMetricRow("CPU", static_cast<int>(m_stCpuUsageHistory.back()), "%", "cpu_plot_c", "cpu_plot",
-                    m_stCpuUsageHistory.data(), m_stCpuUsageHistory.size(), 100, kCpuPlotColor, kCpuPlotColorFill);
+                if (m_bShowPressure && m_stCurrentMetrics.HasPressure && m_stPressureColumns.GetEntityCount() == kPressureCount * 2 &&
+                    kHistoryRanges[m_iHistoryRange].SpanMs == 0)
+                {
+                    // PSI：折线为 some，填充为 full，左侧显示阻塞最严重的资源
+                    // 使用小字体与同高的曲线放在第一行，其他可选行都开启时也不会被挤出屏幕
+                    const auto* latest = m_stPressureColumns.GetLatestRow();
+                    size_t top = 0;
+                    for (size_t i = 1; i < kPressureCount; ++i)
+                    {
+                        if (latest[i] > latest[top])
+                            top = i;
+                    }
 
-                auto memAutoUnit = AutoUnit(m_stMemoryUsageHistory.back());
-                drawMetricRow("MEM", std::get<0>(memAutoUnit), std::get<1>(memAutoUnit), "mem_plot_c", "mem_plot",
-                    m_stMemoryUsageHistory.data(), m_stMemoryUsageHistory.size(), m_stCurrentMetrics.MemoryTotalBytes,
+                    ImGui::TableNextRow();
+                    ImGui::PushFont(m_pDefaultTinyFont);
+                    ImGui::TableSetColumnIndex(0);
+                    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(150 / 255., 150 / 255., 150 / 255., 1.f));
+                    ImGui::Text("%s", "PSI");
+                    ImGui::PopStyleColor();
+                    ImGui::TableSetColumnIndex(1);
+                    ImGui::PushFont(m_pNumericTinyFont);
+                    ImGui::Text("%03d", static_cast<int>(latest[top]));
+                    ImGui::PopFont();
+                    ImGui::TableSetColumnIndex(2);
+                    ImGui::PushStyleColor(ImGuiCol_Text, kPressureLayers[top].Color);
+                    ImGui::Text("%s", kPressureLayers[top].Unit);
+                    ImGui::PopStyleColor();
+
+                    ImGui::TableSetColumnIndex(showQuantiles ? 4 : 3);
+                    auto plotWidth = displaySize.x - ImGui::GetCursorScreenPos().x;
+                    auto capacity = m_stPressureColumns.GetCapacity();
+                    auto maxY = kPressureMinScale;
+                    for (size_t i = 0; i < kPressureCount; ++i)
+                        maxY = std::max(maxY, ColumnStore::Max(m_stPressureColumns.GetColumn(i), capacity));
+                    ImPlot::PushStyleVar(ImPlotStyleVar_PlotPadding, ImVec2(0, 0));
+                    ImPlot::PushStyleColor(ImPlotCol_PlotBorder, ImVec4(0, 0, 0, 0));
+                    if (ImPlot::BeginPlot("psi_plot_c", {plotWidth, m_pDefaultTinyFont->FontSize}, ImPlotFlags_CanvasOnly))
+                    {
+                        ImPlot::SetupAxes(nullptr, nullptr, ImPlotAxisFlags_NoDecorations, ImPlotAxisFlags_NoDecorations);
+                        ImPlot::SetupAxesLimits(0, static_cast<double>(capacity), 0, maxY, ImPlotCond_Always);
+                        for (size_t i = 0; i < kPressureCount; ++i)
+                        {
+                            const auto& layer = kPressureLayers[i];
+                            ImPlot::PushStyleColor(ImPlotCol_Fill, ImVec4(layer.Color.x, layer.Color.y, layer.Color.z, 80 / 255.f));
+                            ImPlot::PlotShaded(layer.FullPlotName, m_stPressureColumns.GetColumn(kPressureCount + i),
+                                static_cast<int>(capacity));
+                            ImPlot::PopStyleColor();
+                            ImPlot::PushStyleColor(ImPlotCol_Line, layer.Color);
+                            ImPlot::PlotLine(layer.PlotName, m_stPressureColumns.GetColumn(i), static_cast<int>(capacity));
+                            ImPlot::PopStyleColor();
+                        }
+                        ImPlot::EndPlot();
+                    }
+                    ImPlot::PopStyleColor();
+                    ImPlot::PopStyleVar();
+                    ImGui::PopFont();
+                }
+
+                drawMetricRow("CPU", static_cast<int>(m_stCpuUsageHistory.GetLatest()), "%", "cpu", "cpu_plot_c", "cpu_plot",
+                    m_stCpuUsageHistory, m_stCpuUsageRollup, m_stCpuUsageLod, m_stCpuUsageSeries, 100, kCpuPlotColor, kCpuPlotColorFill);
+
+                if (m_bShowCpuModes && kHistoryRanges[m_iHistoryRange].SpanMs == 0)
+                {
+                    // CPU 模式堆叠图：左侧显示除 User/Nice 外占比最高的模式，便于区分 iowait、softirq、steal 造成的占用
+                    const auto& modes = m_stCurrentMetrics.CpuModes;
+                    const double modeValues[] = { modes.User, modes.Nice, modes.System, modes.IoWait, modes.Irq, modes.SoftIrq,
+                        modes.Steal };
+                    size_t top = 2;
+                    for (size_t i = 3; i < kCpuModeCount; ++i)
+                    {
+                        if (modeValues[i] > modeValues[top])
+                            top = i;
+                    }
+
+                    ImGui::TableNextRow();
+                    ImGui::PushFont(m_pDefaultFont);
+                    ImGui::TableSetColumnIndex(1);
+                    ImGui::PushFont(m_pNumericFont);
+                    ImGui::Text("%03d", static_cast<int>(modeValues[top]));
+                    ImGui::PopFont();
+                    ImGui::TableSetColumnIndex(2);
+                    ImGui::PushStyleColor(ImGuiCol_Text, kCpuModeLayers[top].Color);
+                    ImGui::Text("%s", kCpuModeLayers[top].Unit);
+                    ImGui::PopStyleColor();
+
+                    ImGui::TableSetColumnIndex(showQuantiles ? 4 : 3);
+                    auto plotWidth = displaySize.x - ImGui::GetCursorScreenPos().x;
+                    ImPlot::PushStyleVar(ImPlotStyleVar_PlotPadding, ImVec2(0, 0));
+                    ImPlot::PushStyleColor(ImPlotCol_PlotBorder, ImVec4(0, 0, 0, 0));
+                    if (ImPlot::BeginPlot("cpu_mode_plot_c", {plotWidth, kFontSize1}, ImPlotFlags_CanvasOnly))
+                    {
+                        ImPlot::SetupAxes(nullptr, nullptr, ImPlotAxisFlags_NoDecorations, ImPlotAxisFlags_NoDecorations);
+                        ImPlot::SetupAxesLimits(0, static_cast<double>(m_stCpuModeHistory.GetCapacity()), 0, 100, ImPlotCond_Always);
+                        auto count = static_cast<int>(m_stCpuModeHistory.GetCapacity());
+                        for (size_t i = 0; i < kCpuModeCount; ++i)
+                        {
+                            ImPlot::PushStyleColor(ImPlotCol_Fill, kCpuModeLayers[i].Color);
+                            ImPlot::PlotShaded(kCpuModeLayers[i].PlotName, m_stCpuModeHistory.GetX(), m_stCpuModeHistory.GetLower(i),
+                                m_stCpuModeHistory.GetUpper(i), count);
+                            ImPlot::PopStyleColor();
+                        }
+                        ImPlot::EndPlot();
+                    }
+                    ImPlot::PopStyleColor();
+                    ImPlot::PopStyleVar();
+                    ImGui::PopFont();
+                }
+
+                if (m_stCpuHeatmap.IsValid())
+                {
+                    // 核心热力图：纵轴为核心，横轴为时间，左侧显示最忙核心的使用率
+                    const auto& cpuUsage = m_stCurrentMetrics.CpuUsage;
+                    ImGui::TableNextRow();
+                    ImGui::PushFont(m_pDefaultFont);
+                    ImGui::TableSetColumnIndex(0);
+                    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(150 / 255., 150 / 255., 150 / 255., 1.f));
+                    ImGui::Text("%s", "TOP");
+                    ImGui::PopStyleColor();
+                    ImGui::TableSetColumnIndex(1);
+                    ImGui::PushFont(m_pNumericFont);
+                    ImGui::Text("%03d", static_cast<int>(ColumnStore::Max(cpuUsage.data(), cpuUsage.size())));
+                    ImGui::PopFont();
+                    ImGui::TableSetColumnIndex(2);
+                    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(150 / 255., 150 / 255., 150 / 255., 1.f));
+                    ImGui::Text("%s", "%");
+                    ImGui::PopStyleColor();
+                    ImGui::TableSetColumnIndex(showQuantiles ? 4 : 3);
+                    m_stCpuHeatmap.Draw({ displaySize.x - ImGui::GetCursorScreenPos().x, static_cast<float>(m_iCpuHeatmapHeight) });
+                    ImGui::PopFont();
+                }
+
+                auto memAutoUnit = AutoUnit(m_stMemoryUsageHistory.GetLatest());
+                drawMetricRow("MEM", std::get<0>(memAutoUnit), std::get<1>(memAutoUnit), "memory", "mem_plot_c", "mem_plot",
+                    m_stMemoryUsageHistory, m_stMemoryUsageRollup, m_stMemoryUsageLod, m_stMemoryUsageSeries,
+                    m_stCurrentMetrics.MemoryTotalBytes,
                     kMemoryPlotColor, kMemoryPlotColorFill);
 
-                auto ioReadAutoUnit = AutoUnit(m_stIoReadHistory.back());
-                drawMetricRow("I/O", std::get<0>(ioReadAutoUnit), std::get<1>(ioReadAutoUnit), "io_read_plot_c", "io_read_plot",
-                    m_stIoReadHistory.data(), m_stIoReadHistory.size(), {}, kIoReadPlotColor, kIoReadPlotColorFill);
+                if (m_bShowMemoryDetail && m_stCurrentMetrics.MemoryTotalBytes != 0 && kHistoryRanges[m_iHistoryRange].SpanMs == 0)
+                {
+                    // 内存构成：匿名页、zram 压缩后占用、Buffers、页缓存，其上为已用交换空间，左侧显示已用交换空间
+                    const auto& memory = m_stCurrentMetrics.Memory;
+                    auto swapAutoUnit = AutoUnit(static_cast<double>(memory.SwapUsedBytes));
+                    ImGui::TableNextRow();
+                    ImGui::PushFont(m_pDefaultFont);
+                    ImGui::TableSetColumnIndex(0);
+                    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(150 / 255., 150 / 255., 150 / 255., 1.f));
+                    ImGui::Text("%s", "SWP");
+                    ImGui::PopStyleColor();
+                    ImGui::TableSetColumnIndex(1);
+                    ImGui::PushFont(m_pNumericFont);
+                    ImGui::Text("%03d", std::get<0>(swapAutoUnit));
+                    ImGui::PopFont();
+                    ImGui::TableSetColumnIndex(2);
+                    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(150 / 255., 150 / 255., 150 / 255., 1.f));
+                    ImGui::Text("%s", std::get<1>(swapAutoUnit));
+                    ImGui::PopStyleColor();
+
+                    ImGui::TableSetColumnIndex(showQuantiles ? 4 : 3);
+                    auto plotPos = ImGui::GetCursorScreenPos();
+                    auto plotWidth = displaySize.x - plotPos.x;
+                    ImPlot::PushStyleVar(ImPlotStyleVar_PlotPadding, ImVec2(0, 0));
+                    ImPlot::PushStyleColor(ImPlotCol_PlotBorder, ImVec4(0, 0, 0, 0));
+                    if (ImPlot::BeginPlot("mem_layer_plot_c", {plotWidth, kFontSize1}, ImPlotFlags_CanvasOnly))
+                    {
+                        auto maxY = static_cast<double>(m_stCurrentMetrics.MemoryTotalBytes + memory.SwapTotalBytes);
+                        ImPlot::SetupAxes(nullptr, nullptr, ImPlotAxisFlags_NoDecorations, ImPlotAxisFlags_NoDecorations);
+                        ImPlot::SetupAxesLimits(0, static_cast<double>(m_stMemoryLayerHistory.GetCapacity()), 0, maxY,
+                            ImPlotCond_Always);
+                        auto count = static_cast<int>(m_stMemoryLayerHistory.GetCapacity());
+                        for (size_t i = 0; i < kMemoryLayerCount; ++i)
+                        {
+                            ImPlot::PushStyleColor(ImPlotCol_Fill, kMemoryLayers[i].Color);
+                            ImPlot::PlotShaded(kMemoryLayers[i].PlotName, m_stMemoryLayerHistory.GetX(),
+                                m_stMemoryLayerHistory.GetLower(i), m_stMemoryLayerHistory.GetUpper(i), count);
+                            ImPlot::PopStyleColor();
+                        }
+                        ImPlot::EndPlot();
+                    }
+                    ImPlot::PopStyleColor();
+                    ImPlot::PopStyleVar();
+
+                    if (memory.ZramOriginalBytes != 0)
+                    {
+                        // zram 中数据压缩前后的大小，叠加在图表左上角
+                        auto compressed = AutoUnit(static_cast<double>(memory.ZramCompressedBytes));
+                        auto original = AutoUnit(static_cast<double>(memory.ZramOriginalBytes));
+                        char text[64];
+                        ::snprintf(text, sizeof(text), "Z %d%s/%d%s", std::get<0>(compressed), std::get<1>(compressed),
+                            std::get<0>(original), std::get<1>(original));
+                        ImGui::GetWindowDrawList()->AddText(m_pDefaultTinyFont, m_pDefaultTinyFont->FontSize,
+                            plotPos, ImGui::GetColorU32(kMemoryLayers[1].Color), text);
+                    }
+                    ImGui::PopFont();
+                }
+
+                if (m_bShowMemoryDetail && m_stMemoryFaultColumns.GetEntityCount() == 3 && kHistoryRanges[m_iHistoryRange].SpanMs == 0)
+                {
+                    // 主缺页速率：填充与折线为主缺页，另两条折线为换入、换出页数
+                    auto capacity = m_stMemoryFaultColumns.GetCapacity();
+                    const auto* faults = m_stMemoryFaultColumns.GetColumn(0);
+                    ImGui::TableNextRow();
+                    ImGui::PushFont(m_pDefaultFont);
+                    ImGui::TableSetColumnIndex(0);
+                    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(150 / 255., 150 / 255., 150 / 255., 1.f));
+                    ImGui::Text("%s", "FLT");
+                    ImGui::PopStyleColor();
+                    ImGui::TableSetColumnIndex(1);
+                    ImGui::PushFont(m_pNumericFont);
+                    ImGui::Text("%03d", static_cast<int>(std::min(999., m_stMemoryFaultColumns.GetLatestRow()[0])));
+                    ImGui::PopFont();
+                    ImGui::TableSetColumnIndex(2);
+                    ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(150 / 255., 150 / 255., 150 / 255., 1.f));
+                    ImGui::Text("%s", "/S");
+                    ImGui::PopStyleColor();
+
+                    ImGui::TableSetColumnIndex(showQuantiles ? 4 : 3);
+                    auto plotWidth = displaySize.x - ImGui::GetCursorScreenPos().x;
+                    auto maxY = 1.;
+                    for (size_t i = 0; i < 3; ++i)
+                        maxY = std::max(maxY, ColumnStore::Max(m_stMemoryFaultColumns.GetColumn(i), capacity));
+                    ImPlot::PushStyleVar(ImPlotStyleVar_PlotPadding, ImVec2(0, 0));
+                    ImPlot::PushStyleColor(ImPlotCol_PlotBorder, ImVec4(0, 0, 0, 0));
+                    if (ImPlot::BeginPlot("mem_fault_plot_c", {plotWidth, kFontSize1}, ImPlotFlags_CanvasOnly))
+                    {
+                        ImPlot::SetupAxes(nullptr, nullptr, ImPlotAxisFlags_NoDecorations, ImPlotAxisFlags_NoDecorations);
+                        ImPlot::SetupAxesLimits(0, static_cast<double>(capacity), 0, maxY, ImPlotCond_Always);
+                        ImPlot::PushStyleColor(ImPlotCol_Line, kMemoryPlotColor);
+                        ImPlot::PushStyleColor(ImPlotCol_Fill, kMemoryPlotColorFill);
+                        ImPlot::PlotShaded("mem_major_fault", faults, static_cast<int>(capacity));
+                        ImPlot::PlotLine("mem_major_fault", faults, static_cast<int>(capacity));
+                        ImPlot::PopStyleColor(2);
+                        ImPlot::PushStyleColor(ImPlotCol_Line, kMemoryLayers[4].Color);
+                        ImPlot::PlotLine("mem_swap_in", m_stMemoryFaultColumns.GetColumn(1), static_cast<int>(capacity));
+                        ImPlot::PopStyleColor();
+                        ImPlot::PushStyleColor(ImPlotCol_Line, kMemoryLayers[1].Color);
+                        ImPlot::PlotLine("mem_swap_out", m_stMemoryFaultColumns.GetColumn(2), static_cast<int>(capacity));
+                        ImPlot::PopStyleColor();
+                        ImPlot::EndPlot();
+                    }
+                    ImPlot::PopStyleColor();
+                    ImPlot::PopStyleVar();
+                    ImGui::PopFont();
+                }
+
+                auto ioReadAutoUnit = AutoUnit(m_stIoReadHistory.GetLatest());
+                drawMetricRow("I/O", std::get<0>(ioReadAutoUnit), std::get<1>(ioReadAutoUnit), "io_read", "io_read_plot_c", "io_read_plot",
+                    m_stIoReadHistory, m_stIoReadRollup, m_stIoReadLod, m_stIoReadSeries, {}, kIoReadPlotColor, kIoReadPlotColorFill);
 
-                auto ioWriteAutoUnit = AutoUnit(m_stIoWriteHistory.back());
-                drawMetricRow("   ", std::get<0>(ioWriteAutoUnit), std::get<1>(ioWriteAutoUnit), "io_write_plot_c", "io_write_plot",
-                    m_stIoWriteHistory.data(), m_stIoWriteHistory.size(), {}, kIoWritePlotColor, kIoWritePlotColorFill);
+                auto ioWriteAutoUnit = AutoUnit(m_stIoWriteHistory.GetLatest());
+                drawMetricRow("   ", std::get<0>(ioWriteAutoUnit), std::get<1>(ioWriteAutoUnit), "io_write", "io_write_plot_c", "io_write_plot",
+                    m_stIoWriteHistory, m_stIoWriteRollup, m_stIoWriteLod, m_stIoWriteSeries, {}, kIoWritePlotColor, kIoWritePlotColorFill);
 
-                auto networkReceiveAutoUnit = AutoUnit(m_stNetworkReceiveHistory.back());
-                drawMetricRow("NET", std::get<0>(networkReceiveAutoUnit), std::get<1>(networkReceiveAutoUnit), "network_receive_plot_c",
-                    "network_receive_plot", m_stNetworkReceiveHistory.data(), m_stNetworkReceiveHistory.size(), {},
+                auto networkReceiveAutoUnit = AutoUnit(m_stNetworkReceiveHistory.GetLatest());
+                drawMetricRow("NET", std::get<0>(networkReceiveAutoUnit), std::get<1>(networkReceiveAutoUnit), "net_receive", "network_receive_plot_c",
+                    "network_receive_plot", m_stNetworkReceiveHistory, m_stNetworkReceiveRollup, m_stNetworkReceiveLod,
+                    m_stNetworkReceiveSeries, {},
                     kNetworkReceivePlotColor, kNetworkReceivePlotColorFill);
 
-                auto networkTransmitAutoUnit = AutoUnit(m_stNetworkTransmitHistory.back());
-                drawMetricRow("   ", std::get<0>(networkTransmitAutoUnit), std::get<1>(networkTransmitAutoUnit), "network_transmit_plot_c",
-                    "network_transmit_plot", m_stNetworkTransmitHistory.data(), m_stNetworkTransmitHistory.size(), {},
+                auto networkTransmitAutoUnit = AutoUnit(m_stNetworkTransmitHistory.GetLatest());
+                drawMetricRow("   ", std::get<0>(networkTransmitAutoUnit), std::get<1>(networkTransmitAutoUnit), "net_transmit", "network_transmit_plot_c",
+                    "network_transmit_plot", m_stNetworkTransmitHistory, m_stNetworkTransmitRollup, m_stNetworkTransmitLod,
+                    m_stNetworkTransmitSeries, {},
                     kNetworkTransmitPlotColor, kNetworkTransmitPlotColorFill);
 
                 ImGui::EndTable();
             }
+            if (m_bShowDiskPage)
+                DrawDiskPage();
 
             ImGui::End();
         }
+
+        // 磁盘详情页
+        if (ImGui::IsKeyPressed(ImGuiKey_F4, false))
+            m_bShowDiskPage = !m_bShowDiskPage;
+
+        // 曲线时间范围
+        if (ImGui::IsKeyPressed(ImGuiKey_F2, false))
+            m_iHistoryRange = (m_iHistoryRange + 1) % kHistoryRangeCount;
+
+        // 分位数统计方式
+        if (m_uQuantileWindowMs != 0 && ImGui::IsKeyPressed(ImGuiKey_F3, false))
+        {
+            m_bQuantilePerDevice = !m_bQuantilePerDevice;
+            UpdateQuantiles();
+        }
+
+        // 性能 HUD
+        if (ImGui::IsKeyPressed(ImGuiKey_F1, false))
+            m_iProfilerPage = (m_iProfilerPage + 1) % 3;
+        if (m_iProfilerPage != 0)
+        {
+            GetProfiler().DrawOverlay(m_pDefaultTinyFont, m_iProfilerPage == 1 ? FrameProfiler::OverlayPage::Frame :
+                FrameProfiler::OverlayPage::Latency);
+        }
     }
     catch (...)
     {
@@ -291,4 +1030,208 @@ void App::OnStop() noexcept
     // 等待采样线程结束
     m_stSampleThread.EnqueueCommand(MetricsSampleThread::QuitCommand {});
     m_stSampleThreadHandle.join();
+
+    SelfMetrics::StopServer();
+    m_stHistoryFile.Close();
+    m_stCpuHeatmap.Release();
+}
+
+void App::OnFramePresented(uint64_t presentTick) noexcept
+{
+    static Uint64 kFrequency = ::SDL_GetPerformanceFrequency();
+    auto seconds = [](uint64_t from, uint64_t to) {
+        return to > from ? static_cast<double>(to - from) / static_cast<double>(kFrequency) : 0.;
+    };
+
+    // 本帧取出的结果已经显示，记录各段延迟
+    auto& profiler = GetProfiler();
+    if (!m_bFirstValidFrameRecorded && !m_stPendingLatency.empty())
+    {
+        m_bFirstValidFrameRecorded = true;
+        auto elapsed = seconds(m_uStartTick, presentTick);
+        profiler.Record(FrameProfiler::Phase::FirstValidFrame, elapsed);
+        spdlog::info("First valid frame presented {:.1f}ms after start", elapsed * 1000.);
+    }
+    for (auto& timestamps : m_stPendingLatency)
+    {
+        timestamps.Present = presentTick;
+        if (timestamps.FirstByte != 0)
+        {
+            profiler.Record(FrameProfiler::Phase::LatencyFirstByte, seconds(timestamps.RequestStart, timestamps.FirstByte));
+            profiler.Record(FrameProfiler::Phase::LatencyParse, seconds(timestamps.FirstByte, timestamps.ParseEnd));
+        }
+        profiler.Record(FrameProfiler::Phase::LatencyEnqueue, seconds(timestamps.ParseEnd, timestamps.Enqueue));
+        profiler.Record(FrameProfiler::Phase::LatencyQueue, seconds(timestamps.Enqueue, timestamps.Dequeue));
+        profiler.Record(FrameProfiler::Phase::LatencyDisplay, seconds(timestamps.Dequeue, timestamps.Present));
+        profiler.Record(FrameProfiler::Phase::LatencyTotal, seconds(timestamps.RequestStart, timestamps.Present));
+    }
+    m_stPendingLatency.clear();
+}
+
+void App::DrawDiskPage() noexcept
+{
+    static const ImVec4 kHeaderColor = ImVec4(150 / 255., 150 / 255., 150 / 255., 1.f);
+    static const ImVec4 kBusyColor = ImVec4{255 / 255.f, 140 / 255.f, 140 / 255.f, 255 / 255.f};
+
+    ImGui::PushFont(m_pDefaultTinyFont);
+    if (ImGui::BeginTable("disk_table", 7, ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_PadOuterX))
+    {
+        static const char* kHeaders[] = { "DEV", "%UTIL", "R/S", "W/S", "R_AWAIT", "W_AWAIT", "QD" };
+        ImGui::TableNextRow();
+        ImGui::PushStyleColor(ImGuiCol_Text, kHeaderColor);
+        for (int i = 0; i < static_cast<int>(std::size(kHeaders)); ++i)
+        {
+            ImGui::TableSetColumnIndex(i);
+            ImGui::TextUnformatted(kHeaders[i]);
+        }
+        ImGui::PopStyleColor();
+
+        // 只绘制可见的行
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_stDiskRanking.size()));
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+            {
+                const auto& [device, stats] = *m_stDiskRanking[static_cast<size_t>(row)];
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::TextUnformatted(device.c_str());
+                ImGui::TableSetColumnIndex(1);
+                if (stats.Utilization >= 90)
+                    ImGui::TextColored(kBusyColor, "%5.1f", stats.Utilization);
+                else
+                    ImGui::Text("%5.1f", stats.Utilization);
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%6.0f", stats.ReadIops);
+                ImGui::TableSetColumnIndex(3);
+                ImGui::Text("%6.0f", stats.WriteIops);
+                ImGui::TableSetColumnIndex(4);
+                ImGui::Text("%7.2f", stats.ReadAwaitMs);
+                ImGui::TableSetColumnIndex(5);
+                ImGui::Text("%7.2f", stats.WriteAwaitMs);
+                ImGui::TableSetColumnIndex(6);
+                ImGui::Text("%5.2f", stats.QueueDepth);
+            }
+        }
+        ImGui::EndTable();
+    }
+    if (m_stDiskRanking.empty())
+        ImGui::TextUnformatted("NO DISK STATS");
+    ImGui::PopFont();
+}
+
+void App::RecordAllSeries()
+{
+    const auto& metrics = m_stCurrentMetrics;
+    auto timestampMs = metrics.TimestampMs;
+    const double values[] = { m_stCpuUsageHistory.GetLatest(), m_stMemoryUsageHistory.GetLatest(), m_stIoReadHistory.GetLatest(),
+        m_stIoWriteHistory.GetLatest(), m_stNetworkReceiveHistory.GetLatest(), m_stNetworkTransmitHistory.GetLatest() };
+    CompressedSeries* series[] = { &m_stCpuUsageSeries, &m_stMemoryUsageSeries, &m_stIoReadSeries, &m_stIoWriteSeries,
+        &m_stNetworkReceiveSeries, &m_stNetworkTransmitSeries };
+    static_assert(std::size(values) == kSeriesCount && std::size(series) == kSeriesCount && std::size(kSeriesNames) == kSeriesCount);
+
+    for (size_t i = 0; i < kSeriesCount; ++i)
+        series[i]->Append(timestampMs, values[i]);
+
+    // 每个核心、每个设备的长期历史与估计，下标与 kSeriesNames 一致，内存没有按设备拆分
+    auto recordDevice = [&](size_t index, std::string_view key, double value) {
+        RecordDeviceSeries(index, key, value);
+        if (m_uQuantileWindowMs != 0)
+            RecordDeviceSketch(m_stDeviceSketches[index], key, value);
+    };
+    for (size_t i = 0; i < metrics.CpuUsage.size(); ++i)
+    {
+        char key[16];
+        auto result = std::to_chars(key, key + sizeof(key), i);
+        recordDevice(0, std::string_view(key, static_cast<size_t>(result.ptr - key)), metrics.CpuUsage[i]);
+    }
+    for (const auto& [device, value] : metrics.DiskReadBytesPerSecond)
+        recordDevice(2, device, value);
+    for (const auto& [device, value] : metrics.DiskWrittenBytesPerSecond)
+        recordDevice(3, device, value);
+    for (const auto& [device, value] : metrics.NetworkReceiveBytesPerSecond)
+        recordDevice(4, device, value);
+    for (const auto& [device, value] : metrics.NetworkTransmitBytesPerSecond)
+        recordDevice(5, device, value);
+
+    // 已消失的设备在保留时长内不再有新数据，释放其长期历史
+    size_t bytes = 0;
+    size_t seriesCount = kSeriesCount;
+    for (size_t i = 0; i < kSeriesCount; ++i)
+    {
+        std::erase_if(m_stDeviceSeries[i], [&](const auto& entry) {
+            return entry.second.GetLastTimestampMs() + m_uSeriesRetentionMs < timestampMs;
+        });
+        bytes += series[i]->GetMemoryBytes();
+        for (const auto& [_, device] : m_stDeviceSeries[i])
+            bytes += device.GetMemoryBytes();
+        seriesCount += m_stDeviceSeries[i].size();
+    }
+    SelfMetrics::SetHistoryBytes(bytes, seriesCount);
+
+    if (m_uQuantileWindowMs == 0)
+        return;
+
+    for (size_t i = 0; i < kSeriesCount; ++i)
+        m_stSketches[i].Add(timestampMs, values[i]);
+
+    // 已消失的设备在窗口内不再有数据，释放其估计
+    for (auto& sketches : m_stDeviceSketches)
+    {
+        std::erase_if(sketches, [&](const auto& entry) {
+            return entry.second.LastTimestampMs + m_uQuantileWindowMs < timestampMs;
+        });
+    }
+
+    UpdateQuantiles();
+}
+
+void App::RecordDeviceSeries(size_t index, std::string_view key, double value)
+{
+    auto& series = m_stDeviceSeries[index];
+    auto it = series.find(key);
+    if (it == series.end())
+    {
+        auto fractionBits = index == 0 ? kPercentFractionBits : kBytesFractionBits;
+        it = series.emplace(std::string(key), CompressedSeries(m_uSeriesRetentionMs, fractionBits)).first;
+    }
+    it->second.Append(m_stCurrentMetrics.TimestampMs, value);
+}
+
+void App::RecordDeviceSketch(DeviceSketchMap& sketches, std::string_view key, double value)
+{
+    auto it = sketches.find(key);
+    if (it == sketches.end())
+        it = sketches.emplace(std::string(key), DeviceSketch { WindowedQuantileSketch(m_uQuantileWindowMs) }).first;
+    it->second.Sketch.Add(m_stCurrentMetrics.TimestampMs, value);
+    it->second.LastTimestampMs = m_stCurrentMetrics.TimestampMs;
+}
+
+void App::UpdateQuantiles()
+{
+    static const double kQuantiles[] = { 0.5, 0.95, 0.99 };
+
+    if (m_uQuantileWindowMs == 0)
+        return;
+
+    for (size_t i = 0; i < kSeriesCount; ++i)
+    {
+        const QuantileSketch* sketch = nullptr;
+        if (m_bQuantilePerDevice && !m_stDeviceSketches[i].empty())
+        {
+            // 合并每个核心、设备的估计，没有按设备拆分的序列（如内存）仍使用汇总值
+            m_stQuantileScratch.Clear();
+            for (const auto& [_, device] : m_stDeviceSketches[i])
+                device.Sketch.MergeInto(m_stQuantileScratch);
+            if (m_stQuantileScratch.GetCount() != 0)
+                sketch = &m_stQuantileScratch;
+        }
+        if (!sketch)
+            sketch = &m_stSketches[i].GetMerged();
+
+        auto& quantiles = m_stQuantiles[kSeriesNames[i]];
+        for (size_t j = 0; j < std::size(kQuantiles); ++j)
+            quantiles[j] = sketch->GetQuantile(kQuantiles[j]);
+    }
 }
@@ -8,64 +8,58 @@
 #include <imgui.h>
 #include <implot.h>
 #include <spdlog/spdlog.h>
-#include <SDLError.hpp>
-#include <ImGuiSDL2Backend.hpp>
-#include <ImGuiOpenGLBackend.hpp>
+#include <SDLDisplay.hpp>
+#include <FramebufferDisplay.hpp>
+#include <HeadlessDisplay.hpp>
+#include <SelfMetrics.hpp>
+#include <Trace.hpp>
+#ifdef PSM_HAS_KMS
+#include <KmsDisplay.hpp>
+#endif
 
 using namespace std;
 
-AppBase::~AppBase() noexcept
-{
-    ImGuiOpenGLBackend::Shutdown();
-    ImGuiSDL2Backend::Shutdown();
-    ImPlot::DestroyContext();
-    ImGui::DestroyContext();
-
-    ::SDL_GL_DeleteContext(m_pGLContext);
-    ::SDL_DestroyWindow(m_pMainWindow);
-}
-
-Result<void> AppBase::Initialize(const AppBaseConfig& config) noexcept
+namespace
 {
-    if (auto ret = ::SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_GAMECONTROLLER); ret != 0)
+    std::unique_ptr<IDisplay> CreateDisplay(DisplayType type) noexcept
     {
-        spdlog::error("SDL_Init failed: {}", ::SDL_GetError());
-        return MakeSDLError(ret);
+        switch (type)
+        {
+            case DisplayType::SDL:
+                return std::make_unique<SDLDisplay>();
+#ifdef PSM_HAS_KMS
+            case DisplayType::Kms:
+                return std::make_unique<KmsDisplay>();
+#endif
+            case DisplayType::Framebuffer:
+                return std::make_unique<FramebufferDisplay>();
+            case DisplayType::Headless:
+                return std::make_unique<HeadlessDisplay>();
+            default:
+                return {};
+        }
     }
+}
 
-#ifdef SDL_HINT_IME_SHOW_UI
-    ::SDL_SetHint(SDL_HINT_IME_SHOW_UI, "1");
-#endif
+AppBase::~AppBase() noexcept
+{
+    m_pDisplay.reset();
 
-    ::SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
-    ::SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
-    ::SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
-    ::SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 2);
-    ::SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 2);
-    auto windowFlags = SDL_WINDOW_OPENGL | SDL_WINDOW_ALLOW_HIGHDPI;
-    if (config.Resizable)
-        windowFlags |= SDL_WINDOW_RESIZABLE;
-    if (config.Borderless)
-        windowFlags |= SDL_WINDOW_BORDERLESS;
-    if (config.FullScreen)
-        windowFlags |= SDL_WINDOW_FULLSCREEN;
-    SDL_Window* window = ::SDL_CreateWindow(config.Title.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, config.InitialWidth,
-        config.InitialHeight, static_cast<SDL_WindowFlags>(windowFlags));
-    if (window == nullptr)
+    if (ImGui::GetCurrentContext())
     {
-        spdlog::error("SDL_CreateWindow failed: {}", ::SDL_GetError());
-        return MakeSDLError(-1);
+        ImPlot::DestroyContext();
+        ImGui::DestroyContext();
     }
+}
 
-    SDL_GLContext glContext = ::SDL_GL_CreateContext(window);
-    if (glContext == nullptr)
+Result<void> AppBase::Initialize(const AppBaseConfig& config) noexcept
+{
+    auto display = CreateDisplay(config.Display);
+    if (!display)
     {
-        spdlog::error("SDL_GL_CreateContext failed: {}", ::SDL_GetError());
-        ::SDL_DestroyWindow(window);
-        return MakeSDLError(-1);
+        spdlog::error("Display backend {} is not available in this build", static_cast<int>(config.Display));
+        return make_error_code(errc::not_supported);
     }
-    ::SDL_GL_MakeCurrent(window, glContext);
-    ::SDL_GL_SetSwapInterval(1); // Enable vsync
 
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
@@ -77,17 +71,18 @@ Result<void> AppBase::Initialize(const AppBaseConfig& config) noexcept
     ImGui::StyleColorsDark();
     ImPlot::StyleColorsDark();
 
-    ImGuiSDL2Backend::Initialize(window);
-    ImGuiOpenGLBackend::Initialize();
+    if (auto ret = display->Initialize(config); !ret)
+        return ret;
 
-    m_pMainWindow = window;
-    m_pGLContext = glContext;
+    m_pDisplay = std::move(display);
+    m_pDisplay->AttachProfiler(&m_stProfiler);
     m_dTargetFps = config.TargetFPS;
     return {};
 }
 
 void AppBase::Run() noexcept
 {
+    PSM_TRACE_THREAD_NAME("ui");
     OnStart();
 
     static Uint64 kFrequency = ::SDL_GetPerformanceFrequency();
@@ -99,46 +94,78 @@ void AppBase::Run() noexcept
         auto deltaTime = static_cast<double>(currentTick - lastTick) / static_cast<double>(kFrequency);
         lastTick = currentTick;
 
-        // Poll and handle events (inputs, window resize, etc.)
-        // You can read the io.WantCaptureMouse, io.WantCaptureKeyboard flags to tell if dear imgui wants to use your inputs.
-        // - When io.WantCaptureMouse is true, do not dispatch mouse input data to your main application, or clear/overwrite your copy of the mouse data.
-        // - When io.WantCaptureKeyboard is true, do not dispatch keyboard input data to your main application, or clear/overwrite your copy of the keyboard data.
-        // Generally you may always pass all inputs to dear imgui, and hide them from your application based on those two flags.
-        ::SDL_Event event;
-        while (::SDL_PollEvent(&event))
+        // 依次记录各阶段耗时
+        auto phaseTick = currentTick;
+        auto endPhase = [&](FrameProfiler::Phase phase) {
+            auto now = ::SDL_GetPerformanceCounter();
+            m_stProfiler.Record(phase, static_cast<double>(now - phaseTick) / static_cast<double>(kFrequency));
+            phaseTick = now;
+        };
+
+#if defined(PSM_ENABLE_TRACE) && PSM_ENABLE_TRACE
+        Trace::Poll();
+#endif
+        PSM_TRACE_SCOPE("Frame");
+
+        bool exitRequest = false;
+        {
+            PSM_TRACE_SCOPE("PollEvents");
+            m_pDisplay->PollEvents(exitRequest);
+        }
+        if (exitRequest)
         {
-            ImGuiSDL2Backend::ProcessEvent(&event);
-            if (event.type == SDL_QUIT || (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_CLOSE &&
-                event.window.windowID == ::SDL_GetWindowID(m_pMainWindow)))
-            {
-                bool doExit = true;
-                OnExitRequest(doExit);
-                if (doExit)
-                    m_bExit = true;
-            }
+            bool doExit = true;
+            OnExitRequest(doExit);
+            if (doExit)
+                m_bExit = true;
         }
-        if (::SDL_GetWindowFlags(m_pMainWindow) & SDL_WINDOW_MINIMIZED)
+        if (m_pDisplay->IsSuspended())
         {
+            SelfMetrics::ObserveFrame(false, false);
             ::SDL_Delay(100);
             continue;
         }
+        endPhase(FrameProfiler::Phase::PollEvents);
+
+        {
+            PSM_TRACE_SCOPE("NewFrame");
+            m_pDisplay->NewFrame();
+            ImGui::NewFrame();
+        }
+        endPhase(FrameProfiler::Phase::NewFrame);
+
+        {
+            PSM_TRACE_SCOPE("OnFrame");
+            OnFrame(deltaTime);
+        }
+        endPhase(FrameProfiler::Phase::OnFrame);
 
-        ImGuiOpenGLBackend::NewFrame();
-        ImGuiSDL2Backend::NewFrame();
-        ImGui::NewFrame();
+        {
+            PSM_TRACE_SCOPE("ImGuiRender");
+            ImGui::Render();
+        }
+        endPhase(FrameProfiler::Phase::ImGuiRender);
 
-        OnFrame(deltaTime);
+        {
+            PSM_TRACE_SCOPE("RenderDrawData");
+            m_pDisplay->Render(ImGui::GetDrawData());
+        }
+        endPhase(FrameProfiler::Phase::RenderDrawData);
 
-        ImGuiIO& io = ImGui::GetIO();
-        ImGui::Render();
-        ImGuiOpenGLBackend::Clear(static_cast<int>(io.DisplaySize.x), static_cast<int>(io.DisplaySize.y));
-        ImGuiOpenGLBackend::RenderDrawData(ImGui::GetDrawData());
-        ::SDL_GL_SwapWindow(m_pMainWindow);
+        {
+            PSM_TRACE_SCOPE("Present");
+            m_pDisplay->Present();
+        }
+        endPhase(FrameProfiler::Phase::Present);
+        OnFramePresented(phaseTick);
 
         auto currentTickEndFrame = ::SDL_GetPerformanceCounter();
         auto frameTime = static_cast<double>(currentTickEndFrame - currentTick) / static_cast<double>(kFrequency);
-        if (frameTime < 1.0 / m_dTargetFps)
+        m_stProfiler.Record(FrameProfiler::Phase::Frame, frameTime);
+        SelfMetrics::ObserveFrame(true, m_dTargetFps > 0 && frameTime > 1.0 / m_dTargetFps);
+        if (m_dTargetFps > 0 && frameTime < 1.0 / m_dTargetFps)
         {
+            PSM_TRACE_SCOPE("Sleep");
             auto sleepTimeMs = static_cast<int>(1000.0 * (1.0 / m_dTargetFps - frameTime));
             ::SDL_Delay(sleepTimeMs);
         }
@@ -150,3 +177,7 @@ void AppBase::Run() noexcept
 void AppBase::OnExitRequest(bool& doExit) noexcept
 {
 }
+
+void AppBase::OnFramePresented(uint64_t presentTick) noexcept
+{
+}
@@ -0,0 +1,181 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <ColumnStore.hpp>
+
+#include <algorithm>
+
+using namespace std;
+
+double ColumnStore::Sum(const double* values, size_t count) noexcept
+{
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        s0 += values[i];
+        s1 += values[i + 1];
+        s2 += values[i + 2];
+        s3 += values[i + 3];
+    }
+    for (; i < count; ++i)
+        s0 += values[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+double ColumnStore::Mean(const double* values, size_t count) noexcept
+{
+    if (count == 0)
+        return 0;
+    return Sum(values, count) / static_cast<double>(count);
+}
+
+double ColumnStore::Max(const double* values, size_t count) noexcept
+{
+    if (count == 0)
+        return 0;
+
+    double m0 = values[0], m1 = values[0], m2 = values[0], m3 = values[0];
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        m0 = values[i] > m0 ? values[i] : m0;
+        m1 = values[i + 1] > m1 ? values[i + 1] : m1;
+        m2 = values[i + 2] > m2 ? values[i + 2] : m2;
+        m3 = values[i + 3] > m3 ? values[i + 3] : m3;
+    }
+    for (; i < count; ++i)
+        m0 = values[i] > m0 ? values[i] : m0;
+    return std::max(std::max(m0, m1), std::max(m2, m3));
+}
+
+ColumnStore::ColumnStore(size_t capacity)
+{
+    Reset(capacity);
+}
+
+void ColumnStore::Reset(size_t capacity)
+{
+    m_uCapacity = std::max<size_t>(capacity, 1);
+    m_uHead = 0;
+    m_uRowCount = 0;
+    m_stNames.clear();
+    m_stIndex.clear();
+    m_stData.clear();
+    m_stLatest.clear();
+    m_stLastSeenRows.clear();
+    m_stLastOrder.clear();
+}
+
+void ColumnStore::AppendRow(const std::vector<double>& values)
+{
+    while (m_stNames.size() < values.size())
+        AddEntity(std::to_string(m_stNames.size()));
+
+    std::copy(values.begin(), values.end(), m_stLatest.begin());
+    std::fill(m_stLatest.begin() + static_cast<ptrdiff_t>(values.size()), m_stLatest.end(), 0.);
+    std::fill_n(m_stLastSeenRows.begin(), values.size(), m_uRowCount);
+    WriteRow();
+}
+
+void ColumnStore::AppendRow(const std::map<std::string, double>& values)
+{
+    // 设备集合通常不变，先按上一次的对应关系逐个比较名称
+    bool sameOrder = values.size() == m_stLastOrder.size();
+    if (sameOrder)
+    {
+        size_t i = 0;
+        for (const auto& [name, _] : values)
+        {
+            if (m_stNames[m_stLastOrder[i++]] != name)
+            {
+                sameOrder = false;
+                break;
+            }
+        }
+    }
+    if (!sameOrder)
+    {
+        m_stLastOrder.clear();
+        for (const auto& [name, _] : values)
+        {
+            auto it = m_stIndex.find(name);
+            m_stLastOrder.push_back(static_cast<uint32_t>(it != m_stIndex.end() ? it->second : AddEntity(name)));
+        }
+    }
+
+    std::fill(m_stLatest.begin(), m_stLatest.end(), 0.);
+    size_t i = 0;
+    for (const auto& [_, value] : values)
+    {
+        auto index = m_stLastOrder[i++];
+        m_stLatest[index] = value;
+        m_stLastSeenRows[index] = m_uRowCount;
+    }
+    WriteRow();
+}
+
+const double* ColumnStore::GetColumn(size_t index) const noexcept
+{
+    return m_stData.data() + index * 2 * m_uCapacity + m_uHead;
+}
+
+size_t ColumnStore::AddEntity(const std::string& name)
+{
+    auto index = m_stNames.size();
+    m_stNames.push_back(name);
+    m_stIndex.emplace(name, static_cast<uint32_t>(index));
+    m_stData.resize(m_stData.size() + 2 * m_uCapacity, 0.);
+    m_stLatest.push_back(0.);
+    m_stLastSeenRows.push_back(m_uRowCount);
+    return index;
+}
+
+void ColumnStore::WriteRow()
+{
+    auto stride = 2 * m_uCapacity;
+    auto* column = m_stData.data() + m_uHead;
+    for (size_t i = 0; i < m_stLatest.size(); ++i, column += stride)
+        column[0] = column[m_uCapacity] = m_stLatest[i];
+    m_uHead = (m_uHead + 1) % m_uCapacity;
+    ++m_uRowCount;
+
+    EvictAbsent();
+}
+
+void ColumnStore::EvictAbsent()
+{
+    // 最后一次出现的行已移出窗口
+    auto isAbsent = [this](size_t index) { return m_stLastSeenRows[index] + m_uCapacity < m_uRowCount; };
+    size_t index = 0;
+    while (index < m_stNames.size() && !isAbsent(index))
+        ++index;
+    if (index == m_stNames.size())
+        return;
+
+    // 移除很少发生，直接整体压缩
+    auto stride = 2 * m_uCapacity;
+    auto kept = index;
+    for (++index; index < m_stNames.size(); ++index)
+    {
+        if (isAbsent(index))
+            continue;
+        m_stNames[kept] = std::move(m_stNames[index]);
+        m_stLatest[kept] = m_stLatest[index];
+        m_stLastSeenRows[kept] = m_stLastSeenRows[index];
+        std::copy_n(m_stData.begin() + static_cast<ptrdiff_t>(index * stride), stride,
+            m_stData.begin() + static_cast<ptrdiff_t>(kept * stride));
+        ++kept;
+    }
+    m_stNames.resize(kept);
+    m_stLatest.resize(kept);
+    m_stLastSeenRows.resize(kept);
+    m_stData.resize(kept * stride);
+
+    m_stIndex.clear();
+    for (size_t i = 0; i < kept; ++i)
+        m_stIndex.emplace(m_stNames[i], static_cast<uint32_t>(i));
+    m_stLastOrder.clear();
+}
@@ -0,0 +1,343 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <CompressedSeries.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+
+namespace
+{
+    constexpr unsigned kMaxLeadingZeros = 31;  // 前导零个数使用 5 位记录
+    constexpr size_t kInitialChunkWords = 32;
+
+    uint64_t DoubleToBits(double value) noexcept
+    {
+        return std::bit_cast<uint64_t>(value);
+    }
+
+    double BitsToDouble(uint64_t bits) noexcept
+    {
+        return std::bit_cast<double>(bits);
+    }
+
+    /**
+     * 按位从高到低读取
+     */
+    class BitReader
+    {
+    public:
+        explicit BitReader(const uint64_t* words) noexcept
+            : m_pWords(words) {}
+
+        /**
+         * 读取 bits 位，bits 取值 1~64
+         */
+        uint64_t Read(unsigned bits) noexcept
+        {
+            auto index = m_uPosition >> 6;
+            auto offset = static_cast<unsigned>(m_uPosition & 63);
+            auto available = 64 - offset;
+            m_uPosition += bits;
+
+            auto word = m_pWords[index];
+            if (bits <= available)
+                return (word << offset) >> (64 - bits);
+            auto low = bits - available;
+            return (((word << offset) >> offset) << low) | (m_pWords[index + 1] >> (64 - low));
+        }
+
+        bool ReadBit() noexcept
+        {
+            auto index = m_uPosition >> 6;
+            auto offset = static_cast<unsigned>(m_uPosition & 63);
+            ++m_uPosition;
+            return ((m_pWords[index] >> (63 - offset)) & 1) != 0;
+        }
+
+    private:
+        const uint64_t* m_pWords = nullptr;
+        uint64_t m_uPosition = 0;
+    };
+
+    /**
+     * 单个块的顺序解码器
+     */
+    class ChunkDecoder
+    {
+    public:
+        ChunkDecoder(const uint64_t* words, uint64_t firstTimestampMs) noexcept
+            : m_stReader(words), m_uTimestampMs(firstTimestampMs) {}
+
+        void Next(uint64_t& timestampMs, double& value) noexcept
+        {
+            if (m_bFirst)
+            {
+                m_bFirst = false;
+                m_uValueBits = m_stReader.Read(64);
+                timestampMs = m_uTimestampMs;
+                value = BitsToDouble(m_uValueBits);
+                return;
+            }
+
+            // 时间戳二阶差分
+            int64_t deltaOfDelta = 0;
+            if (m_stReader.ReadBit())
+            {
+                if (!m_stReader.ReadBit())
+                    deltaOfDelta = static_cast<int64_t>(m_stReader.Read(7)) - 63;
+                else if (!m_stReader.ReadBit())
+                    deltaOfDelta = static_cast<int64_t>(m_stReader.Read(9)) - 255;
+                else if (!m_stReader.ReadBit())
+                    deltaOfDelta = static_cast<int64_t>(m_stReader.Read(12)) - 2047;
+                else
+                    deltaOfDelta = static_cast<int64_t>(m_stReader.Read(64));
+            }
+            m_iDeltaMs += deltaOfDelta;
+            m_uTimestampMs += static_cast<uint64_t>(m_iDeltaMs);
+            timestampMs = m_uTimestampMs;
+
+            // 值异或
+            if (m_stReader.ReadBit())
+            {
+                if (m_stReader.ReadBit())
+                {
+                    m_uLeadingZeros = static_cast<unsigned>(m_stReader.Read(5));
+                    auto meaningful = static_cast<unsigned>(m_stReader.Read(6));
+                    if (meaningful == 0)
+                        meaningful = 64;
+                    m_uTrailingZeros = 64 - m_uLeadingZeros - meaningful;
+                }
+                auto meaningful = 64 - m_uLeadingZeros - m_uTrailingZeros;
+                m_uValueBits ^= m_stReader.Read(meaningful) << m_uTrailingZeros;
+            }
+            value = BitsToDouble(m_uValueBits);
+        }
+
+    private:
+        BitReader m_stReader;
+        bool m_bFirst = true;
+        uint64_t m_uTimestampMs = 0;
+        int64_t m_iDeltaMs = 0;
+        uint64_t m_uValueBits = 0;
+        unsigned m_uLeadingZeros = 0;
+        unsigned m_uTrailingZeros = 0;
+    };
+}
+
+void CompressedSeries::Append(uint64_t timestampMs, double value)
+{
+    if (m_iFractionBits >= 0)
+        value = std::ldexp(std::nearbyint(std::ldexp(value, m_iFractionBits)), -m_iFractionBits);
+    auto valueBits = DoubleToBits(value);
+    if (m_stChunks.empty() || m_stChunks.back().Count >= kChunkPoints)
+    {
+        // 封存上一块并开始新块，新块的第一个点直接记录
+        if (!m_stChunks.empty())
+            m_stChunks.back().Words.shrink_to_fit();
+
+        auto& chunk = m_stChunks.emplace_back();
+        chunk.FirstTimestampMs = chunk.LastTimestampMs = timestampMs;
+        chunk.Count = 1;
+        chunk.Words.reserve(kInitialChunkWords);
+        WriteBits(chunk, valueBits, 64);
+        m_iLastDeltaMs = 0;
+        m_uLastValueBits = valueBits;
+        m_bHasLastWindow = false;
+    }
+    else
+    {
+        auto& chunk = m_stChunks.back();
+
+        // 时间戳二阶差分
+        auto deltaMs = static_cast<int64_t>(timestampMs - chunk.LastTimestampMs);
+        auto deltaOfDelta = deltaMs - m_iLastDeltaMs;
+        if (deltaOfDelta == 0)
+            WriteBits(chunk, 0b0, 1);
+        else if (deltaOfDelta >= -63 && deltaOfDelta <= 64)
+            WriteBits(chunk, (0b10ull << 7) | static_cast<uint64_t>(deltaOfDelta + 63), 2 + 7);
+        else if (deltaOfDelta >= -255 && deltaOfDelta <= 256)
+            WriteBits(chunk, (0b110ull << 9) | static_cast<uint64_t>(deltaOfDelta + 255), 3 + 9);
+        else if (deltaOfDelta >= -2047 && deltaOfDelta <= 2048)
+            WriteBits(chunk, (0b1110ull << 12) | static_cast<uint64_t>(deltaOfDelta + 2047), 4 + 12);
+        else
+        {
+            WriteBits(chunk, 0b1111, 4);
+            WriteBits(chunk, static_cast<uint64_t>(deltaOfDelta), 64);
+        }
+        m_iLastDeltaMs = deltaMs;
+
+        // 值异或，尽量复用上一次的有效位区间
+        auto xorBits = valueBits ^ m_uLastValueBits;
+        if (xorBits == 0)
+        {
+            WriteBits(chunk, 0b0, 1);
+        }
+        else
+        {
+            auto leading = std::min(kMaxLeadingZeros, static_cast<unsigned>(std::countl_zero(xorBits)));
+            auto trailing = static_cast<unsigned>(std::countr_zero(xorBits));
+            if (m_bHasLastWindow && leading >= m_uLastLeadingZeros && trailing >= m_uLastTrailingZeros)
+            {
+                WriteBits(chunk, 0b10, 2);
+                WriteBits(chunk, xorBits >> m_uLastTrailingZeros, 64 - m_uLastLeadingZeros - m_uLastTrailingZeros);
+            }
+            else
+            {
+                auto meaningful = 64 - leading - trailing;
+                WriteBits(chunk, (0b11ull << 11) | (leading << 6) | (meaningful & 63), 2 + 5 + 6);
+                WriteBits(chunk, xorBits >> trailing, meaningful);
+                m_uLastLeadingZeros = leading;
+                m_uLastTrailingZeros = trailing;
+                m_bHasLastWindow = true;
+            }
+        }
+        m_uLastValueBits = valueBits;
+
+        chunk.LastTimestampMs = timestampMs;
+        ++chunk.Count;
+    }
+    ++m_uSize;
+
+    if (m_bWindowValid)
+    {
+        m_stWindow.push_back(value);
+        m_stWindowTimestamps.push_back(timestampMs);
+        if (m_stWindow.size() > m_uWindowCount)
+        {
+            m_stWindow.erase(m_stWindow.begin());
+            m_stWindowTimestamps.erase(m_stWindowTimestamps.begin());
+        }
+    }
+
+    DropExpired();
+}
+
+void CompressedSeries::Decode(uint64_t fromMs, std::vector<Point>& out) const
+{
+    for (const auto& chunk : m_stChunks)
+    {
+        if (chunk.LastTimestampMs < fromMs)
+            continue;
+
+        ChunkDecoder decoder(chunk.Words.data(), chunk.FirstTimestampMs);
+        Point point;
+        for (uint32_t i = 0; i < chunk.Count; ++i)
+        {
+            decoder.Next(point.TimestampMs, point.Value);
+            if (point.TimestampMs >= fromMs)
+                out.push_back(point);
+        }
+    }
+}
+
+void CompressedSeries::DecodeLast(size_t count, std::vector<double>& out, std::vector<uint64_t>* timestamps) const
+{
+    out.clear();
+    if (timestamps)
+        timestamps->clear();
+    count = std::min(count, m_uSize);
+    if (count == 0)
+        return;
+    out.reserve(count);
+    if (timestamps)
+        timestamps->reserve(count);
+
+    // 找到包含第一个需要的点的块
+    size_t first = m_stChunks.size();
+    size_t covered = 0;
+    while (first > 0 && covered < count)
+        covered += m_stChunks[--first].Count;
+    auto skip = covered - count;
+
+    uint64_t timestampMs = 0;
+    double value = 0;
+    for (auto i = first; i < m_stChunks.size(); ++i)
+    {
+        const auto& chunk = m_stChunks[i];
+        ChunkDecoder decoder(chunk.Words.data(), chunk.FirstTimestampMs);
+        for (uint32_t j = 0; j < chunk.Count; ++j)
+        {
+            decoder.Next(timestampMs, value);
+            if (skip > 0)
+            {
+                --skip;
+                continue;
+            }
+            out.push_back(value);
+            if (timestamps)
+                timestamps->push_back(timestampMs);
+        }
+    }
+}
+
+const std::vector<double>& CompressedSeries::GetWindow(size_t count)
+{
+    if (!m_bWindowValid || count != m_uWindowCount)
+    {
+        DecodeLast(count, m_stWindow, &m_stWindowTimestamps);
+        m_uWindowCount = count;
+        m_bWindowValid = true;
+    }
+    return m_stWindow;
+}
+
+void CompressedSeries::Clear() noexcept
+{
+    m_stChunks.clear();
+    m_uSize = 0;
+    m_stWindow.clear();
+    m_stWindowTimestamps.clear();
+    m_bWindowValid = false;
+}
+
+size_t CompressedSeries::GetMemoryBytes() const noexcept
+{
+    size_t bytes = 0;
+    for (const auto& chunk : m_stChunks)
+        bytes += sizeof(Chunk) + chunk.Words.capacity() * sizeof(uint64_t);
+    return bytes;
+}
+
+void CompressedSeries::WriteBits(Chunk& chunk, uint64_t value, unsigned bits)
+{
+    if (bits < 64)
+        value &= (1ull << bits) - 1;
+
+    auto offset = static_cast<unsigned>(chunk.BitCount & 63);
+    if (offset == 0)
+        chunk.Words.push_back(0);
+    auto available = 64 - offset;
+    if (bits <= available)
+    {
+        chunk.Words.back() |= value << (available - bits);
+    }
+    else
+    {
+        auto low = bits - available;
+        chunk.Words.back() |= value >> low;
+        chunk.Words.push_back(value << (64 - low));
+    }
+    chunk.BitCount += bits;
+}
+
+void CompressedSeries::DropExpired()
+{
+    // 只丢弃已封存的块，整块都超出保留时长时才丢弃
+    auto lastTimestampMs = m_stChunks.back().LastTimestampMs;
+    while (m_stChunks.size() > 1 && m_stChunks.front().LastTimestampMs + m_uRetentionMs < lastTimestampMs)
+    {
+        m_uSize -= m_stChunks.front().Count;
+        m_stChunks.pop_front();
+    }
+
+    // 窗口中包含已丢弃的点时需要重新解码
+    if (m_bWindowValid && m_stWindow.size() > m_uSize)
+        m_bWindowValid = false;
+}
@@ -0,0 +1,277 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <DeviceFilter.hpp>
+
+#include <bitset>
+#include <map>
+
+using namespace std;
+
+namespace
+{
+    constexpr uint8_t kMatchInclude = 1;
+    constexpr uint8_t kMatchExclude = 2;
+    constexpr size_t kMaxStates = 4096;
+
+    using ByteSet = std::bitset<256>;
+
+    /**
+     * 通配符中的一项，Repeat 为 true 时表示 `*`（匹配 Set 中的任意个字节）
+     */
+    struct GlobToken
+    {
+        ByteSet Set;
+        bool Repeat = false;
+    };
+
+    struct GlobPattern
+    {
+        std::vector<GlobToken> Tokens;
+        uint8_t Kind = kMatchInclude;
+    };
+
+    bool ParseGlob(std::string_view glob, GlobPattern& out)
+    {
+        for (size_t i = 0; i < glob.size(); ++i)
+        {
+            GlobToken token;
+            auto ch = static_cast<uint8_t>(glob[i]);
+            if (ch == '*')
+            {
+                token.Set.set();
+                token.Repeat = true;
+                if (!out.Tokens.empty() && out.Tokens.back().Repeat && out.Tokens.back().Set.all())
+                    continue;  // 连续的 * 等价于一个
+            }
+            else if (ch == '?')
+            {
+                token.Set.set();
+            }
+            else if (ch == '[')
+            {
+                auto pos = i + 1;
+                bool negate = pos < glob.size() && (glob[pos] == '!' || glob[pos] == '^');
+                if (negate)
+                    ++pos;
+
+                // 紧跟在开头的 ] 视为普通字符
+                bool first = true;
+                while (pos < glob.size() && (first || glob[pos] != ']'))
+                {
+                    first = false;
+                    auto lo = static_cast<uint8_t>(glob[pos]);
+                    auto hi = lo;
+                    if (pos + 2 < glob.size() && glob[pos + 1] == '-' && glob[pos + 2] != ']')
+                    {
+                        hi = static_cast<uint8_t>(glob[pos + 2]);
+                        pos += 2;
+                    }
+                    if (lo > hi)
+                        return false;
+                    for (unsigned c = lo; c <= hi; ++c)
+                        token.Set.set(c);
+                    ++pos;
+                }
+                if (pos >= glob.size())
+                    return false;  // 缺少 ]
+                if (negate)
+                    token.Set.flip();
+                i = pos;
+            }
+            else
+            {
+                if (ch == '\\')
+                {
+                    if (++i >= glob.size())
+                        return false;
+                    ch = static_cast<uint8_t>(glob[i]);
+                }
+                token.Set.set(ch);
+            }
+            out.Tokens.push_back(token);
+        }
+        return true;
+    }
+
+    std::string_view Trim(std::string_view s) noexcept
+    {
+        while (!s.empty() && (s.front() == ' ' || s.front() == '\t'))
+            s.remove_prefix(1);
+        while (!s.empty() && (s.back() == ' ' || s.back() == '\t'))
+            s.remove_suffix(1);
+        return s;
+    }
+}
+
+Result<void> DeviceFilter::Compile(std::string_view rules) noexcept
+{
+    try
+    {
+        // 解析规则
+        std::vector<GlobPattern> patterns;
+        bool hasInclude = false;
+        while (!rules.empty())
+        {
+            auto comma = rules.find(',');
+            auto rule = Trim(rules.substr(0, comma));
+            rules = comma == std::string_view::npos ? std::string_view {} : rules.substr(comma + 1);
+            if (rule.empty())
+                continue;
+
+            GlobPattern pattern;
+            if (rule.front() == '!')
+            {
+                pattern.Kind = kMatchExclude;
+                rule.remove_prefix(1);
+            }
+            if (!ParseGlob(rule, pattern))
+                return make_error_code(errc::invalid_argument);
+            hasInclude |= pattern.Kind == kMatchInclude;
+            patterns.push_back(std::move(pattern));
+        }
+
+        if (patterns.empty())
+        {
+            *this = {};
+            return {};
+        }
+
+        // 将字节按所属集合的组合归并为等价类
+        std::array<uint16_t, 256> byteClass {};
+        size_t classCount = 1;
+        for (const auto& pattern : patterns)
+        {
+            for (const auto& token : pattern.Tokens)
+            {
+                std::map<std::pair<uint16_t, bool>, uint16_t> split;
+                for (unsigned c = 0; c < 256; ++c)
+                {
+                    auto [it, inserted] = split.emplace(std::make_pair(byteClass[c], token.Set.test(c)),
+                        static_cast<uint16_t>(split.size()));
+                    byteClass[c] = it->second;
+                }
+                classCount = split.size();
+            }
+        }
+        std::vector<uint8_t> representative(classCount);
+        for (unsigned c = 256; c-- > 0;)
+            representative[byteClass[c]] = static_cast<uint8_t>(c);
+
+        // NFA 状态为（规则，位置），位置等于 Tokens.size() 时匹配
+        std::vector<uint32_t> offsets;
+        uint32_t nfaStateCount = 0;
+        for (const auto& pattern : patterns)
+        {
+            offsets.push_back(nfaStateCount);
+            nfaStateCount += static_cast<uint32_t>(pattern.Tokens.size() + 1);
+        }
+        std::vector<std::pair<uint32_t, uint32_t>> nfaStates;  // 全局编号到（规则，位置）
+        for (uint32_t p = 0; p < patterns.size(); ++p)
+        {
+            for (uint32_t i = 0; i <= patterns[p].Tokens.size(); ++i)
+                nfaStates.emplace_back(p, i);
+        }
+
+        // * 可以匹配空串，加入之后的位置
+        auto closure = [&](std::vector<bool>& set) {
+            for (uint32_t id = 0; id < nfaStateCount; ++id)
+            {
+                if (!set[id])
+                    continue;
+                auto [p, i] = nfaStates[id];
+                const auto& tokens = patterns[p].Tokens;
+                while (i < tokens.size() && tokens[i].Repeat)
+                    set[offsets[p] + ++i] = true;
+            }
+        };
+
+        // 子集构造
+        std::map<std::vector<bool>, uint16_t> ids;
+        std::vector<std::vector<bool>> sets;
+        std::vector<uint16_t> transitions;
+        std::vector<uint8_t> accept;
+        auto intern = [&](std::vector<bool>&& set) -> uint16_t {
+            auto it = ids.find(set);
+            if (it != ids.end())
+                return it->second;
+            auto id = static_cast<uint16_t>(sets.size());
+            uint8_t flags = 0;
+            for (uint32_t p = 0; p < patterns.size(); ++p)
+            {
+                if (set[offsets[p] + patterns[p].Tokens.size()])
+                    flags |= patterns[p].Kind;
+            }
+            ids.emplace(set, id);
+            sets.push_back(std::move(set));
+            accept.push_back(flags);
+            transitions.resize(sets.size() * classCount, 0);
+            return id;
+        };
+
+        intern(std::vector<bool>(nfaStateCount, false));  // 死状态
+        {
+            std::vector<bool> start(nfaStateCount, false);
+            for (auto offset : offsets)
+                start[offset] = true;
+            closure(start);
+            intern(std::move(start));
+        }
+        for (size_t state = 1; state < sets.size(); ++state)
+        {
+            if (sets.size() > kMaxStates)
+                return make_error_code(errc::value_too_large);
+
+            for (size_t cls = 0; cls < classCount; ++cls)
+            {
+                auto c = representative[cls];
+                std::vector<bool> next(nfaStateCount, false);
+                for (uint32_t id = 0; id < nfaStateCount; ++id)
+                {
+                    if (!sets[state][id])
+                        continue;
+                    auto [p, i] = nfaStates[id];
+                    const auto& tokens = patterns[p].Tokens;
+                    if (i < tokens.size() && tokens[i].Set.test(c))
+                        next[tokens[i].Repeat ? id : id + 1] = true;
+                }
+                closure(next);
+                auto target = intern(std::move(next));
+                transitions[state * classCount + cls] = target;
+            }
+        }
+
+        for (unsigned c = 0; c < 256; ++c)
+            m_stByteClass[c] = static_cast<uint8_t>(byteClass[c]);
+        m_uClassCount = classCount;
+        m_stTransitions = std::move(transitions);
+        m_stAccept = std::move(accept);
+        m_bHasInclude = hasInclude;
+    }
+    catch (...)
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+    return {};
+}
+
+bool DeviceFilter::Accept(std::string_view name) const noexcept
+{
+    if (m_stAccept.empty())
+        return true;
+
+    size_t state = 1;
+    for (auto ch : name)
+    {
+        state = m_stTransitions[state * m_uClassCount + m_stByteClass[static_cast<uint8_t>(ch)]];
+        if (state == 0)
+            break;
+    }
+
+    auto flags = m_stAccept[state];
+    if (flags & kMatchExclude)
+        return false;
+    return !m_bHasInclude || (flags & kMatchInclude);
+}
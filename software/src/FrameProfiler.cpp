@@ -0,0 +1,154 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <FrameProfiler.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <SelfMetrics.hpp>
+
+using namespace std;
+
+const char* FrameProfiler::GetPhaseName(Phase phase) noexcept
+{
+    switch (phase)
+    {
+        case Phase::PollEvents:
+            return "Poll";
+        case Phase::NewFrame:
+            return "NewFrame";
+        case Phase::OnFrame:
+            return "OnFrame";
+        case Phase::ImGuiRender:
+            return "Render";
+        case Phase::RenderDrawData:
+            return "Draw";
+        case Phase::Present:
+            return "Present";
+        case Phase::Frame:
+            return "Frame";
+        case Phase::SampleFetch:
+            return "Fetch";
+        case Phase::SampleParse:
+            return "Parse";
+        case Phase::SampleCompute:
+            return "Compute";
+        case Phase::LatencyFirstByte:
+            return "TTFB";
+        case Phase::LatencyParse:
+            return "Recv+Parse";
+        case Phase::LatencyEnqueue:
+            return "Enqueue";
+        case Phase::LatencyQueue:
+            return "Queue";
+        case Phase::LatencyDisplay:
+            return "Display";
+        case Phase::LatencyTotal:
+            return "Total";
+        case Phase::FirstValidFrame:
+            return "FirstFrame";
+        default:
+            assert(false);
+            return "";
+    }
+}
+
+void FrameProfiler::Record(Phase phase, double seconds) noexcept
+{
+    assert(phase < Phase::Count);
+    auto& ring = m_stRings[static_cast<size_t>(phase)];
+    ring.Samples[ring.Head] = seconds;
+    ring.Head = (ring.Head + 1) % kRingSize;
+    ring.Count = std::min(ring.Count + 1, kRingSize);
+
+    SelfMetrics::ObservePhase(phase, seconds);
+}
+
+FrameProfiler::Stats FrameProfiler::GetStats(Phase phase) const noexcept
+{
+    assert(phase < Phase::Count);
+    const auto& ring = m_stRings[static_cast<size_t>(phase)];
+
+    Stats ret;
+    ret.Count = ring.Count;
+    if (ring.Count == 0)
+        return ret;
+
+    ret.Last = ring.Samples[(ring.Head + kRingSize - 1) % kRingSize];
+
+    // 环未填满时有效样本位于 [0, Count)，填满后为整个数组，两种情况都只需要排序前 Count 个
+    std::array<double, kRingSize> sorted;
+    std::copy_n(ring.Samples.begin(), ring.Count, sorted.begin());
+    auto begin = sorted.begin();
+    auto end = sorted.begin() + static_cast<ptrdiff_t>(ring.Count);
+
+    auto p50 = begin + static_cast<ptrdiff_t>((ring.Count - 1) / 2);
+    std::nth_element(begin, p50, end);
+    ret.P50 = *p50;
+
+    auto p99 = begin + static_cast<ptrdiff_t>((ring.Count - 1) * 99 / 100);
+    std::nth_element(begin, p99, end);
+    ret.P99 = *p99;
+
+    ret.Max = *std::max_element(p99, end);
+    return ret;
+}
+
+void FrameProfiler::Reset() noexcept
+{
+    for (auto& ring : m_stRings)
+    {
+        ring.Head = 0;
+        ring.Count = 0;
+    }
+}
+
+void FrameProfiler::DrawOverlay(ImFont* font, OverlayPage page) const noexcept
+{
+    auto first = page == OverlayPage::Frame ? Phase::PollEvents : Phase::LatencyFirstByte;
+    auto last = page == OverlayPage::Frame ? Phase::SampleCompute : Phase::FirstValidFrame;
+
+    const auto& io = ImGui::GetIO();
+    ImGui::SetNextWindowPos({io.DisplaySize.x, 0}, ImGuiCond_Always, {1.f, 0.f});
+    ImGui::SetNextWindowBgAlpha(0.8f);
+    if (font)
+        ImGui::PushFont(font);
+    if (ImGui::Begin("##profiler", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+        ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav |
+        ImGuiWindowFlags_NoInputs))
+    {
+        if (ImGui::BeginTable("##profiler_table", 4, ImGuiTableFlags_SizingFixedFit))
+        {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::TextUnformatted("ms");
+            ImGui::TableSetColumnIndex(1);
+            ImGui::TextUnformatted("p50");
+            ImGui::TableSetColumnIndex(2);
+            ImGui::TextUnformatted("p99");
+            ImGui::TableSetColumnIndex(3);
+            ImGui::TextUnformatted("max");
+
+            for (auto i = static_cast<size_t>(first); i <= static_cast<size_t>(last); ++i)
+            {
+                auto phase = static_cast<Phase>(i);
+                auto stats = GetStats(phase);
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::TextUnformatted(GetPhaseName(phase));
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%.2f", stats.P50 * 1000.);
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%.2f", stats.P99 * 1000.);
+                ImGui::TableSetColumnIndex(3);
+                ImGui::Text("%.2f", stats.Max * 1000.);
+            }
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+    if (font)
+        ImGui::PopFont();
+}
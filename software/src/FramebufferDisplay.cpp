@@ -0,0 +1,346 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <FramebufferDisplay.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <linux/fb.h>
+#include <SDL.h>
+#include <spdlog/spdlog.h>
+#include <AppBase.hpp>
+#include <SelfMetrics.hpp>
+#include <SignalHandler.hpp>
+
+using namespace std;
+
+namespace
+{
+    constexpr int kTileSize = 16;  // 脏块边长（像素）
+    constexpr size_t kMaxDirtyRects = 8;  // 超过该数量时继续合并矩形
+    constexpr size_t kMaxMergeCandidates = 64;  // 超过该数量时直接取包围盒
+
+    size_t Area(int w, int h) noexcept
+    {
+        return static_cast<size_t>(w) * static_cast<size_t>(h);
+    }
+}
+
+FramebufferDisplay::~FramebufferDisplay() noexcept
+{
+    if (m_bBackendInitialized)
+    {
+        ImGuiSoftwareBackend::Shutdown();
+        ImGui::GetIO().BackendPlatformName = nullptr;
+    }
+
+    if (m_pMapped)
+        ::munmap(m_pMapped, m_uMappedSize);
+    if (m_iFd >= 0)
+        ::close(m_iFd);
+}
+
+Result<void> FramebufferDisplay::Initialize(const AppBaseConfig& config) noexcept
+{
+    auto path = config.DisplayDevice.empty() ? std::string{"/dev/fb1"} : config.DisplayDevice;
+    if (auto ret = Open(path, config.InitialWidth, config.InitialHeight); !ret)
+        return ret;
+
+    m_stBackBuffer.resize(static_cast<size_t>(m_iWidth) * m_iHeight);
+    m_stFrontBuffer.resize(m_stBackBuffer.size());
+    m_bFrontBufferValid = false;
+    m_stDirtyTiles.resize(static_cast<size_t>((m_iWidth + kTileSize - 1) / kTileSize) *
+        ((m_iHeight + kTileSize - 1) / kTileSize));
+    m_stBackBufferTarget.Pixels = m_stBackBuffer.data();
+    m_stBackBufferTarget.Width = m_iWidth;
+    m_stBackBufferTarget.Height = m_iHeight;
+    m_stBackBufferTarget.Stride = m_iWidth;
+
+    SignalHandler::Install();
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendPlatformName = "fbdev";
+    ImGuiSoftwareBackend::Initialize();
+    m_bBackendInitialized = true;
+    return {};
+}
+
+void FramebufferDisplay::PollEvents(bool& exitRequest) noexcept
+{
+    if (SignalHandler::ConsumeExitRequest())
+        exitRequest = true;
+}
+
+ImTextureID FramebufferDisplay::CreateTexture(int width, int height) noexcept
+{
+    return ImGuiSoftwareBackend::CreateTexture(width, height);
+}
+
+void FramebufferDisplay::UpdateTexture(ImTextureID texture, int x, int y, int width, int height, const uint32_t* pixels) noexcept
+{
+    ImGuiSoftwareBackend::UpdateTexture(texture, x, y, width, height, pixels);
+}
+
+void FramebufferDisplay::DestroyTexture(ImTextureID texture) noexcept
+{
+    ImGuiSoftwareBackend::DestroyTexture(texture);
+}
+
+void FramebufferDisplay::NewFrame() noexcept
+{
+    static Uint64 kFrequency = ::SDL_GetPerformanceFrequency();
+
+    ImGuiSoftwareBackend::NewFrame();
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(static_cast<float>(m_iWidth), static_cast<float>(m_iHeight));
+    io.DisplayFramebufferScale = ImVec2(1.f, 1.f);
+
+    auto currentTick = ::SDL_GetPerformanceCounter();
+    io.DeltaTime = m_uLastTick > 0 ? static_cast<float>(static_cast<double>(currentTick - m_uLastTick) / static_cast<double>(kFrequency)) :
+        static_cast<float>(1.0f / 60.0f);
+    m_uLastTick = currentTick;
+}
+
+void FramebufferDisplay::Render(ImDrawData* drawData) noexcept
+{
+    ImGuiSoftwareBackend::Clear(m_stBackBufferTarget);
+    ImGuiSoftwareBackend::RenderDrawData(drawData, m_stBackBufferTarget);
+}
+
+void FramebufferDisplay::Present() noexcept
+{
+    // SPI 总线带宽是帧率瓶颈，只写入与上一帧不同的区域
+    CollectDirtyRects();
+
+    size_t bytes = 0;
+    for (const auto& rc : m_stDirtyRects)
+    {
+        auto rowBytes = static_cast<size_t>(rc.Width) * sizeof(uint16_t);
+        for (int y = rc.Y; y < rc.Y + rc.Height; ++y)
+        {
+            ::memcpy(m_pMapped + m_uLineLength * y + static_cast<size_t>(rc.X) * sizeof(uint16_t),
+                m_stBackBuffer.data() + static_cast<size_t>(y) * m_iWidth + rc.X, rowBytes);
+        }
+        bytes += rowBytes * rc.Height;
+    }
+    m_uLastPresentBytes = bytes;
+    SelfMetrics::ObservePresent(bytes);
+    spdlog::trace("Framebuffer present: {} rect(s), {} bytes", m_stDirtyRects.size(), bytes);
+
+    // 每帧都会整体重绘后备缓冲区，因此直接交换即可保留本帧作为下一次比较的基准
+    m_stBackBuffer.swap(m_stFrontBuffer);
+    m_stBackBufferTarget.Pixels = m_stBackBuffer.data();
+    m_bFrontBufferValid = true;
+}
+
+Result<void> FramebufferDisplay::Open(const std::string& path, int width, int height) noexcept
+{
+    int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0 && errno == ENOENT && path.rfind("/dev/", 0) != 0)
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);  // 假 framebuffer 文件不存在时创建
+    if (fd < 0)
+    {
+        spdlog::error("Failed to open framebuffer {}: {}", path, ::strerror(errno));
+        return error_code(errno, system_category());
+    }
+
+    ::fb_var_screeninfo varInfo {};
+    ::fb_fix_screeninfo fixInfo {};
+    if (::ioctl(fd, FBIOGET_VSCREENINFO, &varInfo) == 0 && ::ioctl(fd, FBIOGET_FSCREENINFO, &fixInfo) == 0)
+    {
+        if (varInfo.bits_per_pixel != 16)
+        {
+            spdlog::error("Framebuffer {} is {}bpp, only RGB565 is supported", path, varInfo.bits_per_pixel);
+            ::close(fd);
+            return make_error_code(errc::not_supported);
+        }
+
+        m_iWidth = static_cast<int>(varInfo.xres);
+        m_iHeight = static_cast<int>(varInfo.yres);
+        m_uLineLength = fixInfo.line_length;
+        m_uMappedSize = fixInfo.smem_len;
+    }
+    else
+    {
+        // 普通文件，作为假 framebuffer 使用
+        m_iWidth = width;
+        m_iHeight = height;
+        m_uLineLength = static_cast<size_t>(width) * sizeof(uint16_t);
+        m_uMappedSize = m_uLineLength * height;
+
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < m_uMappedSize)
+        {
+            if (::ftruncate(fd, static_cast<off_t>(m_uMappedSize)) != 0)
+            {
+                spdlog::error("Failed to resize fake framebuffer {}: {}", path, ::strerror(errno));
+                ::close(fd);
+                return error_code(errno, system_category());
+            }
+        }
+    }
+
+    auto* mapped = ::mmap(nullptr, m_uMappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED)
+    {
+        spdlog::error("Failed to mmap framebuffer {}: {}", path, ::strerror(errno));
+        ::close(fd);
+        return error_code(errno, system_category());
+    }
+
+    spdlog::info("Using framebuffer {}, {}x{}, line length {}", path, m_iWidth, m_iHeight, m_uLineLength);
+    m_iFd = fd;
+    m_pMapped = static_cast<uint8_t*>(mapped);
+    return {};
+}
+
+void FramebufferDisplay::CollectDirtyRects() noexcept
+{
+    m_stDirtyRects.clear();
+    if (!m_bFrontBufferValid)
+    {
+        m_stDirtyRects.push_back({0, 0, m_iWidth, m_iHeight});
+        return;
+    }
+
+    const int tilesX = (m_iWidth + kTileSize - 1) / kTileSize;
+    const int tilesY = (m_iHeight + kTileSize - 1) / kTileSize;
+    const auto* back = m_stBackBuffer.data();
+    const auto* front = m_stFrontBuffer.data();
+
+    // 标记脏块：整行相同时跳过该行，否则逐块比较
+    std::fill(m_stDirtyTiles.begin(), m_stDirtyTiles.end(), 0);
+    for (int ty = 0; ty < tilesY; ++ty)
+    {
+        auto* tiles = m_stDirtyTiles.data() + static_cast<size_t>(ty) * tilesX;
+        int y1 = std::min(m_iHeight, (ty + 1) * kTileSize);
+        for (int y = ty * kTileSize; y < y1; ++y)
+        {
+            auto offset = static_cast<size_t>(y) * m_iWidth;
+            if (::memcmp(back + offset, front + offset, m_iWidth * sizeof(uint16_t)) == 0)
+                continue;
+
+            for (int tx = 0; tx < tilesX; ++tx)
+            {
+                if (tiles[tx])
+                    continue;
+                int x0 = tx * kTileSize;
+                int w = std::min(m_iWidth - x0, kTileSize);
+                if (::memcmp(back + offset + x0, front + offset + x0, w * sizeof(uint16_t)) != 0)
+                    tiles[tx] = 1;
+            }
+        }
+    }
+
+    // 合并：同一块行内连续的脏块合并为一段，上下相邻且横向范围相同的段再合并为矩形（以块为单位）
+    // 界面按行布局且标签、单位不变，因此变化的数值与曲线通常会合并为少数几个竖直条带
+    m_stOpenRects.clear();
+    for (int ty = 0; ty < tilesY; ++ty)
+    {
+        const auto* tiles = m_stDirtyTiles.data() + static_cast<size_t>(ty) * tilesX;
+        size_t openCount = m_stOpenRects.size();
+        size_t extended = 0;  // 本行延续的矩形被移动到列表前部
+        for (int tx = 0; tx < tilesX;)
+        {
+            if (!tiles[tx])
+            {
+                ++tx;
+                continue;
+            }
+            int start = tx;
+            while (tx < tilesX && tiles[tx])
+                ++tx;
+
+            bool merged = false;
+            for (size_t i = extended; i < openCount; ++i)
+            {
+                auto& rc = m_stOpenRects[i];
+                if (rc.X == start && rc.Width == tx - start)
+                {
+                    ++rc.Height;
+                    std::swap(rc, m_stOpenRects[extended++]);
+                    merged = true;
+                    break;
+                }
+            }
+            if (!merged)
+                m_stOpenRects.push_back({start, ty, tx - start, 1});
+        }
+
+        // 未延续的矩形已经闭合
+        for (size_t i = extended; i < openCount; ++i)
+            m_stDirtyRects.push_back(m_stOpenRects[i]);
+        m_stOpenRects.erase(m_stOpenRects.begin() + static_cast<ptrdiff_t>(extended),
+            m_stOpenRects.begin() + static_cast<ptrdiff_t>(openCount));
+    }
+    m_stDirtyRects.insert(m_stDirtyRects.end(), m_stOpenRects.begin(), m_stOpenRects.end());
+
+    // 矩形过多时贪心合并浪费面积最小的一对，避免逐个小矩形写入带来的开销
+    if (m_stDirtyRects.size() > kMaxMergeCandidates)
+    {
+        DirtyRect bounds = m_stDirtyRects.front();
+        for (const auto& rc : m_stDirtyRects)
+        {
+            int x1 = std::max(bounds.X + bounds.Width, rc.X + rc.Width);
+            int y1 = std::max(bounds.Y + bounds.Height, rc.Y + rc.Height);
+            bounds.X = std::min(bounds.X, rc.X);
+            bounds.Y = std::min(bounds.Y, rc.Y);
+            bounds.Width = x1 - bounds.X;
+            bounds.Height = y1 - bounds.Y;
+        }
+        m_stDirtyRects.clear();
+        m_stDirtyRects.push_back(bounds);
+    }
+    while (m_stDirtyRects.size() > kMaxDirtyRects)
+    {
+        size_t bestI = 0, bestJ = 1;
+        size_t bestWaste = std::numeric_limits<size_t>::max();
+        DirtyRect bestUnion;
+        for (size_t i = 0; i < m_stDirtyRects.size(); ++i)
+        {
+            const auto& a = m_stDirtyRects[i];
+            for (size_t j = i + 1; j < m_stDirtyRects.size(); ++j)
+            {
+                const auto& b = m_stDirtyRects[j];
+                DirtyRect u;
+                u.X = std::min(a.X, b.X);
+                u.Y = std::min(a.Y, b.Y);
+                u.Width = std::max(a.X + a.Width, b.X + b.Width) - u.X;
+                u.Height = std::max(a.Y + a.Height, b.Y + b.Height) - u.Y;
+                auto area = Area(u.Width, u.Height);
+                auto used = Area(a.Width, a.Height) + Area(b.Width, b.Height);
+                auto waste = area > used ? area - used : 0;
+                if (waste < bestWaste)
+                {
+                    bestWaste = waste;
+                    bestI = i;
+                    bestJ = j;
+                    bestUnion = u;
+                }
+            }
+        }
+        m_stDirtyRects[bestI] = bestUnion;
+        m_stDirtyRects.erase(m_stDirtyRects.begin() + static_cast<ptrdiff_t>(bestJ));
+    }
+
+    // 块坐标转换为像素坐标，并裁剪到屏幕边缘
+    for (auto& rc : m_stDirtyRects)
+    {
+        int x0 = rc.X * kTileSize;
+        int y0 = rc.Y * kTileSize;
+        rc.Width = std::min(m_iWidth, (rc.X + rc.Width) * kTileSize) - x0;
+        rc.Height = std::min(m_iHeight, (rc.Y + rc.Height) * kTileSize) - y0;
+        rc.X = x0;
+        rc.Y = y0;
+    }
+}
@@ -0,0 +1,235 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <HeadlessDisplay.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <SDL.h>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include <FrameProfiler.hpp>
+#include <PngWriter.hpp>
+#include <SignalHandler.hpp>
+
+using namespace std;
+
+namespace
+{
+    nlohmann::json SummarizeMs(std::vector<double> samples)
+    {
+        nlohmann::json ret = nlohmann::json::object();
+        if (samples.empty())
+            return ret;
+
+        std::sort(samples.begin(), samples.end());
+        double sum = 0;
+        for (auto s : samples)
+            sum += s;
+        auto percentile = [&](double p) {
+            return samples[std::min(samples.size() - 1, static_cast<size_t>(p * static_cast<double>(samples.size())))] * 1000.;
+        };
+
+        ret["mean"] = sum / static_cast<double>(samples.size()) * 1000.;
+        ret["p50"] = percentile(0.5);
+        ret["p90"] = percentile(0.9);
+        ret["p99"] = percentile(0.99);
+        ret["max"] = samples.back() * 1000.;
+        return ret;
+    }
+}
+
+HeadlessDisplay::~HeadlessDisplay() noexcept
+{
+    if (m_bBackendInitialized)
+    {
+        ImGuiSoftwareBackend::Shutdown();
+        ImGui::GetIO().BackendPlatformName = nullptr;
+    }
+}
+
+Result<void> HeadlessDisplay::Initialize(const AppBaseConfig& config) noexcept
+{
+    m_stConfig = config.Headless;
+    m_iWidth = config.InitialWidth;
+    m_iHeight = config.InitialHeight;
+    m_stPixels.resize(static_cast<size_t>(m_iWidth) * m_iHeight);
+    m_stTarget.Pixels = m_stPixels.data();
+    m_stTarget.Width = m_iWidth;
+    m_stTarget.Height = m_iHeight;
+    m_stTarget.Stride = m_iWidth;
+
+    if (!m_stConfig.DumpDirectory.empty())
+    {
+        std::error_code ec;
+        std::filesystem::create_directories(m_stConfig.DumpDirectory, ec);
+        if (ec)
+        {
+            spdlog::error("Failed to create dump directory {}: {}", m_stConfig.DumpDirectory, ec.message());
+            return ec;
+        }
+    }
+
+    m_stFrameTimes.reserve(static_cast<size_t>(std::max(0, m_stConfig.Frames)));
+    m_stRasterTimes.reserve(static_cast<size_t>(std::max(0, m_stConfig.Frames)));
+
+    SignalHandler::Install();
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendPlatformName = "headless";
+    ImGuiSoftwareBackend::Initialize();
+    m_bBackendInitialized = true;
+
+    spdlog::info("Headless rendering {} frame(s) at {}x{}", m_stConfig.Frames, m_iWidth, m_iHeight);
+    return {};
+}
+
+void HeadlessDisplay::PollEvents(bool& exitRequest) noexcept
+{
+    if (SignalHandler::ConsumeExitRequest())
+        exitRequest = true;
+
+    if (!m_bFinished && (exitRequest || m_iFrameIndex >= m_stConfig.Frames))
+    {
+        m_bFinished = true;
+        if (!m_stConfig.DumpDirectory.empty() && m_iFrameIndex > 0)
+            DumpFrame("last");
+        WriteStats();
+    }
+    if (m_bFinished)
+        exitRequest = true;
+}
+
+ImTextureID HeadlessDisplay::CreateTexture(int width, int height) noexcept
+{
+    return ImGuiSoftwareBackend::CreateTexture(width, height);
+}
+
+void HeadlessDisplay::UpdateTexture(ImTextureID texture, int x, int y, int width, int height, const uint32_t* pixels) noexcept
+{
+    ImGuiSoftwareBackend::UpdateTexture(texture, x, y, width, height, pixels);
+}
+
+void HeadlessDisplay::DestroyTexture(ImTextureID texture) noexcept
+{
+    ImGuiSoftwareBackend::DestroyTexture(texture);
+}
+
+void HeadlessDisplay::NewFrame() noexcept
+{
+    static Uint64 kFrequency = ::SDL_GetPerformanceFrequency();
+
+    ImGuiSoftwareBackend::NewFrame();
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(static_cast<float>(m_iWidth), static_cast<float>(m_iHeight));
+    io.DisplayFramebufferScale = ImVec2(1.f, 1.f);
+
+    auto currentTick = ::SDL_GetPerformanceCounter();
+    if (m_stConfig.FixedDeltaTime > 0)
+    {
+        io.DeltaTime = static_cast<float>(m_stConfig.FixedDeltaTime);
+    }
+    else
+    {
+        io.DeltaTime = m_uLastTick > 0 ? static_cast<float>(static_cast<double>(currentTick - m_uLastTick) / static_cast<double>(kFrequency)) :
+            static_cast<float>(1.0f / 60.0f);
+    }
+    m_uLastTick = currentTick;
+    m_uFrameStartTick = currentTick;
+}
+
+void HeadlessDisplay::Render(ImDrawData* drawData) noexcept
+{
+    static Uint64 kFrequency = ::SDL_GetPerformanceFrequency();
+
+    auto start = ::SDL_GetPerformanceCounter();
+    ImGuiSoftwareBackend::Clear(m_stTarget);
+    ImGuiSoftwareBackend::RenderDrawData(drawData, m_stTarget);
+    auto end = ::SDL_GetPerformanceCounter();
+
+    if (m_iFrameIndex >= m_stConfig.WarmupFrames)
+    {
+        m_stRasterTimes.push_back(static_cast<double>(end - start) / static_cast<double>(kFrequency));
+        m_dTotalVertices += drawData->TotalVtxCount;
+        m_dTotalIndices += drawData->TotalIdxCount;
+    }
+}
+
+void HeadlessDisplay::Present() noexcept
+{
+    static Uint64 kFrequency = ::SDL_GetPerformanceFrequency();
+
+    // 帧耗时从 NewFrame 开始计算，包含 OnFrame、ImGui::Render 与光栅化
+    auto end = ::SDL_GetPerformanceCounter();
+    if (m_iFrameIndex >= m_stConfig.WarmupFrames)
+        m_stFrameTimes.push_back(static_cast<double>(end - m_uFrameStartTick) / static_cast<double>(kFrequency));
+
+    if (!m_stConfig.DumpDirectory.empty() && m_stConfig.DumpEvery > 0 && m_iFrameIndex % m_stConfig.DumpEvery == 0)
+        DumpFrame(fmt::format("frame_{:05d}", m_iFrameIndex));
+    ++m_iFrameIndex;
+}
+
+void HeadlessDisplay::DumpFrame(const std::string& name) noexcept
+{
+    auto path = (std::filesystem::path(m_stConfig.DumpDirectory) / (name + ".png")).string();
+    if (auto ret = PngWriter::WriteRGB565(path, m_stTarget.Pixels, m_stTarget.Width, m_stTarget.Height, m_stTarget.Stride); !ret)
+        spdlog::error("Failed to dump frame to {}", path);
+}
+
+void HeadlessDisplay::WriteStats() noexcept
+{
+    if (m_stConfig.StatsPath.empty())
+        return;
+
+    try
+    {
+        auto measured = static_cast<double>(std::max<size_t>(1, m_stRasterTimes.size()));
+        nlohmann::json stats;
+        stats["backend"] = "software";
+        stats["width"] = m_iWidth;
+        stats["height"] = m_iHeight;
+        stats["frames"] = m_iFrameIndex;
+        stats["warmup_frames"] = m_stConfig.WarmupFrames;
+        stats["frame_ms"] = SummarizeMs(m_stFrameTimes);
+        stats["raster_ms"] = SummarizeMs(m_stRasterTimes);
+        stats["vertices_per_frame"] = m_dTotalVertices / measured;
+        stats["indices_per_frame"] = m_dTotalIndices / measured;
+
+        // 各阶段最近样本的统计，包括采样线程的抓取/解析/计算
+        if (m_pProfiler)
+        {
+            auto& phases = stats["phases"] = nlohmann::json::object();
+            for (size_t i = 0; i < static_cast<size_t>(FrameProfiler::Phase::Count); ++i)
+            {
+                auto phase = static_cast<FrameProfiler::Phase>(i);
+                auto phaseStats = m_pProfiler->GetStats(phase);
+                auto& item = phases[FrameProfiler::GetPhaseName(phase)];
+                item["samples"] = phaseStats.Count;
+                item["p50"] = phaseStats.P50 * 1000.;
+                item["p99"] = phaseStats.P99 * 1000.;
+                item["max"] = phaseStats.Max * 1000.;
+            }
+        }
+
+        if (m_stConfig.StatsPath == "-")
+        {
+            std::cout << stats.dump(2) << std::endl;
+        }
+        else
+        {
+            std::ofstream out(m_stConfig.StatsPath);
+            out << stats.dump(2) << std::endl;
+            if (!out)
+                spdlog::error("Failed to write stats to {}", m_stConfig.StatsPath);
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        spdlog::error("Failed to write stats: {}", ex.what());
+    }
+}
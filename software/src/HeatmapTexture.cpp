@@ -0,0 +1,122 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <HeatmapTexture.hpp>
+
+#include <algorithm>
+#include <array>
+#include <IDisplay.hpp>
+
+using namespace std;
+
+namespace
+{
+    constexpr size_t kColorCount = 256;
+
+    /**
+     * 深蓝 - 紫 - 红 - 橙 - 浅黄，数值为 0 时接近背景色
+     */
+    const std::array<uint32_t, kColorCount>& GetColorTable() noexcept
+    {
+        static const auto kTable = []() {
+            static const float kStops[][3] = {
+                { 10, 10, 40 },
+                { 90, 30, 130 },
+                { 200, 50, 90 },
+                { 250, 140, 30 },
+                { 255, 240, 160 },
+            };
+            constexpr size_t kStopCount = std::size(kStops);
+
+            std::array<uint32_t, kColorCount> table {};
+            for (size_t i = 0; i < kColorCount; ++i)
+            {
+                auto t = static_cast<float>(i) / static_cast<float>(kColorCount - 1) * static_cast<float>(kStopCount - 1);
+                auto index = std::min(static_cast<size_t>(t), kStopCount - 2);
+                auto f = t - static_cast<float>(index);
+                const auto* a = kStops[index];
+                const auto* b = kStops[index + 1];
+                table[i] = IM_COL32(static_cast<int>(a[0] + (b[0] - a[0]) * f), static_cast<int>(a[1] + (b[1] - a[1]) * f),
+                    static_cast<int>(a[2] + (b[2] - a[2]) * f), 255);
+            }
+            return table;
+        }();
+        return kTable;
+    }
+}
+
+HeatmapTexture::~HeatmapTexture() noexcept
+{
+    Release();
+}
+
+void HeatmapTexture::Reset(IDisplay* display, size_t columns, size_t rows) noexcept
+{
+    Release();
+
+    m_pDisplay = display;
+    m_uColumns = columns;
+    m_uRows = rows;
+    m_uHead = 0;
+    if (!m_pDisplay || columns == 0 || rows == 0)
+        return;
+
+    try
+    {
+        m_stColumnPixels.resize(rows);
+    }
+    catch (...)
+    {
+        return;
+    }
+    m_uTexture = m_pDisplay->CreateTexture(static_cast<int>(columns), static_cast<int>(rows));
+}
+
+void HeatmapTexture::Release() noexcept
+{
+    if (m_pDisplay && m_uTexture != 0)
+        m_pDisplay->DestroyTexture(m_uTexture);
+    m_uTexture = 0;
+}
+
+void HeatmapTexture::PushColumn(const double* values, size_t count, double maxValue) noexcept
+{
+    if (m_uTexture == 0)
+        return;
+
+    // 第 i 行对应实体 [i × count / rows, (i + 1) × count / rows)，行数多于实体数时重复显示
+    const auto& table = GetColorTable();
+    auto scale = maxValue > 0 ? static_cast<double>(kColorCount - 1) / maxValue : 0.;
+    for (size_t row = 0; row < m_uRows; ++row)
+    {
+        auto begin = row * count / m_uRows;
+        auto end = std::max(begin + 1, (row + 1) * count / m_uRows);
+        double value = 0;
+        for (auto i = begin; i < end && i < count; ++i)
+            value = std::max(value, values[i]);
+        auto index = static_cast<size_t>(std::clamp(value * scale, 0., static_cast<double>(kColorCount - 1)));
+        m_stColumnPixels[row] = table[index];
+    }
+
+    m_pDisplay->UpdateTexture(m_uTexture, static_cast<int>(m_uHead), 0, 1, static_cast<int>(m_uRows), m_stColumnPixels.data());
+    m_uHead = (m_uHead + 1) % m_uColumns;
+}
+
+void HeatmapTexture::Draw(const ImVec2& size) const noexcept
+{
+    auto pos = ImGui::GetCursorScreenPos();
+    ImGui::Dummy(size);
+    if (m_uTexture == 0)
+        return;
+
+    // [head, columns) 为较旧的部分，绘制在左侧；[0, head) 为较新的部分
+    auto* drawList = ImGui::GetWindowDrawList();
+    auto split = static_cast<float>(m_uHead) / static_cast<float>(m_uColumns);
+    auto splitX = pos.x + size.x * (1.f - split);
+    if (split < 1.f)
+        drawList->AddImage(m_uTexture, pos, { splitX, pos.y + size.y }, { split, 0 }, { 1, 1 });
+    if (split > 0.f)
+        drawList->AddImage(m_uTexture, { splitX, pos.y }, { pos.x + size.x, pos.y + size.y }, { 0, 0 }, { split, 1 });
+}
@@ -0,0 +1,394 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <HistoryFile.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <spdlog/spdlog.h>
+
+using namespace std;
+
+static_assert(std::endian::native == std::endian::little, "History file is stored in little endian");
+
+namespace
+{
+    constexpr uint64_t kSyncInterval = 60;  // 每写入这么多个槽位刷新一次到存储设备
+    constexpr size_t kTierCount = static_cast<size_t>(RollupSeries::Tier::Count);
+
+    struct FileHeader
+    {
+        uint32_t Magic;
+        uint32_t Version;
+        uint32_t SeriesCount;
+        uint32_t Capacity;
+    };
+
+    /**
+     * 读写槽位的 Seq 与降采样桶的 StartMs，两者为 0 时记录无效
+     */
+    uint64_t LoadStamp(const uint64_t& stamp) noexcept
+    {
+        return std::atomic_ref<uint64_t>(const_cast<uint64_t&>(stamp)).load(memory_order_acquire);
+    }
+
+    void StoreStamp(uint64_t& stamp, uint64_t value) noexcept
+    {
+        std::atomic_ref<uint64_t>(stamp).store(value, memory_order_release);
+    }
+
+    /**
+     * 每个序列的降采样桶数量
+     */
+    size_t GetRollupRecordCount() noexcept
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < kTierCount; ++i)
+            count += RollupSeries::GetTierCapacity(static_cast<RollupSeries::Tier>(i));
+        return count;
+    }
+}
+
+HistoryFile::~HistoryFile() noexcept
+{
+    Close();
+}
+
+Result<void> HistoryFile::Open(const std::string& path, const std::vector<std::string>& seriesNames, size_t capacity) noexcept
+{
+    Close();
+
+    if (seriesNames.empty() || capacity == 0)
+        return make_error_code(errc::invalid_argument);
+    for (const auto& name : seriesNames)
+    {
+        if (name.size() >= HistoryFileFormat::kMaxNameLength)
+            return make_error_code(errc::invalid_argument);
+    }
+
+    try
+    {
+        m_stSeriesNames = seriesNames;
+    }
+    catch (...)
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+    m_uCapacity = capacity;
+    m_uSlotsOffset = sizeof(FileHeader) + seriesNames.size() * HistoryFileFormat::kMaxNameLength;
+    m_uSlotStride = sizeof(SlotHeader) + seriesNames.size() * sizeof(double);
+    m_uRollupsOffset = m_uSlotsOffset + m_uSlotStride * capacity;
+    m_uMappedSize = m_uRollupsOffset + seriesNames.size() * GetRollupRecordCount() * sizeof(RollupRecord);
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        spdlog::error("Failed to open history file {}: {}", path, ::strerror(errno));
+        return error_code(errno, system_category());
+    }
+
+    struct stat st {};
+    bool sizeMatched = ::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) == m_uMappedSize;
+    if (!sizeMatched && ::ftruncate(fd, static_cast<off_t>(m_uMappedSize)) != 0)
+    {
+        spdlog::error("Failed to resize history file {}: {}", path, ::strerror(errno));
+        ::close(fd);
+        return error_code(errno, system_category());
+    }
+
+    // 先只读映射，第一次写入时再开放写权限
+    auto* mapped = ::mmap(nullptr, m_uMappedSize, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapped == MAP_FAILED)
+    {
+        spdlog::error("Failed to mmap history file {}: {}", path, ::strerror(errno));
+        ::close(fd);
+        return error_code(errno, system_category());
+    }
+    m_iFd = fd;
+    m_pMapped = static_cast<uint8_t*>(mapped);
+
+    // 校验布局
+    const auto* header = reinterpret_cast<const FileHeader*>(m_pMapped);
+    m_bLayoutValid = sizeMatched && header->Magic == HistoryFileFormat::kMagic && header->Version == HistoryFileFormat::kVersion &&
+        header->SeriesCount == seriesNames.size() && header->Capacity == capacity;
+    for (size_t i = 0; m_bLayoutValid && i < seriesNames.size(); ++i)
+    {
+        const auto* name = reinterpret_cast<const char*>(m_pMapped + sizeof(FileHeader) + i * HistoryFileFormat::kMaxNameLength);
+        m_bLayoutValid = ::strncmp(name, seriesNames[i].c_str(), HistoryFileFormat::kMaxNameLength) == 0;
+    }
+
+    m_uLastSeq = 0;
+    if (m_bLayoutValid)
+    {
+        for (size_t i = 0; i < m_uCapacity; ++i)
+            m_uLastSeq = std::max(m_uLastSeq, LoadStamp(GetSlot(i)->Seq));
+        spdlog::info("Opened history file {}, last sequence {}", path, m_uLastSeq);
+    }
+    else
+    {
+        spdlog::info("History file {} is empty or has a different layout, it will be reinitialized", path);
+    }
+    return {};
+}
+
+void HistoryFile::Close() noexcept
+{
+    if (m_stSyncThread.joinable())
+        m_stSyncThread.join();
+    if (m_pMapped && m_bWritable && ::fdatasync(m_iFd) != 0)
+        spdlog::warn("Failed to sync history file: {}", ::strerror(errno));
+    if (m_pMapped)
+    {
+        ::munmap(m_pMapped, m_uMappedSize);
+        m_pMapped = nullptr;
+    }
+    if (m_iFd >= 0)
+    {
+        ::close(m_iFd);
+        m_iFd = -1;
+    }
+    m_bLayoutValid = false;
+    m_bWritable = false;
+    m_bWriteFailed = false;
+}
+
+size_t HistoryFile::Restore(uint64_t nowMs, double intervalMs, const std::vector<MetricsHistory*>& histories,
+    const std::vector<CompressedSeries*>& series) const noexcept
+{
+    if (!m_pMapped || !m_bLayoutValid || intervalMs <= 0)
+        return 0;
+
+    // 只接受 (LastSeq - Capacity, LastSeq] 范围内且位于对应槽位的记录
+    struct Point
+    {
+        uint64_t Seq;
+        size_t SlotIndex;
+        size_t Position;
+    };
+    std::vector<Point> points;
+    auto windowMs = static_cast<double>(m_uCapacity) * intervalMs;
+    try
+    {
+        points.reserve(m_uCapacity);
+        for (size_t i = 0; i < m_uCapacity; ++i)
+        {
+            const auto* slot = GetSlot(i);
+            auto seq = LoadStamp(slot->Seq);
+            if (seq == 0 || seq > m_uLastSeq || seq + m_uCapacity <= m_uLastSeq || (seq - 1) % m_uCapacity != i)
+                continue;
+
+            // 丢弃过旧或来自未来的点，按与当前时间的距离对齐到采样位置
+            if (slot->TimestampMs > nowMs)
+                continue;
+            auto ageMs = static_cast<double>(nowMs - slot->TimestampMs);
+            if (ageMs >= windowMs)
+                continue;
+            auto age = std::min(m_uCapacity - 1, static_cast<size_t>(std::lround(ageMs / intervalMs)));
+            points.push_back({ seq, i, m_uCapacity - 1 - age });
+        }
+        std::sort(points.begin(), points.end(), [](const Point& a, const Point& b) { return a.Seq < b.Seq; });
+
+        std::vector<double> aligned(m_uCapacity);
+        for (size_t s = 0; s < m_stSeriesNames.size() && s < histories.size(); ++s)
+        {
+            auto* history = histories[s];
+            if (!history)
+                continue;
+            std::fill(aligned.begin(), aligned.end(), 0.);
+            for (const auto& point : points)
+                aligned[point.Position] = GetSlotValues(GetSlot(point.SlotIndex))[s];  // 同一位置上较新的点覆盖较旧的点
+            history->Assign(aligned.data(), aligned.size());
+        }
+
+        // 长期历史按时间戳追加，采样中断的时段由绘制时的时间戳识别
+        for (size_t s = 0; s < m_stSeriesNames.size() && s < series.size(); ++s)
+        {
+            if (!series[s])
+                continue;
+            for (const auto& point : points)
+            {
+                auto* slot = GetSlot(point.SlotIndex);
+                series[s]->Append(slot->TimestampMs, GetSlotValues(slot)[s]);
+            }
+        }
+    }
+    catch (...)
+    {
+        return 0;
+    }
+    return points.size();
+}
+
+size_t HistoryFile::RestoreRollups(uint64_t nowMs, const std::vector<RollupSeries*>& rollups) const noexcept
+{
+    if (!m_pMapped || !m_bLayoutValid)
+        return 0;
+
+    size_t restored = 0;
+    try
+    {
+        std::vector<RollupSeries::Bucket> buckets;
+        for (size_t s = 0; s < m_stSeriesNames.size() && s < rollups.size(); ++s)
+        {
+            if (!rollups[s])
+                continue;
+            for (size_t t = 0; t < kTierCount; ++t)
+            {
+                auto tier = static_cast<RollupSeries::Tier>(t);
+                auto widthMs = RollupSeries::GetTierWidthMs(tier);
+                auto capacity = RollupSeries::GetTierCapacity(tier);
+                const auto* records = GetRollupRecords(s, tier);
+
+                // 只接受位于对应位置、在保留时长内且不晚于当前时间的桶
+                buckets.clear();
+                for (size_t i = 0; i < capacity; ++i)
+                {
+                    const auto& record = records[i];
+                    auto startMs = LoadStamp(record.StartMs);
+                    if (startMs == 0 || startMs % widthMs != 0 || (startMs / widthMs) % capacity != i || startMs > nowMs ||
+                        startMs + capacity * widthMs <= nowMs || record.Count == 0)
+                    {
+                        continue;
+                    }
+                    buckets.push_back({ startMs, record.Min, record.Max, record.Sum, record.Last,
+                        static_cast<uint32_t>(record.Count) });
+                }
+                std::sort(buckets.begin(), buckets.end(), [](const auto& a, const auto& b) { return a.StartMs < b.StartMs; });
+                rollups[s]->Assign(tier, buckets.data(), buckets.size());
+                restored += buckets.size();
+            }
+        }
+    }
+    catch (...)
+    {
+        return 0;
+    }
+    return restored;
+}
+
+void HistoryFile::Append(uint64_t timestampMs, const double* values) noexcept
+{
+    if (!m_pMapped || !PrepareWrite())
+        return;
+
+    auto seq = m_uLastSeq + 1;
+    auto* slot = GetSlot((seq - 1) % m_uCapacity);
+    StoreStamp(slot->Seq, 0);
+    slot->TimestampMs = timestampMs;
+    ::memcpy(GetSlotValues(slot), values, m_stSeriesNames.size() * sizeof(double));
+    StoreStamp(slot->Seq, seq);
+    m_uLastSeq = seq;
+
+    if (seq % kSyncInterval == 0)
+        RequestSync();
+}
+
+void HistoryFile::StoreRollups(const RollupSeries* const* rollups) noexcept
+{
+    if (!m_pMapped || !PrepareWrite())
+        return;
+
+    for (size_t s = 0; s < m_stSeriesNames.size(); ++s)
+    {
+        for (size_t t = 0; t < kTierCount; ++t)
+        {
+            auto tier = static_cast<RollupSeries::Tier>(t);
+            auto count = rollups[s]->GetBucketCount(tier);
+            if (count == 0)
+                continue;
+
+            const auto& bucket = rollups[s]->GetBucket(tier, count - 1);
+            auto index = (bucket.StartMs / RollupSeries::GetTierWidthMs(tier)) % RollupSeries::GetTierCapacity(tier);
+            auto& record = GetRollupRecords(s, tier)[index];
+            StoreStamp(record.StartMs, 0);
+            record.Min = bucket.Min;
+            record.Max = bucket.Max;
+            record.Sum = bucket.Sum;
+            record.Last = bucket.Last;
+            record.Count = bucket.Count;
+            StoreStamp(record.StartMs, bucket.StartMs);
+        }
+    }
+}
+
+void HistoryFile::RequestSync() noexcept
+{
+    // 上一次刷新尚未完成时跳过，下一个周期再刷新
+    if (m_bSyncing.exchange(true))
+        return;
+    if (m_stSyncThread.joinable())
+        m_stSyncThread.join();
+
+    // 在后台线程中刷新，SD 卡上 fdatasync 可能耗时数十毫秒，不阻塞 UI 线程
+    try
+    {
+        m_stSyncThread = thread([this]() {
+            if (::fdatasync(m_iFd) != 0)
+                spdlog::warn("Failed to sync history file: {}", ::strerror(errno));
+            m_bSyncing = false;
+        });
+    }
+    catch (const std::system_error& ex)
+    {
+        spdlog::warn("Failed to start history file sync: {}", ex.what());
+        m_bSyncing = false;
+    }
+}
+
+HistoryFile::SlotHeader* HistoryFile::GetSlot(size_t index) const noexcept
+{
+    return reinterpret_cast<SlotHeader*>(m_pMapped + m_uSlotsOffset + index * m_uSlotStride);
+}
+
+HistoryFile::RollupRecord* HistoryFile::GetRollupRecords(size_t series, RollupSeries::Tier tier) const noexcept
+{
+    auto index = series * GetRollupRecordCount();
+    for (size_t t = 0; t < static_cast<size_t>(tier); ++t)
+        index += RollupSeries::GetTierCapacity(static_cast<RollupSeries::Tier>(t));
+    return reinterpret_cast<RollupRecord*>(m_pMapped + m_uRollupsOffset) + index;
+}
+
+bool HistoryFile::PrepareWrite() noexcept
+{
+    if (m_bWritable)
+        return true;
+    if (m_bWriteFailed)
+        return false;
+
+    if (::mprotect(m_pMapped, m_uMappedSize, PROT_READ | PROT_WRITE) != 0)
+    {
+        spdlog::error("Failed to make history file writable: {}", ::strerror(errno));
+        m_bWriteFailed = true;
+        return false;
+    }
+    m_bWritable = true;
+
+    if (!m_bLayoutValid)
+    {
+        // 重新初始化：先清空槽位再写入文件头
+        ::memset(m_pMapped, 0, m_uMappedSize);
+        for (size_t i = 0; i < m_stSeriesNames.size(); ++i)
+        {
+            auto* name = reinterpret_cast<char*>(m_pMapped + sizeof(FileHeader) + i * HistoryFileFormat::kMaxNameLength);
+            ::memcpy(name, m_stSeriesNames[i].data(), m_stSeriesNames[i].size());
+        }
+        auto* header = reinterpret_cast<FileHeader*>(m_pMapped);
+        header->SeriesCount = static_cast<uint32_t>(m_stSeriesNames.size());
+        header->Capacity = static_cast<uint32_t>(m_uCapacity);
+        header->Version = HistoryFileFormat::kVersion;
+        std::atomic_ref<uint32_t>(header->Magic).store(HistoryFileFormat::kMagic, memory_order_release);
+        m_bLayoutValid = true;
+        m_uLastSeq = 0;
+    }
+    return true;
+}
@@ -0,0 +1,382 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <ImGuiGLES2Backend.hpp>
+
+#include <vector>
+
+#include <GLES2/gl2.h>
+#include <spdlog/spdlog.h>
+
+using namespace std;
+
+namespace
+{
+    const char* kVertexShader =
+        "#version 100\n"
+        "uniform mat4 ProjMtx;\n"
+        "attribute vec2 Position;\n"
+        "attribute vec2 UV;\n"
+        "attribute vec4 Color;\n"
+        "varying vec2 Frag_UV;\n"
+        "varying vec4 Frag_Color;\n"
+        "void main()\n"
+        "{\n"
+        "    Frag_UV = UV;\n"
+        "    Frag_Color = Color;\n"
+        "    gl_Position = ProjMtx * vec4(Position.xy, 0, 1);\n"
+        "}\n";
+
+    const char* kFragmentShader =
+        "#version 100\n"
+        "precision mediump float;\n"
+        "uniform sampler2D Texture;\n"
+        "uniform float AlphaTexture;\n"
+        "varying vec2 Frag_UV;\n"
+        "varying vec4 Frag_Color;\n"
+        "void main()\n"
+        "{\n"
+        "    vec4 texel = texture2D(Texture, Frag_UV.st);\n"
+        "    gl_FragColor = Frag_Color * mix(texel, vec4(1.0, 1.0, 1.0, texel.a), AlphaTexture);\n"
+        "}\n";
+
+    struct ImGUIGLES2Data
+    {
+        GLuint FontTexture = 0;
+        GLuint ShaderHandle = 0;
+        GLint AttribLocationTex = 0;
+        GLint AttribLocationProjMtx = 0;
+        GLint AttribLocationAlphaTexture = 0;
+        GLuint AttribLocationVtxPos = 0;
+        GLuint AttribLocationVtxUV = 0;
+        GLuint AttribLocationVtxColor = 0;
+        GLuint VboHandle = 0;
+        GLuint ElementsHandle = 0;
+    };
+
+    ImGUIGLES2Data* GetBackendData() noexcept
+    {
+        return ImGui::GetCurrentContext() ? static_cast<ImGUIGLES2Data*>(ImGui::GetIO().BackendRendererUserData) : nullptr;
+    }
+
+    GLuint CompileShader(GLenum type, const char* source) noexcept
+    {
+        GLuint shader = ::glCreateShader(type);
+        ::glShaderSource(shader, 1, &source, nullptr);
+        ::glCompileShader(shader);
+
+        GLint status = 0;
+        ::glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+        if (status == GL_FALSE)
+        {
+            char log[512] = {};
+            ::glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+            spdlog::error("Failed to compile shader: {}", log);
+        }
+        return shader;
+    }
+
+    void SetupRenderState(ImDrawData* drawData, int fbWidth, int fbHeight) noexcept
+    {
+        auto* bd = GetBackendData();
+
+        // Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled
+        ::glEnable(GL_BLEND);
+        ::glBlendEquation(GL_FUNC_ADD);
+        ::glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        ::glDisable(GL_CULL_FACE);
+        ::glDisable(GL_DEPTH_TEST);
+        ::glDisable(GL_STENCIL_TEST);
+        ::glEnable(GL_SCISSOR_TEST);
+
+        // Setup viewport, orthographic projection matrix
+        // Our visible imgui space lies from draw_data->DisplayPos (top left) to draw_data->DisplayPos+data_data->DisplaySize (bottom right).
+        ::glViewport(0, 0, static_cast<GLsizei>(fbWidth), static_cast<GLsizei>(fbHeight));
+        float l = drawData->DisplayPos.x;
+        float r = drawData->DisplayPos.x + drawData->DisplaySize.x;
+        float t = drawData->DisplayPos.y;
+        float b = drawData->DisplayPos.y + drawData->DisplaySize.y;
+        const float orthoProjection[4][4] = {
+            { 2.0f / (r - l), 0.0f, 0.0f, 0.0f },
+            { 0.0f, 2.0f / (t - b), 0.0f, 0.0f },
+            { 0.0f, 0.0f, -1.0f, 0.0f },
+            { (r + l) / (l - r), (t + b) / (b - t), 0.0f, 1.0f },
+        };
+        ::glUseProgram(bd->ShaderHandle);
+        ::glUniform1i(bd->AttribLocationTex, 0);
+        ::glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &orthoProjection[0][0]);
+
+        // Bind vertex/index buffers and setup attributes for ImDrawVert
+        ::glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle);
+        ::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle);
+        ::glEnableVertexAttribArray(bd->AttribLocationVtxPos);
+        ::glEnableVertexAttribArray(bd->AttribLocationVtxUV);
+        ::glEnableVertexAttribArray(bd->AttribLocationVtxColor);
+        ::glVertexAttribPointer(bd->AttribLocationVtxPos, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert),
+            reinterpret_cast<const GLvoid*>(offsetof(ImDrawVert, pos)));
+        ::glVertexAttribPointer(bd->AttribLocationVtxUV, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert),
+            reinterpret_cast<const GLvoid*>(offsetof(ImDrawVert, uv)));
+        ::glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert),
+            reinterpret_cast<const GLvoid*>(offsetof(ImDrawVert, col)));
+    }
+}
+
+void ImGuiGLES2Backend::Initialize()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IMGUI_CHECKVERSION();
+    IM_ASSERT(io.BackendRendererUserData == nullptr && "Already initialized a renderer backend!");
+
+    // Setup backend capabilities flags
+    auto* bd = IM_NEW(ImGUIGLES2Data)();
+    io.BackendRendererUserData = (void*)bd;
+    io.BackendRendererName = "imgui_impl_gles2";
+}
+
+void ImGuiGLES2Backend::Shutdown() noexcept
+{
+    auto* bd = GetBackendData();
+    IM_ASSERT(bd != nullptr && "No renderer backend to shutdown, or already shutdown?");
+    ImGuiIO& io = ImGui::GetIO();
+
+    DestroyDeviceObjects();
+    io.BackendRendererName = nullptr;
+    io.BackendRendererUserData = nullptr;
+    IM_DELETE(bd);
+}
+
+void ImGuiGLES2Backend::NewFrame() noexcept
+{
+    auto* bd = GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGuiGLES2Backend::Initialize()?");
+
+    if (!bd->ShaderHandle)
+        CreateDeviceObjects();
+    if (!bd->FontTexture)
+        CreateFontsTexture();
+}
+
+void ImGuiGLES2Backend::RenderDrawData(ImDrawData* drawData) noexcept
+{
+    auto* bd = GetBackendData();
+    int fbWidth = static_cast<int>(drawData->DisplaySize.x * drawData->FramebufferScale.x);
+    int fbHeight = static_cast<int>(drawData->DisplaySize.y * drawData->FramebufferScale.y);
+    if (fbWidth <= 0 || fbHeight <= 0)
+        return;
+
+    // 我们独占整个上下文，因此不需要备份/恢复 GL 状态
+    SetupRenderState(drawData, fbWidth, fbHeight);
+
+    // Will project scissor/clipping rectangles into framebuffer space
+    ImVec2 clip_off = drawData->DisplayPos;         // (0,0) unless using multi-viewports
+    ImVec2 clip_scale = drawData->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+
+    // Render command lists
+    for (int n = 0; n < drawData->CmdListsCount; n++)
+    {
+        const ImDrawList* drawList = drawData->CmdLists[n];
+
+        // Upload vertex/index buffers
+        ::glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(drawList->VtxBuffer.Size) * static_cast<int>(sizeof(ImDrawVert)),
+            static_cast<const GLvoid*>(drawList->VtxBuffer.Data), GL_STREAM_DRAW);
+        ::glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(drawList->IdxBuffer.Size) * static_cast<int>(sizeof(ImDrawIdx)),
+            static_cast<const GLvoid*>(drawList->IdxBuffer.Data), GL_STREAM_DRAW);
+
+        for (int i = 0; i < drawList->CmdBuffer.Size; i++)
+        {
+            const ImDrawCmd* pcmd = &drawList->CmdBuffer[i];
+            if (pcmd->UserCallback)
+            {
+                // User callback, registered via ImDrawList::AddCallback()
+                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                    SetupRenderState(drawData, fbWidth, fbHeight);
+                else
+                    pcmd->UserCallback(drawList, pcmd);
+            }
+            else
+            {
+                // Project scissor/clipping rectangles into framebuffer space
+                ImVec2 clipMin((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
+                ImVec2 clipMax((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+                if (clipMax.x <= clipMin.x || clipMax.y <= clipMin.y)
+                    continue;
+
+                // Apply scissor/clipping rectangle (Y is inverted in OpenGL)
+                ::glScissor(static_cast<int>(clipMin.x), static_cast<int>(static_cast<float>(fbHeight) - clipMax.y),
+                    static_cast<int>(clipMax.x - clipMin.x), static_cast<int>(clipMax.y - clipMin.y));
+
+                // Bind texture, Draw
+                // 字体图集为 GL_ALPHA 纹理，采样结果的 RGB 为 0，需要在着色器中替换为白色
+                auto texture = static_cast<GLuint>(static_cast<intptr_t>(pcmd->GetTexID()));
+                ::glUniform1f(bd->AttribLocationAlphaTexture, texture == bd->FontTexture ? 1.f : 0.f);
+                ::glBindTexture(GL_TEXTURE_2D, texture);
+                ::glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(pcmd->ElemCount), sizeof(ImDrawIdx) == 2 ?
+                    GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, reinterpret_cast<const GLvoid*>(pcmd->IdxOffset * sizeof(ImDrawIdx)));
+            }
+        }
+    }
+}
+
+void ImGuiGLES2Backend::Clear(int width, int height) noexcept
+{
+    static ImVec4 kClearColor = ImVec4(0.f, 0.f, 0.f, 1.f);
+
+    ::glDisable(GL_SCISSOR_TEST);
+    ::glViewport(0, 0, width, height);
+    ::glClearColor(kClearColor.x * kClearColor.w, kClearColor.y * kClearColor.w, kClearColor.z * kClearColor.w, kClearColor.w);
+    ::glClear(GL_COLOR_BUFFER_BIT);
+}
+
+void ImGuiGLES2Backend::CreateFontsTexture() noexcept
+{
+    // Build texture atlas
+    ImGuiIO& io = ImGui::GetIO();
+    auto* bd = GetBackendData();
+    unsigned char* pixels;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+
+    // Upload texture to graphics system
+    GLint lastTexture;
+    ::glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTexture);
+    ::glGenTextures(1, &bd->FontTexture);
+    ::glBindTexture(GL_TEXTURE_2D, bd->FontTexture);
+    ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    ::glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    ::glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, width, height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels);
+
+    // Store our identifier
+    io.Fonts->SetTexID(static_cast<ImTextureID>(static_cast<intptr_t>(bd->FontTexture)));
+
+    // Restore state
+    ::glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(lastTexture));
+}
+
+void ImGuiGLES2Backend::DestroyFontsTexture() noexcept
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto* bd = GetBackendData();
+    if (bd->FontTexture)
+    {
+        ::glDeleteTextures(1, &bd->FontTexture);
+        io.Fonts->SetTexID(0);
+        bd->FontTexture = 0;
+    }
+}
+
+ImTextureID ImGuiGLES2Backend::CreateTexture(int width, int height) noexcept
+{
+    if (width <= 0 || height <= 0)
+        return 0;
+
+    GLint lastTexture;
+    ::glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTexture);
+    GLuint texture = 0;
+    ::glGenTextures(1, &texture);
+    ::glBindTexture(GL_TEXTURE_2D, texture);
+    ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    ::glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    try
+    {
+        std::vector<uint32_t> zeros(static_cast<size_t>(width) * height, 0);
+        ::glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, zeros.data());
+    }
+    catch (...)
+    {
+        ::glDeleteTextures(1, &texture);
+        texture = 0;
+    }
+    ::glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(lastTexture));
+    return static_cast<ImTextureID>(static_cast<intptr_t>(texture));
+}
+
+void ImGuiGLES2Backend::UpdateTexture(ImTextureID texture, int x, int y, int width, int height, const uint32_t* pixels) noexcept
+{
+    if (texture == 0 || width <= 0 || height <= 0)
+        return;
+
+    GLint lastTexture;
+    ::glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTexture);
+    ::glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(static_cast<intptr_t>(texture)));
+    ::glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    ::glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    ::glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(lastTexture));
+}
+
+void ImGuiGLES2Backend::DestroyTexture(ImTextureID texture) noexcept
+{
+    auto handle = static_cast<GLuint>(static_cast<intptr_t>(texture));
+    if (handle != 0)
+        ::glDeleteTextures(1, &handle);
+}
+
+bool ImGuiGLES2Backend::CreateDeviceObjects() noexcept
+{
+    auto* bd = GetBackendData();
+
+    GLuint vertHandle = CompileShader(GL_VERTEX_SHADER, kVertexShader);
+    GLuint fragHandle = CompileShader(GL_FRAGMENT_SHADER, kFragmentShader);
+
+    bd->ShaderHandle = ::glCreateProgram();
+    ::glAttachShader(bd->ShaderHandle, vertHandle);
+    ::glAttachShader(bd->ShaderHandle, fragHandle);
+    ::glLinkProgram(bd->ShaderHandle);
+
+    GLint status = 0;
+    ::glGetProgramiv(bd->ShaderHandle, GL_LINK_STATUS, &status);
+    if (status == GL_FALSE)
+    {
+        char log[512] = {};
+        ::glGetProgramInfoLog(bd->ShaderHandle, sizeof(log), nullptr, log);
+        spdlog::error("Failed to link shader program: {}", log);
+    }
+
+    ::glDetachShader(bd->ShaderHandle, vertHandle);
+    ::glDetachShader(bd->ShaderHandle, fragHandle);
+    ::glDeleteShader(vertHandle);
+    ::glDeleteShader(fragHandle);
+
+    bd->AttribLocationTex = ::glGetUniformLocation(bd->ShaderHandle, "Texture");
+    bd->AttribLocationProjMtx = ::glGetUniformLocation(bd->ShaderHandle, "ProjMtx");
+    bd->AttribLocationAlphaTexture = ::glGetUniformLocation(bd->ShaderHandle, "AlphaTexture");
+    bd->AttribLocationVtxPos = static_cast<GLuint>(::glGetAttribLocation(bd->ShaderHandle, "Position"));
+    bd->AttribLocationVtxUV = static_cast<GLuint>(::glGetAttribLocation(bd->ShaderHandle, "UV"));
+    bd->AttribLocationVtxColor = static_cast<GLuint>(::glGetAttribLocation(bd->ShaderHandle, "Color"));
+
+    // Create buffers
+    ::glGenBuffers(1, &bd->VboHandle);
+    ::glGenBuffers(1, &bd->ElementsHandle);
+
+    CreateFontsTexture();
+    return status != GL_FALSE;
+}
+
+void ImGuiGLES2Backend::DestroyDeviceObjects() noexcept
+{
+    auto* bd = GetBackendData();
+    if (bd->VboHandle)
+    {
+        ::glDeleteBuffers(1, &bd->VboHandle);
+        bd->VboHandle = 0;
+    }
+    if (bd->ElementsHandle)
+    {
+        ::glDeleteBuffers(1, &bd->ElementsHandle);
+        bd->ElementsHandle = 0;
+    }
+    if (bd->ShaderHandle)
+    {
+        ::glDeleteProgram(bd->ShaderHandle);
+        bd->ShaderHandle = 0;
+    }
+    DestroyFontsTexture();
+}
@@ -5,6 +5,8 @@
  */
 #include <ImGuiOpenGLBackend.hpp>
 
+#include <vector>
+
 #if defined(_WIN32) && !defined(APIENTRY)
 #define APIENTRY __stdcall                  // It is customary to use APIENTRY for OpenGL function pointer declarations on all platforms.  Additionally, the Windows OpenGL header needs APIENTRY.
 #endif
@@ -216,12 +218,13 @@ void ImGuiOpenGLBackend::CreateFontsTexture() noexcept
     auto* bd = GetBackendData();
     unsigned char* pixels;
     int width = 0, height = 0;
-    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // Load as RGBA 32-bit (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders. If your ImTextureId represent a higher-level concept than just a GL texture id, consider calling GetTexDataAsAlpha8() instead to save on GPU memory.
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);  // 单通道上传，GL_MODULATE 下颜色取自顶点、透明度取自纹理
 
     // Upload texture to graphics system
     // (Bilinear sampling is required by default. Set 'io.Fonts->Flags |= ImFontAtlasFlags_NoBakedLines' or 'style.AntiAliasedLinesUseTex = false' to allow point/nearest sampling)
-    GLint lastTexture;
+    GLint lastTexture, lastUnpackAlignment;
     ::glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTexture);
+    ::glGetIntegerv(GL_UNPACK_ALIGNMENT, &lastUnpackAlignment);
     ::glGenTextures(1, &bd->FontTexture);
     ::glBindTexture(GL_TEXTURE_2D, bd->FontTexture);
     ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -229,7 +232,9 @@ void ImGuiOpenGLBackend::CreateFontsTexture() noexcept
     ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
     ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
     ::glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-    ::glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    ::glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    ::glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, width, height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels);
+    ::glPixelStorei(GL_UNPACK_ALIGNMENT, lastUnpackAlignment);
 
     // Store our identifier
     io.Fonts->SetTexID(static_cast<ImTextureID>(static_cast<intptr_t>(bd->FontTexture)));
@@ -250,6 +255,55 @@ void ImGuiOpenGLBackend::DestroyFontsTexture() noexcept
     }
 }
 
+ImTextureID ImGuiOpenGLBackend::CreateTexture(int width, int height) noexcept
+{
+    if (width <= 0 || height <= 0)
+        return 0;
+
+    GLint lastTexture;
+    ::glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTexture);
+    GLuint texture = 0;
+    ::glGenTextures(1, &texture);
+    ::glBindTexture(GL_TEXTURE_2D, texture);
+    ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    ::glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    ::glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    try
+    {
+        std::vector<uint32_t> zeros(static_cast<size_t>(width) * height, 0);
+        ::glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, zeros.data());
+    }
+    catch (...)
+    {
+        ::glDeleteTextures(1, &texture);
+        texture = 0;
+    }
+    ::glBindTexture(GL_TEXTURE_2D, lastTexture);
+    return static_cast<ImTextureID>(static_cast<intptr_t>(texture));
+}
+
+void ImGuiOpenGLBackend::UpdateTexture(ImTextureID texture, int x, int y, int width, int height, const uint32_t* pixels) noexcept
+{
+    if (texture == 0 || width <= 0 || height <= 0)
+        return;
+
+    GLint lastTexture;
+    ::glGetIntegerv(GL_TEXTURE_BINDING_2D, &lastTexture);
+    ::glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(static_cast<intptr_t>(texture)));
+    ::glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    ::glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    ::glBindTexture(GL_TEXTURE_2D, lastTexture);
+}
+
+void ImGuiOpenGLBackend::DestroyTexture(ImTextureID texture) noexcept
+{
+    auto handle = static_cast<GLuint>(static_cast<intptr_t>(texture));
+    if (handle != 0)
+        ::glDeleteTextures(1, &handle);
+}
+
 void ImGuiOpenGLBackend::CreateDeviceObjects() noexcept
 {
     CreateFontsTexture();
@@ -0,0 +1,514 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <ImGuiSoftwareBackend.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define PSM_SOFTWARE_BACKEND_NEON 1
+#endif
+
+using namespace std;
+
+namespace
+{
+    struct ImGUISoftwareData
+    {
+        ImGuiSoftwareBackend::Texture* FontTexture = nullptr;
+        std::vector<ImDrawVert> VertexBuffer;
+        std::vector<uint8_t> CoverageBuffer;
+    };
+
+    /**
+     * 像素坐标系下的裁剪矩形（右/下边界不含）
+     */
+    struct ClipRect
+    {
+        int MinX = 0;
+        int MinY = 0;
+        int MaxX = 0;
+        int MaxY = 0;
+    };
+
+    struct Color
+    {
+        uint32_t R = 0;
+        uint32_t G = 0;
+        uint32_t B = 0;
+        uint32_t A = 0;
+    };
+
+    ImGUISoftwareData* GetBackendData() noexcept
+    {
+        return ImGui::GetCurrentContext() ? static_cast<ImGUISoftwareData*>(ImGui::GetIO().BackendRendererUserData) : nullptr;
+    }
+
+    const ImGuiSoftwareBackend::Texture* ToTexture(ImTextureID id) noexcept
+    {
+        return reinterpret_cast<const ImGuiSoftwareBackend::Texture*>(static_cast<intptr_t>(id));
+    }
+
+    Color UnpackColor(ImU32 col) noexcept
+    {
+        return {
+            (col >> IM_COL32_R_SHIFT) & 0xFF,
+            (col >> IM_COL32_G_SHIFT) & 0xFF,
+            (col >> IM_COL32_B_SHIFT) & 0xFF,
+            (col >> IM_COL32_A_SHIFT) & 0xFF,
+        };
+    }
+
+    uint32_t Div255(uint32_t x) noexcept
+    {
+        x += 128;
+        return (x + (x >> 8)) >> 8;
+    }
+
+    uint16_t PackRGB565(uint32_t r, uint32_t g, uint32_t b) noexcept
+    {
+        return static_cast<uint16_t>(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+    }
+
+    uint16_t Blend565(uint16_t dst, uint32_t r, uint32_t g, uint32_t b, uint32_t a) noexcept
+    {
+        if (a == 0)
+            return dst;
+        if (a == 255)
+            return PackRGB565(r, g, b);
+
+        uint32_t dr = (dst >> 11) & 0x1F;
+        uint32_t dg = (dst >> 5) & 0x3F;
+        uint32_t db = dst & 0x1F;
+        dr = (dr << 3) | (dr >> 2);
+        dg = (dg << 2) | (dg >> 4);
+        db = (db << 3) | (db >> 2);
+
+        auto ia = 255 - a;
+        return PackRGB565(Div255(r * a + dr * ia), Div255(g * a + dg * ia), Div255(b * a + db * ia));
+    }
+
+    /**
+     * 以常量颜色混合一段像素
+     * @param coverage 每像素覆盖率（0~255），为空时视为全覆盖
+     */
+    void BlendSpan(uint16_t* dst, const uint8_t* coverage, int count, const Color& color) noexcept
+    {
+        if (!coverage && color.A == 255)
+        {
+            std::fill_n(dst, count, PackRGB565(color.R, color.G, color.B));
+            return;
+        }
+        if (!coverage && color.A == 0)
+            return;
+
+        int i = 0;
+#ifdef PSM_SOFTWARE_BACKEND_NEON
+        const uint16x8_t kMask5 = vdupq_n_u16(0x1F);
+        const uint16x8_t kMask6 = vdupq_n_u16(0x3F);
+        const uint16x8_t k255 = vdupq_n_u16(255);
+        const uint16x8_t k128 = vdupq_n_u16(128);
+        const uint16x8_t sr = vdupq_n_u16(static_cast<uint16_t>(color.R));
+        const uint16x8_t sg = vdupq_n_u16(static_cast<uint16_t>(color.G));
+        const uint16x8_t sb = vdupq_n_u16(static_cast<uint16_t>(color.B));
+        const uint8x8_t sa8 = vdup_n_u8(static_cast<uint8_t>(color.A));
+
+        auto div255 = [&](uint16x8_t x) {
+            auto t = vaddq_u16(x, k128);
+            return vshrq_n_u16(vaddq_u16(t, vshrq_n_u16(t, 8)), 8);
+        };
+
+        for (; i + 8 <= count; i += 8)
+        {
+            uint16x8_t a;
+            if (coverage)
+                a = div255(vmull_u8(vld1_u8(coverage + i), sa8));
+            else
+                a = vmovl_u8(sa8);
+            uint16x8_t ia = vsubq_u16(k255, a);
+
+            // 解包 RGB565 并扩展到 8 位
+            uint16x8_t d = vld1q_u16(dst + i);
+            uint16x8_t dr = vshrq_n_u16(d, 11);
+            uint16x8_t dg = vandq_u16(vshrq_n_u16(d, 5), kMask6);
+            uint16x8_t db = vandq_u16(d, kMask5);
+            dr = vorrq_u16(vshlq_n_u16(dr, 3), vshrq_n_u16(dr, 2));
+            dg = vorrq_u16(vshlq_n_u16(dg, 2), vshrq_n_u16(dg, 4));
+            db = vorrq_u16(vshlq_n_u16(db, 3), vshrq_n_u16(db, 2));
+
+            // src * a + dst * (255 - a)，结果不超过 255 * 255，不会溢出 16 位
+            uint16x8_t r = div255(vmlaq_u16(vmulq_u16(dr, ia), sr, a));
+            uint16x8_t g = div255(vmlaq_u16(vmulq_u16(dg, ia), sg, a));
+            uint16x8_t b = div255(vmlaq_u16(vmulq_u16(db, ia), sb, a));
+
+            // 重新打包为 RGB565
+            uint16x8_t packed = vorrq_u16(vshlq_n_u16(vshrq_n_u16(r, 3), 11),
+                vorrq_u16(vshlq_n_u16(vshrq_n_u16(g, 2), 5), vshrq_n_u16(b, 3)));
+            vst1q_u16(dst + i, packed);
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            auto a = coverage ? Div255(coverage[i] * color.A) : color.A;
+            dst[i] = Blend565(dst[i], color.R, color.G, color.B, a);
+        }
+    }
+
+    Color Sample(const ImGuiSoftwareBackend::Texture* texture, float u, float v) noexcept
+    {
+        if (!texture || texture->Width == 0 || texture->Height == 0)
+            return { 255, 255, 255, 255 };
+
+        auto x = std::clamp(static_cast<int>(u * static_cast<float>(texture->Width)), 0, texture->Width - 1);
+        auto y = std::clamp(static_cast<int>(v * static_cast<float>(texture->Height)), 0, texture->Height - 1);
+        const auto* p = texture->Pixels.data() + (static_cast<size_t>(y) * texture->Width + x) * texture->BytesPerPixel;
+        if (texture->BytesPerPixel == 1)
+            return { 255, 255, 255, p[0] };
+        return { p[0], p[1], p[2], p[3] };
+    }
+
+    /**
+     * 尝试将两个三角形识别为轴对齐矩形
+     * ImGui 的 PrimRect/PrimRectUV 输出 (a, b, c) + (a, c, d)，四个顶点同色。
+     */
+    bool IsAxisAlignedRect(const ImDrawVert* vtx, const ImDrawIdx* idx) noexcept
+    {
+        if (idx[0] != idx[3] || idx[2] != idx[4])
+            return false;
+
+        const auto& a = vtx[idx[0]];
+        const auto& b = vtx[idx[1]];
+        const auto& c = vtx[idx[2]];
+        const auto& d = vtx[idx[5]];
+        if (a.col != b.col || a.col != c.col || a.col != d.col)
+            return false;
+        return a.pos.y == b.pos.y && b.pos.x == c.pos.x && c.pos.y == d.pos.y && d.pos.x == a.pos.x &&
+            a.uv.y == b.uv.y && b.uv.x == c.uv.x && c.uv.y == d.uv.y && d.uv.x == a.uv.x;
+    }
+
+    void RasterRect(const ImGuiSoftwareBackend::Target& target, const ClipRect& clip, const ImDrawVert& a, const ImDrawVert& c,
+        const ImGuiSoftwareBackend::Texture* texture, std::vector<uint8_t>& coverageBuffer) noexcept
+    {
+        auto x0 = std::min(a.pos.x, c.pos.x);
+        auto x1 = std::max(a.pos.x, c.pos.x);
+        auto y0 = std::min(a.pos.y, c.pos.y);
+        auto y1 = std::max(a.pos.y, c.pos.y);
+
+        // 像素中心落在矩形内才绘制
+        auto minX = std::max(clip.MinX, static_cast<int>(std::ceil(x0 - 0.5f)));
+        auto maxX = std::min(clip.MaxX, static_cast<int>(std::ceil(x1 - 0.5f)));
+        auto minY = std::max(clip.MinY, static_cast<int>(std::ceil(y0 - 0.5f)));
+        auto maxY = std::min(clip.MaxY, static_cast<int>(std::ceil(y1 - 0.5f)));
+        if (minX >= maxX || minY >= maxY)
+            return;
+
+        auto color = UnpackColor(a.col);
+        auto width = maxX - minX;
+
+        // 纯色矩形（UV 指向白色像素）
+        if (a.uv.x == c.uv.x && a.uv.y == c.uv.y)
+        {
+            auto texel = Sample(texture, a.uv.x, a.uv.y);
+            color.R = Div255(color.R * texel.R);
+            color.G = Div255(color.G * texel.G);
+            color.B = Div255(color.B * texel.B);
+            color.A = Div255(color.A * texel.A);
+            for (int y = minY; y < maxY; ++y)
+                BlendSpan(target.Pixels + static_cast<size_t>(y) * target.Stride + minX, nullptr, width, color);
+            return;
+        }
+
+        // 纹理矩形：UV 沿 x/y 线性变化
+        auto du = (c.pos.x != a.pos.x) ? (c.uv.x - a.uv.x) / (c.pos.x - a.pos.x) : 0.f;
+        auto dv = (c.pos.y != a.pos.y) ? (c.uv.y - a.uv.y) / (c.pos.y - a.pos.y) : 0.f;
+        if (!texture || texture->BytesPerPixel == 1)
+        {
+            // Alpha8 纹理只影响覆盖率，可以走批量混合
+            coverageBuffer.resize(static_cast<size_t>(width));
+            for (int y = minY; y < maxY; ++y)
+            {
+                auto v = a.uv.y + (static_cast<float>(y) + 0.5f - a.pos.y) * dv;
+                for (int x = minX; x < maxX; ++x)
+                {
+                    auto u = a.uv.x + (static_cast<float>(x) + 0.5f - a.pos.x) * du;
+                    coverageBuffer[x - minX] = static_cast<uint8_t>(Sample(texture, u, v).A);
+                }
+                BlendSpan(target.Pixels + static_cast<size_t>(y) * target.Stride + minX, coverageBuffer.data(), width, color);
+            }
+            return;
+        }
+
+        for (int y = minY; y < maxY; ++y)
+        {
+            auto* row = target.Pixels + static_cast<size_t>(y) * target.Stride;
+            auto v = a.uv.y + (static_cast<float>(y) + 0.5f - a.pos.y) * dv;
+            for (int x = minX; x < maxX; ++x)
+            {
+                auto u = a.uv.x + (static_cast<float>(x) + 0.5f - a.pos.x) * du;
+                auto texel = Sample(texture, u, v);
+                row[x] = Blend565(row[x], Div255(color.R * texel.R), Div255(color.G * texel.G), Div255(color.B * texel.B),
+                    Div255(color.A * texel.A));
+            }
+        }
+    }
+
+    float EdgeFunction(const ImVec2& a, const ImVec2& b, float px, float py) noexcept
+    {
+        return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+    }
+
+    // 左上填充规则：按统一绕向后，朝上（dy < 0）的边为左边，水平向右的边为上边
+    bool IsTopLeftEdge(const ImVec2& a, const ImVec2& b, float orientation) noexcept
+    {
+        auto dx = (b.x - a.x) * orientation;
+        auto dy = (b.y - a.y) * orientation;
+        return dy < 0.f || (dy == 0.f && dx > 0.f);
+    }
+
+    bool EdgeCovers(float e, bool topLeft) noexcept
+    {
+        return e > 0.f || (e == 0.f && topLeft);
+    }
+
+    void RasterTriangle(const ImGuiSoftwareBackend::Target& target, const ClipRect& clip, const ImDrawVert& v0, const ImDrawVert& v1,
+        const ImDrawVert& v2, const ImGuiSoftwareBackend::Texture* texture) noexcept
+    {
+        auto area = EdgeFunction(v0.pos, v1.pos, v2.pos.x, v2.pos.y);
+        if (std::fabs(area) < 1e-6f)
+            return;
+        auto orientation = area > 0.f ? 1.f : -1.f;
+        auto invArea = 1.f / std::fabs(area);
+
+        auto minX = std::max(clip.MinX, static_cast<int>(std::floor(std::min({v0.pos.x, v1.pos.x, v2.pos.x}))));
+        auto maxX = std::min(clip.MaxX, static_cast<int>(std::ceil(std::max({v0.pos.x, v1.pos.x, v2.pos.x}))));
+        auto minY = std::max(clip.MinY, static_cast<int>(std::floor(std::min({v0.pos.y, v1.pos.y, v2.pos.y}))));
+        auto maxY = std::min(clip.MaxY, static_cast<int>(std::ceil(std::max({v0.pos.y, v1.pos.y, v2.pos.y}))));
+        if (minX >= maxX || minY >= maxY)
+            return;
+
+        auto c0 = UnpackColor(v0.col);
+        auto c1 = UnpackColor(v1.col);
+        auto c2 = UnpackColor(v2.col);
+        bool flatColor = (v0.col == v1.col && v0.col == v2.col);
+        bool flatUV = (v0.uv.x == v1.uv.x && v0.uv.x == v2.uv.x && v0.uv.y == v1.uv.y && v0.uv.y == v2.uv.y);
+        auto flatTexel = Sample(texture, v0.uv.x, v0.uv.y);
+
+        // 共享边上的像素只归属于其中一个三角形，避免半透明边被混合两次
+        auto topLeft0 = IsTopLeftEdge(v1.pos, v2.pos, orientation);
+        auto topLeft1 = IsTopLeftEdge(v2.pos, v0.pos, orientation);
+        auto topLeft2 = IsTopLeftEdge(v0.pos, v1.pos, orientation);
+
+        // 未归一化的边函数沿 x 方向的增量，边界判定不受 1/area 舍入影响
+        auto de0 = -(v2.pos.y - v1.pos.y) * orientation;
+        auto de1 = -(v0.pos.y - v2.pos.y) * orientation;
+        auto de2 = -(v1.pos.y - v0.pos.y) * orientation;
+
+        for (int y = minY; y < maxY; ++y)
+        {
+            auto* row = target.Pixels + static_cast<size_t>(y) * target.Stride;
+            auto py = static_cast<float>(y) + 0.5f;
+            auto px = static_cast<float>(minX) + 0.5f;
+            auto e0 = EdgeFunction(v1.pos, v2.pos, px, py) * orientation;
+            auto e1 = EdgeFunction(v2.pos, v0.pos, px, py) * orientation;
+            auto e2 = EdgeFunction(v0.pos, v1.pos, px, py) * orientation;
+            for (int x = minX; x < maxX; ++x, e0 += de0, e1 += de1, e2 += de2)
+            {
+                if (!EdgeCovers(e0, topLeft0) || !EdgeCovers(e1, topLeft1) || !EdgeCovers(e2, topLeft2))
+                    continue;
+
+                auto w0 = e0 * invArea;
+                auto w1 = e1 * invArea;
+                auto w2 = e2 * invArea;
+
+                Color color = c0;
+                if (!flatColor)
+                {
+                    color.R = static_cast<uint32_t>(w0 * c0.R + w1 * c1.R + w2 * c2.R + 0.5f);
+                    color.G = static_cast<uint32_t>(w0 * c0.G + w1 * c1.G + w2 * c2.G + 0.5f);
+                    color.B = static_cast<uint32_t>(w0 * c0.B + w1 * c1.B + w2 * c2.B + 0.5f);
+                    color.A = static_cast<uint32_t>(w0 * c0.A + w1 * c1.A + w2 * c2.A + 0.5f);
+                }
+
+                auto texel = flatUV ? flatTexel : Sample(texture, w0 * v0.uv.x + w1 * v1.uv.x + w2 * v2.uv.x,
+                    w0 * v0.uv.y + w1 * v1.uv.y + w2 * v2.uv.y);
+                row[x] = Blend565(row[x], Div255(std::min(color.R, 255u) * texel.R), Div255(std::min(color.G, 255u) * texel.G),
+                    Div255(std::min(color.B, 255u) * texel.B), Div255(std::min(color.A, 255u) * texel.A));
+            }
+        }
+    }
+}
+
+void ImGuiSoftwareBackend::Initialize()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    IMGUI_CHECKVERSION();
+    IM_ASSERT(io.BackendRendererUserData == nullptr && "Already initialized a renderer backend!");
+
+    auto* bd = IM_NEW(ImGUISoftwareData)();
+    io.BackendRendererUserData = (void*)bd;
+    io.BackendRendererName = "imgui_impl_software";
+}
+
+void ImGuiSoftwareBackend::Shutdown() noexcept
+{
+    auto* bd = GetBackendData();
+    IM_ASSERT(bd != nullptr && "No renderer backend to shutdown, or already shutdown?");
+    ImGuiIO& io = ImGui::GetIO();
+
+    DestroyFontsTexture();
+    io.BackendRendererName = nullptr;
+    io.BackendRendererUserData = nullptr;
+    IM_DELETE(bd);
+}
+
+void ImGuiSoftwareBackend::NewFrame() noexcept
+{
+    auto* bd = GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGuiSoftwareBackend::Initialize()?");
+
+    if (!bd->FontTexture)
+        CreateFontsTexture();
+}
+
+void ImGuiSoftwareBackend::RenderDrawData(ImDrawData* drawData, const Target& target) noexcept
+{
+    auto* bd = GetBackendData();
+    if (!target.Pixels || target.Width <= 0 || target.Height <= 0)
+        return;
+
+    ImVec2 clipOff = drawData->DisplayPos;
+    ImVec2 clipScale = drawData->FramebufferScale;
+
+    for (int n = 0; n < drawData->CmdListsCount; n++)
+    {
+        const ImDrawList* drawList = drawData->CmdLists[n];
+
+        // 顶点变换到像素坐标系
+        auto& vertices = bd->VertexBuffer;
+        vertices.assign(drawList->VtxBuffer.Data, drawList->VtxBuffer.Data + drawList->VtxBuffer.Size);
+        for (auto& v : vertices)
+        {
+            v.pos.x = (v.pos.x - clipOff.x) * clipScale.x;
+            v.pos.y = (v.pos.y - clipOff.y) * clipScale.y;
+        }
+
+        for (int i = 0; i < drawList->CmdBuffer.Size; i++)
+        {
+            const ImDrawCmd* pcmd = &drawList->CmdBuffer[i];
+            if (pcmd->UserCallback)
+            {
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(drawList, pcmd);
+                continue;
+            }
+
+            ClipRect clip;
+            clip.MinX = std::max(0, static_cast<int>((pcmd->ClipRect.x - clipOff.x) * clipScale.x));
+            clip.MinY = std::max(0, static_cast<int>((pcmd->ClipRect.y - clipOff.y) * clipScale.y));
+            clip.MaxX = std::min(target.Width, static_cast<int>(std::ceil((pcmd->ClipRect.z - clipOff.x) * clipScale.x)));
+            clip.MaxY = std::min(target.Height, static_cast<int>(std::ceil((pcmd->ClipRect.w - clipOff.y) * clipScale.y)));
+            if (clip.MaxX <= clip.MinX || clip.MaxY <= clip.MinY)
+                continue;
+
+            const auto* texture = ToTexture(pcmd->GetTexID());
+            const auto* vtx = vertices.data() + pcmd->VtxOffset;
+            const auto* idx = drawList->IdxBuffer.Data + pcmd->IdxOffset;
+            for (unsigned j = 0; j + 3 <= pcmd->ElemCount; )
+            {
+                if (j + 6 <= pcmd->ElemCount && IsAxisAlignedRect(vtx, idx + j))
+                {
+                    RasterRect(target, clip, vtx[idx[j]], vtx[idx[j + 2]], texture, bd->CoverageBuffer);
+                    j += 6;
+                }
+                else
+                {
+                    RasterTriangle(target, clip, vtx[idx[j]], vtx[idx[j + 1]], vtx[idx[j + 2]], texture);
+                    j += 3;
+                }
+            }
+        }
+    }
+}
+
+void ImGuiSoftwareBackend::Clear(const Target& target) noexcept
+{
+    for (int y = 0; y < target.Height; ++y)
+        std::fill_n(target.Pixels + static_cast<size_t>(y) * target.Stride, target.Width, static_cast<uint16_t>(0));
+}
+
+void ImGuiSoftwareBackend::CreateFontsTexture() noexcept
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto* bd = GetBackendData();
+    unsigned char* pixels;
+    int width = 0, height = 0;
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+
+    auto* texture = IM_NEW(Texture)();
+    texture->Width = width;
+    texture->Height = height;
+    texture->BytesPerPixel = 1;
+    texture->Pixels.assign(pixels, pixels + static_cast<size_t>(width) * height);
+    bd->FontTexture = texture;
+
+    io.Fonts->SetTexID(static_cast<ImTextureID>(reinterpret_cast<intptr_t>(texture)));
+}
+
+void ImGuiSoftwareBackend::DestroyFontsTexture() noexcept
+{
+    ImGuiIO& io = ImGui::GetIO();
+    auto* bd = GetBackendData();
+    if (bd->FontTexture)
+    {
+        IM_DELETE(bd->FontTexture);
+        io.Fonts->SetTexID(0);
+        bd->FontTexture = nullptr;
+    }
+}
+
+ImTextureID ImGuiSoftwareBackend::CreateTexture(int width, int height) noexcept
+{
+    if (width <= 0 || height <= 0)
+        return 0;
+
+    try
+    {
+        auto* texture = IM_NEW(Texture)();
+        texture->Width = width;
+        texture->Height = height;
+        texture->BytesPerPixel = 4;
+        texture->Pixels.assign(static_cast<size_t>(width) * height * 4, 0);
+        return static_cast<ImTextureID>(reinterpret_cast<intptr_t>(texture));
+    }
+    catch (...)
+    {
+        return 0;
+    }
+}
+
+void ImGuiSoftwareBackend::UpdateTexture(ImTextureID texture, int x, int y, int width, int height, const uint32_t* pixels) noexcept
+{
+    auto* dst = const_cast<Texture*>(ToTexture(texture));
+    if (!dst || dst->BytesPerPixel != 4)
+        return;
+
+    // 裁剪到纹理范围内，逐行复制
+    auto x0 = std::max(0, x), y0 = std::max(0, y);
+    auto x1 = std::min(dst->Width, x + width), y1 = std::min(dst->Height, y + height);
+    for (int row = y0; row < y1 && x0 < x1; ++row)
+    {
+        const auto* src = pixels + static_cast<size_t>(row - y) * width + (x0 - x);
+        std::memcpy(dst->Pixels.data() + (static_cast<size_t>(row) * dst->Width + x0) * 4, src, static_cast<size_t>(x1 - x0) * 4);
+    }
+}
+
+void ImGuiSoftwareBackend::DestroyTexture(ImTextureID texture) noexcept
+{
+    auto* dst = const_cast<Texture*>(ToTexture(texture));
+    if (dst)
+        IM_DELETE(dst);
+}
@@ -0,0 +1,479 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <KmsDisplay.hpp>
+
+#include <cerrno>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <gbm.h>
+#include <xf86drm.h>
+#include <EGL/eglext.h>
+#include <GLES2/gl2.h>
+#include <SDL.h>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+#include <AppBase.hpp>
+#include <ImGuiGLES2Backend.hpp>
+#include <SignalHandler.hpp>
+
+using namespace std;
+
+namespace
+{
+    int FindPreferredMode(const drmModeConnector* connector, int width, int height) noexcept
+    {
+        // 优先选择与面板分辨率一致的模式，其次是首选模式
+        int preferred = -1;
+        for (int i = 0; i < connector->count_modes; ++i)
+        {
+            const auto& mode = connector->modes[i];
+            if (mode.hdisplay == width && mode.vdisplay == height)
+                return i;
+            if (preferred < 0 && (mode.type & DRM_MODE_TYPE_PREFERRED))
+                preferred = i;
+        }
+        return preferred >= 0 ? preferred : 0;
+    }
+
+    uint32_t FindCrtc(int fd, const drmModeRes* resources, const drmModeConnector* connector) noexcept
+    {
+        // 优先沿用当前绑定的 CRTC
+        if (connector->encoder_id)
+        {
+            if (auto* encoder = ::drmModeGetEncoder(fd, connector->encoder_id))
+            {
+                auto crtcId = encoder->crtc_id;
+                ::drmModeFreeEncoder(encoder);
+                if (crtcId)
+                    return crtcId;
+            }
+        }
+
+        for (int i = 0; i < connector->count_encoders; ++i)
+        {
+            auto* encoder = ::drmModeGetEncoder(fd, connector->encoders[i]);
+            if (!encoder)
+                continue;
+            for (int j = 0; j < resources->count_crtcs; ++j)
+            {
+                if (encoder->possible_crtcs & (1u << j))
+                {
+                    ::drmModeFreeEncoder(encoder);
+                    return resources->crtcs[j];
+                }
+            }
+            ::drmModeFreeEncoder(encoder);
+        }
+        return 0;
+    }
+}
+
+KmsDisplay::~KmsDisplay() noexcept
+{
+    if (m_bBackendInitialized)
+    {
+        ImGuiGLES2Backend::Shutdown();
+        ImGui::GetIO().BackendPlatformName = nullptr;
+    }
+
+    if (m_uOffscreenFbo)
+        ::glDeleteFramebuffers(1, &m_uOffscreenFbo);
+    if (m_uOffscreenColor)
+        ::glDeleteTextures(1, &m_uOffscreenColor);
+
+    if (m_pSavedCrtc)
+    {
+        // 还原进程启动前的显示状态
+        ::drmModeSetCrtc(m_iDrmFd, m_pSavedCrtc->crtc_id, m_pSavedCrtc->buffer_id, m_pSavedCrtc->x, m_pSavedCrtc->y,
+            &m_uConnectorId, 1, &m_pSavedCrtc->mode);
+        ::drmModeFreeCrtc(m_pSavedCrtc);
+    }
+    if (m_pFrontBo)
+        ::gbm_surface_release_buffer(m_pGbmSurface, m_pFrontBo);
+
+    if (m_pEglDisplay != EGL_NO_DISPLAY)
+    {
+        ::eglMakeCurrent(m_pEglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (m_pEglSurface != EGL_NO_SURFACE)
+            ::eglDestroySurface(m_pEglDisplay, m_pEglSurface);
+        if (m_pEglContext != EGL_NO_CONTEXT)
+            ::eglDestroyContext(m_pEglDisplay, m_pEglContext);
+        ::eglTerminate(m_pEglDisplay);
+    }
+
+    if (m_pGbmSurface)
+        ::gbm_surface_destroy(m_pGbmSurface);
+    if (m_pGbmDevice)
+        ::gbm_device_destroy(m_pGbmDevice);
+    if (m_iDrmFd >= 0)
+        ::close(m_iDrmFd);
+}
+
+Result<void> KmsDisplay::Initialize(const AppBaseConfig& config) noexcept
+{
+    // 查找 DRM 设备
+    bool kmsReady = false;
+    if (!config.DisplayDevice.empty())
+    {
+        kmsReady = OpenDrmDevice(config.DisplayDevice, config.InitialWidth, config.InitialHeight);
+    }
+    else
+    {
+        for (int i = 0; i < 8 && !kmsReady; ++i)
+            kmsReady = OpenDrmDevice(fmt::format("/dev/dri/card{}", i), config.InitialWidth, config.InitialHeight);
+    }
+
+    if (kmsReady && !InitializeKmsEgl())
+    {
+        spdlog::error("Failed to initialize EGL on GBM device");
+        return make_error_code(errc::no_such_device);
+    }
+    if (!kmsReady)
+    {
+        spdlog::warn("No usable DRM connector found, falling back to offscreen EGL rendering");
+        if (!InitializeOffscreenEgl(config.InitialWidth, config.InitialHeight))
+        {
+            spdlog::error("Failed to initialize offscreen EGL context");
+            return make_error_code(errc::no_such_device);
+        }
+    }
+
+    SignalHandler::Install();
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendPlatformName = "kms";
+    ImGuiGLES2Backend::Initialize();
+    m_bBackendInitialized = true;
+    return {};
+}
+
+void KmsDisplay::PollEvents(bool& exitRequest) noexcept
+{
+    // 没有输入设备，仅响应终止信号
+    if (SignalHandler::ConsumeExitRequest())
+        exitRequest = true;
+}
+
+ImTextureID KmsDisplay::CreateTexture(int width, int height) noexcept
+{
+    return ImGuiGLES2Backend::CreateTexture(width, height);
+}
+
+void KmsDisplay::UpdateTexture(ImTextureID texture, int x, int y, int width, int height, const uint32_t* pixels) noexcept
+{
+    ImGuiGLES2Backend::UpdateTexture(texture, x, y, width, height, pixels);
+}
+
+void KmsDisplay::DestroyTexture(ImTextureID texture) noexcept
+{
+    ImGuiGLES2Backend::DestroyTexture(texture);
+}
+
+void KmsDisplay::NewFrame() noexcept
+{
+    static Uint64 kFrequency = ::SDL_GetPerformanceFrequency();
+
+    ImGuiGLES2Backend::NewFrame();
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(static_cast<float>(m_iWidth), static_cast<float>(m_iHeight));
+    io.DisplayFramebufferScale = ImVec2(1.f, 1.f);
+
+    auto currentTick = ::SDL_GetPerformanceCounter();
+    io.DeltaTime = m_uLastTick > 0 ? static_cast<float>(static_cast<double>(currentTick - m_uLastTick) / static_cast<double>(kFrequency)) :
+        static_cast<float>(1.0f / 60.0f);
+    m_uLastTick = currentTick;
+}
+
+void KmsDisplay::Render(ImDrawData* drawData) noexcept
+{
+    ImGuiGLES2Backend::Clear(m_iWidth, m_iHeight);
+    ImGuiGLES2Backend::RenderDrawData(drawData);
+}
+
+void KmsDisplay::Present() noexcept
+{
+    if (IsOffscreen())
+    {
+        ::glFinish();
+        return;
+    }
+
+    ::eglSwapBuffers(m_pEglDisplay, m_pEglSurface);
+
+    auto* bo = ::gbm_surface_lock_front_buffer(m_pGbmSurface);
+    if (!bo)
+    {
+        spdlog::error("gbm_surface_lock_front_buffer failed");
+        return;
+    }
+
+    auto fb = GetFramebufferForBo(bo);
+    if (!m_bCrtcSet)
+    {
+        if (::drmModeSetCrtc(m_iDrmFd, m_uCrtcId, fb, 0, 0, &m_uConnectorId, 1, &m_stMode) != 0)
+            spdlog::error("drmModeSetCrtc failed: {}", errno);
+        m_bCrtcSet = true;
+    }
+    else
+    {
+        if (::drmModePageFlip(m_iDrmFd, m_uCrtcId, fb, DRM_MODE_PAGE_FLIP_EVENT, this) == 0)
+        {
+            m_bFlipPending = true;
+            WaitPageFlip();
+        }
+        else
+        {
+            spdlog::error("drmModePageFlip failed: {}", errno);
+        }
+    }
+
+    // 翻页完成后上一帧的缓冲区可以交还给 GBM
+    if (m_pFrontBo)
+        ::gbm_surface_release_buffer(m_pGbmSurface, m_pFrontBo);
+    m_pFrontBo = bo;
+}
+
+bool KmsDisplay::OpenDrmDevice(const std::string& path, int width, int height) noexcept
+{
+    int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    auto* resources = ::drmModeGetResources(fd);
+    if (!resources)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // 选择已连接的 connector，分辨率与面板一致者优先
+    drmModeConnector* chosen = nullptr;
+    for (int i = 0; i < resources->count_connectors; ++i)
+    {
+        auto* connector = ::drmModeGetConnector(fd, resources->connectors[i]);
+        if (!connector)
+            continue;
+        if (connector->connection != DRM_MODE_CONNECTED || connector->count_modes == 0)
+        {
+            ::drmModeFreeConnector(connector);
+            continue;
+        }
+
+        const auto& mode = connector->modes[FindPreferredMode(connector, width, height)];
+        bool exactMatch = (mode.hdisplay == width && mode.vdisplay == height);
+        if (!chosen || exactMatch)
+        {
+            if (chosen)
+                ::drmModeFreeConnector(chosen);
+            chosen = connector;
+            if (exactMatch)
+                break;
+        }
+        else
+        {
+            ::drmModeFreeConnector(connector);
+        }
+    }
+
+    uint32_t crtcId = chosen ? FindCrtc(fd, resources, chosen) : 0;
+    if (!chosen || crtcId == 0)
+    {
+        if (chosen)
+            ::drmModeFreeConnector(chosen);
+        ::drmModeFreeResources(resources);
+        ::close(fd);
+        return false;
+    }
+
+    m_iDrmFd = fd;
+    m_uConnectorId = chosen->connector_id;
+    m_uCrtcId = crtcId;
+    m_stMode = chosen->modes[FindPreferredMode(chosen, width, height)];
+    m_iWidth = m_stMode.hdisplay;
+    m_iHeight = m_stMode.vdisplay;
+    m_pSavedCrtc = ::drmModeGetCrtc(fd, crtcId);
+    spdlog::info("Using DRM device {}, connector {}, mode {}x{}@{}", path, m_uConnectorId, m_iWidth, m_iHeight, m_stMode.vrefresh);
+
+    ::drmModeFreeConnector(chosen);
+    ::drmModeFreeResources(resources);
+    return true;
+}
+
+bool KmsDisplay::InitializeKmsEgl() noexcept
+{
+    m_pGbmDevice = ::gbm_create_device(m_iDrmFd);
+    if (!m_pGbmDevice)
+        return false;
+    m_pGbmSurface = ::gbm_surface_create(m_pGbmDevice, static_cast<uint32_t>(m_iWidth), static_cast<uint32_t>(m_iHeight),
+        GBM_FORMAT_XRGB8888, GBM_BO_USE_SCANOUT | GBM_BO_USE_RENDERING);
+    if (!m_pGbmSurface)
+        return false;
+
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(::eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay)
+        m_pEglDisplay = getPlatformDisplay(EGL_PLATFORM_GBM_KHR, m_pGbmDevice, nullptr);
+    else
+        m_pEglDisplay = ::eglGetDisplay(reinterpret_cast<EGLNativeDisplayType>(m_pGbmDevice));
+    if (m_pEglDisplay == EGL_NO_DISPLAY || !::eglInitialize(m_pEglDisplay, nullptr, nullptr))
+        return false;
+
+    if (!CreateContext(EGL_WINDOW_BIT))
+        return false;
+
+    m_pEglSurface = ::eglCreateWindowSurface(m_pEglDisplay, m_pEglConfig, reinterpret_cast<EGLNativeWindowType>(m_pGbmSurface),
+        nullptr);
+    if (m_pEglSurface == EGL_NO_SURFACE)
+        return false;
+    return ::eglMakeCurrent(m_pEglDisplay, m_pEglSurface, m_pEglSurface, m_pEglContext) == EGL_TRUE;
+}
+
+bool KmsDisplay::InitializeOffscreenEgl(int width, int height) noexcept
+{
+    m_iWidth = width;
+    m_iHeight = height;
+
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(::eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    auto queryDevices = reinterpret_cast<PFNEGLQUERYDEVICESEXTPROC>(::eglGetProcAddress("eglQueryDevicesEXT"));
+    if (!getPlatformDisplay)
+        return false;
+
+    // 依次尝试 EGL 设备平台与 Mesa 的 surfaceless 平台
+    std::vector<EGLDisplay> candidates;
+    if (queryDevices)
+    {
+        EGLDeviceEXT devices[8];
+        EGLint count = 0;
+        if (queryDevices(8, devices, &count))
+        {
+            for (EGLint i = 0; i < count; ++i)
+                candidates.push_back(getPlatformDisplay(EGL_PLATFORM_DEVICE_EXT, devices[i], nullptr));
+        }
+    }
+    candidates.push_back(getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr));
+
+    for (auto display : candidates)
+    {
+        if (display == EGL_NO_DISPLAY || !::eglInitialize(display, nullptr, nullptr))
+            continue;
+        m_pEglDisplay = display;
+        if (CreateContext(0) && ::eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_pEglContext) == EGL_TRUE)
+            break;
+
+        if (m_pEglContext != EGL_NO_CONTEXT)
+            ::eglDestroyContext(display, m_pEglContext);
+        m_pEglContext = EGL_NO_CONTEXT;
+        ::eglTerminate(display);
+        m_pEglDisplay = EGL_NO_DISPLAY;
+    }
+    if (m_pEglDisplay == EGL_NO_DISPLAY)
+        return false;
+
+    // 没有窗口表面，渲染到 FBO
+    ::glGenTextures(1, &m_uOffscreenColor);
+    ::glBindTexture(GL_TEXTURE_2D, m_uOffscreenColor);
+    ::glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    ::glBindTexture(GL_TEXTURE_2D, 0);
+    ::glGenFramebuffers(1, &m_uOffscreenFbo);
+    ::glBindFramebuffer(GL_FRAMEBUFFER, m_uOffscreenFbo);
+    ::glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_uOffscreenColor, 0);
+    return ::glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+bool KmsDisplay::CreateContext(EGLint surfaceType) noexcept
+{
+    if (!::eglBindAPI(EGL_OPENGL_ES_API))
+        return false;
+
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, surfaceType,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+        EGL_NONE,
+    };
+    EGLint count = 0;
+    if (!::eglChooseConfig(m_pEglDisplay, configAttribs, nullptr, 0, &count) || count == 0)
+        return false;
+    std::vector<EGLConfig> configs(static_cast<size_t>(count));
+    ::eglChooseConfig(m_pEglDisplay, configAttribs, configs.data(), count, &count);
+
+    // 扫描输出时 EGL 配置必须与 GBM 表面格式一致
+    m_pEglConfig = configs[0];
+    if (m_pGbmSurface)
+    {
+        bool found = false;
+        for (auto config : configs)
+        {
+            EGLint visualId = 0;
+            if (::eglGetConfigAttrib(m_pEglDisplay, config, EGL_NATIVE_VISUAL_ID, &visualId) &&
+                static_cast<uint32_t>(visualId) == GBM_FORMAT_XRGB8888)
+            {
+                m_pEglConfig = config;
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+            return false;
+    }
+
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_CLIENT_VERSION, 2,
+        EGL_NONE,
+    };
+    m_pEglContext = ::eglCreateContext(m_pEglDisplay, m_pEglConfig, EGL_NO_CONTEXT, contextAttribs);
+    return m_pEglContext != EGL_NO_CONTEXT;
+}
+
+uint32_t KmsDisplay::GetFramebufferForBo(gbm_bo* bo) noexcept
+{
+    if (auto* data = ::gbm_bo_get_user_data(bo))
+        return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(data));
+
+    uint32_t fbId = 0;
+    auto ret = ::drmModeAddFB(m_iDrmFd, ::gbm_bo_get_width(bo), ::gbm_bo_get_height(bo), 24, 32, ::gbm_bo_get_stride(bo),
+        ::gbm_bo_get_handle(bo).u32, &fbId);
+    if (ret != 0)
+    {
+        spdlog::error("drmModeAddFB failed: {}", errno);
+        return 0;
+    }
+
+    // 缓冲区销毁时一并释放对应的 framebuffer
+    ::gbm_bo_set_user_data(bo, reinterpret_cast<void*>(static_cast<uintptr_t>(fbId)), [](gbm_bo* bo, void* data) {
+        auto fd = ::gbm_device_get_fd(::gbm_bo_get_device(bo));
+        ::drmModeRmFB(fd, static_cast<uint32_t>(reinterpret_cast<uintptr_t>(data)));
+    });
+    return fbId;
+}
+
+void KmsDisplay::WaitPageFlip() noexcept
+{
+    drmEventContext eventContext {};
+    eventContext.version = 2;
+    eventContext.page_flip_handler = [](int, unsigned, unsigned, unsigned, void* userData) {
+        static_cast<KmsDisplay*>(userData)->m_bFlipPending = false;
+    };
+
+    while (m_bFlipPending)
+    {
+        ::pollfd pfd { m_iDrmFd, POLLIN, 0 };
+        auto ret = ::poll(&pfd, 1, 1000);
+        if (ret < 0 && errno == EINTR)
+            continue;
+        if (ret <= 0)
+        {
+            spdlog::warn("Timeout while waiting for page flip");
+            m_bFlipPending = false;
+            break;
+        }
+        ::drmHandleEvent(m_iDrmFd, &eventContext);
+    }
+}
@@ -0,0 +1,193 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <MetricsCapture.hpp>
+
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <zlib.h>
+#include <spdlog/spdlog.h>
+
+using namespace std;
+
+static_assert(std::endian::native == std::endian::little, "Capture file is stored in little endian");
+
+namespace
+{
+    constexpr size_t kHeaderSize = sizeof(uint32_t) * 2;
+    constexpr uint32_t kMaxBodySize = 256 * 1024 * 1024;  // 防止损坏的长度字段导致过量分配
+
+    template <typename T>
+    bool ReadValue(FILE* fp, T& out) noexcept
+    {
+        return ::fread(&out, sizeof(T), 1, fp) == 1;
+    }
+
+    template <typename T>
+    bool WriteValue(FILE* fp, const T& value) noexcept
+    {
+        return ::fwrite(&value, sizeof(T), 1, fp) == 1;
+    }
+}
+
+// <editor-fold desc="MetricsCaptureWriter">
+
+MetricsCaptureWriter::~MetricsCaptureWriter() noexcept
+{
+    if (m_pFile)
+        ::fclose(m_pFile);
+}
+
+Result<void> MetricsCaptureWriter::Open(const std::string& path) noexcept
+{
+    // a+ 模式下写入总是追加到末尾，读取可从任意位置开始
+    auto* fp = ::fopen(path.c_str(), "a+b");
+    if (!fp)
+    {
+        spdlog::error("Failed to open capture file {}: {}", path, ::strerror(errno));
+        return error_code(errno, system_category());
+    }
+
+    ::fseek(fp, 0, SEEK_END);
+    if (::ftell(fp) != 0)
+    {
+        // 已有文件只在文件头一致时追加，避免写入其他文件或不同版本的采集文件
+        uint32_t magic = 0, version = 0;
+        ::rewind(fp);
+        if (!ReadValue(fp, magic) || magic != MetricsCaptureFormat::kMagic || !ReadValue(fp, version) ||
+            version != MetricsCaptureFormat::kVersion)
+        {
+            spdlog::error("Refusing to append to {}: not a version {} capture file", path, MetricsCaptureFormat::kVersion);
+            ::fclose(fp);
+            return make_error_code(errc::invalid_argument);
+        }
+        ::fseek(fp, 0, SEEK_END);
+    }
+    else
+    {
+        // 新文件写入文件头
+        if (!WriteValue(fp, MetricsCaptureFormat::kMagic) || !WriteValue(fp, MetricsCaptureFormat::kVersion) || ::fflush(fp) != 0)
+        {
+            spdlog::error("Failed to write capture file header {}", path);
+            ::fclose(fp);
+            return make_error_code(errc::io_error);
+        }
+    }
+
+    if (m_pFile)
+        ::fclose(m_pFile);
+    m_pFile = fp;
+    spdlog::info("Recording scrapes to {}", path);
+    return {};
+}
+
+Result<void> MetricsCaptureWriter::Append(uint64_t timestampMs, const std::string& body) noexcept
+{
+    assert(m_pFile);
+
+    try
+    {
+        auto compressedSize = ::compressBound(static_cast<uLong>(body.size()));
+        std::string compressed;
+        compressed.resize(compressedSize);
+        if (::compress2(reinterpret_cast<Bytef*>(compressed.data()), &compressedSize,
+            reinterpret_cast<const Bytef*>(body.data()), static_cast<uLong>(body.size()), Z_BEST_SPEED) != Z_OK)
+        {
+            return make_error_code(errc::io_error);
+        }
+
+        if (!WriteValue(m_pFile, timestampMs) || !WriteValue(m_pFile, static_cast<uint32_t>(body.size())) ||
+            !WriteValue(m_pFile, static_cast<uint32_t>(compressedSize)) ||
+            ::fwrite(compressed.data(), 1, compressedSize, m_pFile) != compressedSize || ::fflush(m_pFile) != 0)
+        {
+            spdlog::error("Failed to append capture record");
+            return make_error_code(errc::io_error);
+        }
+        return {};
+    }
+    catch (const std::bad_alloc&)
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+}
+
+// </editor-fold>
+// <editor-fold desc="MetricsCaptureReader">
+
+MetricsCaptureReader::~MetricsCaptureReader() noexcept
+{
+    if (m_pFile)
+        ::fclose(m_pFile);
+}
+
+Result<void> MetricsCaptureReader::Open(const std::string& path) noexcept
+{
+    auto* fp = ::fopen(path.c_str(), "rb");
+    if (!fp)
+    {
+        spdlog::error("Failed to open capture file {}: {}", path, ::strerror(errno));
+        return error_code(errno, system_category());
+    }
+
+    uint32_t magic = 0, version = 0;
+    if (!ReadValue(fp, magic) || magic != MetricsCaptureFormat::kMagic || !ReadValue(fp, version) ||
+        version != MetricsCaptureFormat::kVersion)
+    {
+        spdlog::error("Invalid capture file {}", path);
+        ::fclose(fp);
+        return make_error_code(errc::invalid_argument);
+    }
+
+    if (m_pFile)
+        ::fclose(m_pFile);
+    m_pFile = fp;
+    return {};
+}
+
+bool MetricsCaptureReader::Next(MetricsCaptureRecord& record) noexcept
+{
+    assert(m_pFile);
+
+    uint64_t timestampMs = 0;
+    uint32_t rawSize = 0, compressedSize = 0;
+    if (!ReadValue(m_pFile, timestampMs) || !ReadValue(m_pFile, rawSize) || !ReadValue(m_pFile, compressedSize))
+        return false;
+    if (rawSize > kMaxBodySize || compressedSize > kMaxBodySize)
+    {
+        spdlog::warn("Corrupted capture record, stop reading");
+        return false;
+    }
+
+    try
+    {
+        m_stCompressed.resize(compressedSize);
+        if (::fread(m_stCompressed.data(), 1, compressedSize, m_pFile) != compressedSize)
+            return false;
+
+        record.TimestampMs = timestampMs;
+        record.Body.resize(rawSize);
+        uLongf destSize = rawSize;
+        if (::uncompress(reinterpret_cast<Bytef*>(record.Body.data()), &destSize,
+            reinterpret_cast<const Bytef*>(m_stCompressed.data()), compressedSize) != Z_OK || destSize != rawSize)
+        {
+            spdlog::warn("Corrupted capture record, stop reading");
+            return false;
+        }
+        return true;
+    }
+    catch (const std::bad_alloc&)
+    {
+        return false;
+    }
+}
+
+void MetricsCaptureReader::Rewind() noexcept
+{
+    assert(m_pFile);
+    ::fseek(m_pFile, static_cast<long>(kHeaderSize), SEEK_SET);
+}
+
+// </editor-fold>
@@ -0,0 +1,36 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <MetricsHistory.hpp>
+
+#include <algorithm>
+
+MetricsHistory::MetricsHistory(size_t capacity)
+    : m_uCapacity(capacity), m_stValues(2 * capacity)
+{
+}
+
+void MetricsHistory::Assign(const double* values, size_t count)
+{
+    if (count > m_uCapacity)
+    {
+        values += count - m_uCapacity;
+        count = m_uCapacity;
+    }
+
+    auto* first = m_stValues.data();
+    std::fill(first, first + m_uCapacity - count, 0.);
+    std::copy(values, values + count, first + m_uCapacity - count);
+    std::copy(first, first + m_uCapacity, first + m_uCapacity);
+    m_uHead = 0;
+}
+
+void MetricsHistory::Push(double value) noexcept
+{
+    if (m_uCapacity == 0)
+        return;
+    m_stValues[m_uHead] = m_stValues[m_uHead + m_uCapacity] = value;
+    m_uHead = (m_uHead + 1) % m_uCapacity;
+}
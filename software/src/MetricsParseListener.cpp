@@ -0,0 +1,244 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <MetricsParseListener.hpp>
+
+#include <double-conversion/string-to-double.h>
+
+using namespace std;
+using namespace double_conversion;
+
+double MetricsParseListener::ToDouble(std::string_view input) noexcept
+{
+    auto flags = StringToDoubleConverter::ALLOW_LEADING_SPACES | StringToDoubleConverter::ALLOW_TRAILING_SPACES |
+        StringToDoubleConverter::ALLOW_SPACES_AFTER_SIGN;
+    StringToDoubleConverter converter(flags, 0.0, 0.0, "inf", "nan", 0);
+
+    int processed = 0;
+    return converter.StringToDouble(input.data(), static_cast<int>(input.size()), &processed);
+}
+
+int64_t MetricsParseListener::ToInteger(std::string_view input) noexcept
+{
+    return static_cast<int64_t>(ToDouble(input));
+}
+
+void MetricsParseListener::OnMetricsBegin(std::string_view name)
+{
+    m_stCurrentMetricsName = name;
+}
+
+void MetricsParseListener::OnMetricsLabel(std::string_view name, std::string_view value)
+{
+    if (m_stCurrentMetricsName == "node_cpu_seconds_total")
+    {
+        if (name == "cpu")
+            m_iCurrentCpuIndex = static_cast<int>(ToInteger(value));
+        else if (name == "mode")
+            m_stCurrentCpuMode = value;
+    }
+    else if (m_stCurrentMetricsName == "node_disk_io_time_seconds_total" ||
+        m_stCurrentMetricsName == "node_disk_read_time_seconds_total" ||
+        m_stCurrentMetricsName == "node_disk_write_time_seconds_total" ||
+        m_stCurrentMetricsName == "node_disk_read_bytes_total" ||
+        m_stCurrentMetricsName == "node_disk_written_bytes_total" ||
+        m_stCurrentMetricsName == "node_disk_reads_completed_total" ||
+        m_stCurrentMetricsName == "node_disk_writes_completed_total" ||
+        m_stCurrentMetricsName == "node_disk_io_time_weighted_seconds_total")
+    {
+        if (name == "device")
+        {
+            m_bCurrentDeviceExcluded = m_pDiskFilter && !m_pDiskFilter->Accept(value);
+            if (!m_bCurrentDeviceExcluded)
+                m_stCurrentDeviceName = value;
+        }
+    }
+    else if (m_stCurrentMetricsName == "node_network_receive_bytes_total" ||
+        m_stCurrentMetricsName == "node_network_transmit_bytes_total")
+    {
+        if (name == "device")
+        {
+            m_bCurrentDeviceExcluded = m_pNetworkFilter && !m_pNetworkFilter->Accept(value);
+            if (!m_bCurrentDeviceExcluded)
+                m_stCurrentDeviceName = value;
+        }
+    }
+}
+
+void MetricsParseListener::OnMetricsValue(std::string_view value)
+{
+    if (m_bCurrentDeviceExcluded)
+        return;
+
+    if (m_stCurrentMetricsName == "node_boot_time_seconds")
+    {
+        m_stRawMetrics.BootTimestamp = ToInteger(value);
+    }
+    else if (m_stCurrentMetricsName == "node_load1")
+    {
+        m_stRawMetrics.Load1 = ToDouble(value);
+    }
+    else if (m_stCurrentMetricsName == "node_load5")
+    {
+        m_stRawMetrics.Load5 = ToDouble(value);
+    }
+    else if (m_stCurrentMetricsName == "node_load15")
+    {
+        m_stRawMetrics.Load15 = ToDouble(value);
+    }
+    else if (m_stCurrentMetricsName == "node_memory_MemAvailable_bytes")
+    {
+        m_stRawMetrics.MemoryAvailableBytes = ToInteger(value);
+    }
+    else if (m_stCurrentMetricsName == "node_memory_MemTotal_bytes")
+    {
+        m_stRawMetrics.MemoryTotalBytes = ToInteger(value);
+    }
+    else if (m_stCurrentMetricsName == "node_memory_MemFree_bytes")
+    {
+        m_stRawMetrics.MemoryFreeBytes = ToInteger(value);
+    }
+    else if (m_stCurrentMetricsName == "node_memory_AnonPages_bytes")
+    {
+        m_stRawMetrics.MemoryAnonBytes = ToInteger(value);
+    }
+    else if (m_stCurrentMetricsName == "node_memory_Buffers_bytes")
+    {
+        m_stRawMetrics.MemoryBuffersBytes = ToInteger(value);
+    }
+    else if (m_stCurrentMetricsName == "node_memory_Cached_bytes")
+    {
+        m_stRawMetrics.MemoryCachedBytes = ToInteger(value);
+    }
+    else if (m_stCurrentMetricsName == "node_memory_SwapTotal_bytes")
+    {
+        m_stRawMetrics.SwapTotalBytes = ToInteger(value);
+    }
+    else if (m_stCurrentMetricsName == "node_memory_SwapFree_bytes")
+    {
+        m_stRawMetrics.SwapFreeBytes = ToInteger(value);
+    }
+    else if (m_stCurrentMetricsName == "node_zram_orig_data_size_bytes")
+    {
+        m_stRawMetrics.ZramOriginalBytes += ToInteger(value);
+    }
+    else if (m_stCurrentMetricsName == "node_zram_compr_data_size_bytes")
+    {
+        m_stRawMetrics.ZramCompressedBytes += ToInteger(value);
+    }
+    else if (m_stCurrentMetricsName == "node_vmstat_pgmajfault")
+    {
+        m_stRawMetrics.VmstatMajorFaults = ToDouble(value);
+        m_stRawMetrics.HasVmstat = true;
+    }
+    else if (m_stCurrentMetricsName == "node_vmstat_pswpin")
+    {
+        m_stRawMetrics.VmstatSwapIn = ToDouble(value);
+    }
+    else if (m_stCurrentMetricsName == "node_vmstat_pswpout")
+    {
+        m_stRawMetrics.VmstatSwapOut = ToDouble(value);
+    }
+    else if (m_stCurrentMetricsName.starts_with("node_pressure_"))
+    {
+        auto& pressure = m_stRawMetrics.PressureSecondsTotal;
+        double* target = nullptr;
+        if (m_stCurrentMetricsName == "node_pressure_cpu_waiting_seconds_total")
+            target = &pressure.CpuWaiting;
+        else if (m_stCurrentMetricsName == "node_pressure_cpu_stalled_seconds_total")
+            target = &pressure.CpuStalled;
+        else if (m_stCurrentMetricsName == "node_pressure_memory_waiting_seconds_total")
+            target = &pressure.MemoryWaiting;
+        else if (m_stCurrentMetricsName == "node_pressure_memory_stalled_seconds_total")
+            target = &pressure.MemoryStalled;
+        else if (m_stCurrentMetricsName == "node_pressure_io_waiting_seconds_total")
+            target = &pressure.IoWaiting;
+        else if (m_stCurrentMetricsName == "node_pressure_io_stalled_seconds_total")
+            target = &pressure.IoStalled;
+        if (target)
+        {
+            *target = ToDouble(value);
+            m_stRawMetrics.HasPressure = true;
+        }
+    }
+    else if (m_stCurrentMetricsName == "node_cpu_seconds_total")
+    {
+        auto& cpuMetrics = m_stRawMetrics.CpuSecondsTotal[m_iCurrentCpuIndex];
+        if (m_stCurrentCpuMode == "idle")
+            cpuMetrics.Idle = ToDouble(value);
+        else if (m_stCurrentCpuMode == "iowait")
+            cpuMetrics.IoWait = ToDouble(value);
+        else if (m_stCurrentCpuMode == "irq")
+            cpuMetrics.Irq = ToDouble(value);
+        else if (m_stCurrentCpuMode == "nice")
+            cpuMetrics.Nice = ToDouble(value);
+        else if (m_stCurrentCpuMode == "softirq")
+            cpuMetrics.SoftIrq = ToDouble(value);
+        else if (m_stCurrentCpuMode == "steal")
+            cpuMetrics.Steal = ToDouble(value);
+        else if (m_stCurrentCpuMode == "system")
+            cpuMetrics.System = ToDouble(value);
+        else if (m_stCurrentCpuMode == "user")
+            cpuMetrics.User = ToDouble(value);
+        m_iCurrentCpuIndex = -1;
+        m_stCurrentCpuMode = {};
+    }
+    else if (m_stCurrentMetricsName == "node_disk_io_time_seconds_total")
+    {
+        m_stRawMetrics.DiskIoTimeSecondsTotal[m_stCurrentDeviceName] = ToDouble(value);
+        m_stCurrentDeviceName = {};
+    }
+    else if (m_stCurrentMetricsName == "node_disk_read_time_seconds_total")
+    {
+        m_stRawMetrics.DiskReadTimeSecondsTotal[m_stCurrentDeviceName] = ToDouble(value);
+        m_stCurrentDeviceName = {};
+    }
+    else if (m_stCurrentMetricsName == "node_disk_write_time_seconds_total")
+    {
+        m_stRawMetrics.DiskWriteTimeSecondsTotal[m_stCurrentDeviceName] = ToDouble(value);
+        m_stCurrentDeviceName = {};
+    }
+    else if (m_stCurrentMetricsName == "node_disk_read_bytes_total")
+    {
+        m_stRawMetrics.DiskReadBytesTotal[m_stCurrentDeviceName] = ToDouble(value);
+        m_stCurrentDeviceName = {};
+    }
+    else if (m_stCurrentMetricsName == "node_disk_written_bytes_total")
+    {
+        m_stRawMetrics.DiskWrittenBytesTotal[m_stCurrentDeviceName] = ToDouble(value);
+        m_stCurrentDeviceName = {};
+    }
+    else if (m_stCurrentMetricsName == "node_disk_reads_completed_total")
+    {
+        m_stRawMetrics.DiskReadsCompletedTotal[m_stCurrentDeviceName] = ToDouble(value);
+        m_stCurrentDeviceName = {};
+    }
+    else if (m_stCurrentMetricsName == "node_disk_writes_completed_total")
+    {
+        m_stRawMetrics.DiskWritesCompletedTotal[m_stCurrentDeviceName] = ToDouble(value);
+        m_stCurrentDeviceName = {};
+    }
+    else if (m_stCurrentMetricsName == "node_disk_io_time_weighted_seconds_total")
+    {
+        m_stRawMetrics.DiskIoTimeWeightedSecondsTotal[m_stCurrentDeviceName] = ToDouble(value);
+        m_stCurrentDeviceName = {};
+    }
+    else if (m_stCurrentMetricsName == "node_network_receive_bytes_total")
+    {
+        m_stRawMetrics.NetworkReceiveBytesTotal[m_stCurrentDeviceName] = ToDouble(value);
+        m_stCurrentDeviceName = {};
+    }
+    else if (m_stCurrentMetricsName == "node_network_transmit_bytes_total")
+    {
+        m_stRawMetrics.NetworkTransmitBytesTotal[m_stCurrentDeviceName] = ToDouble(value);
+        m_stCurrentDeviceName = {};
+    }
+}
+
+void MetricsParseListener::OnMetricsEnd()
+{
+    m_stCurrentMetricsName = {};
+    m_bCurrentDeviceExcluded = false;
+}
@@ -5,174 +5,33 @@
  */
 #include <MetricsSampleThread.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <ada.h>
 #include <httplib.h>
 #include <SDL2/SDL.h>
 #include <spdlog/spdlog.h>
-#include <double-conversion/string-to-double.h>
 #include <MetricsParser.hpp>
+#include <MetricsParseListener.hpp>
+#include <SelfMetrics.hpp>
+#include <Trace.hpp>
 
 using namespace std;
-using namespace double_conversion;
 
 namespace
 {
-    double ToDouble(std::string_view input) noexcept
-    {
-        auto flags = StringToDoubleConverter::ALLOW_LEADING_SPACES | StringToDoubleConverter::ALLOW_TRAILING_SPACES |
-            StringToDoubleConverter::ALLOW_SPACES_AFTER_SIGN;
-        StringToDoubleConverter converter(flags, 0.0, 0.0, "inf", "nan", 0);
-
-        int processed = 0;
-        return converter.StringToDouble(input.data(), static_cast<int>(input.size()), &processed);
-    }
+    constexpr size_t kMaxPendingReplayResults = 1024;
 
-    int64_t ToInteger(std::string_view input) noexcept
+    uint64_t GetUnixTimeMs() noexcept
     {
-        return static_cast<int64_t>(ToDouble(input));
+        return static_cast<uint64_t>(chrono::duration_cast<chrono::milliseconds>(
+            chrono::system_clock::now().time_since_epoch()).count());
     }
-
-    class MetricsParseListener :
-        public MetricsParser::IListener
-    {
-    public:
-        MetricsParseListener(MetricsSampleThread::RawMetrics& raw)
-            : m_stRawMetrics(raw) {}
-
-    protected: // MetricsParseListener
-        void OnMetricsBegin(std::string_view name) override
-        {
-            m_stCurrentMetricsName = name;
-        }
-
-        void OnMetricsLabel(std::string_view name, std::string_view value) override
-        {
-            if (m_stCurrentMetricsName == "node_cpu_seconds_total")
-            {
-                if (name == "cpu")
-                    m_iCurrentCpuIndex = static_cast<int>(ToInteger(value));
-                else if (name == "mode")
-                    m_stCurrentCpuMode = value;
-            }
-            else if (m_stCurrentMetricsName == "node_disk_io_time_seconds_total" ||
-                m_stCurrentMetricsName == "node_disk_read_time_seconds_total" ||
-                m_stCurrentMetricsName == "node_disk_write_time_seconds_total" ||
-                m_stCurrentMetricsName == "node_disk_read_bytes_total" ||
-                m_stCurrentMetricsName == "node_disk_written_bytes_total" ||
-                m_stCurrentMetricsName == "node_network_receive_bytes_total" ||
-                m_stCurrentMetricsName == "node_network_transmit_bytes_total")
-            {
-                if (name == "device")
-                    m_stCurrentDeviceName = value;
-            }
-        }
-
-        void OnMetricsValue(std::string_view value) override
-        {
-            if (m_stCurrentMetricsName == "node_boot_time_seconds")
-            {
-                m_stRawMetrics.BootTimestamp = ToInteger(value);
-            }
-            else if (m_stCurrentMetricsName == "node_load1")
-            {
-                m_stRawMetrics.Load1 = ToDouble(value);
-            }
-            else if (m_stCurrentMetricsName == "node_load5")
-            {
-                m_stRawMetrics.Load5 = ToDouble(value);
-            }
-            else if (m_stCurrentMetricsName == "node_load15")
-            {
-                m_stRawMetrics.Load15 = ToDouble(value);
-            }
-            else if (m_stCurrentMetricsName == "node_memory_MemAvailable_bytes")
-            {
-                m_stRawMetrics.MemoryAvailableBytes = ToInteger(value);
-            }
-            else if (m_stCurrentMetricsName == "node_memory_MemTotal_bytes")
-            {
-                m_stRawMetrics.MemoryTotalBytes = ToInteger(value);
-            }
-            else if (m_stCurrentMetricsName == "node_memory_MemFree_bytes")
-            {
-                m_stRawMetrics.MemoryFreeBytes = ToInteger(value);
-            }
-            else if (m_stCurrentMetricsName == "node_cpu_seconds_total")
-            {
-                auto& cpuMetrics = m_stRawMetrics.CpuSecondsTotal[m_iCurrentCpuIndex];
-                if (m_stCurrentCpuMode == "idle")
-                    cpuMetrics.Idle = ToDouble(value);
-                else if (m_stCurrentCpuMode == "iowait")
-                    cpuMetrics.IoWait = ToDouble(value);
-                else if (m_stCurrentCpuMode == "irq")
-                    cpuMetrics.Irq = ToDouble(value);
-                else if (m_stCurrentCpuMode == "nice")
-                    cpuMetrics.Nice = ToDouble(value);
-                else if (m_stCurrentCpuMode == "softirq")
-                    cpuMetrics.SoftIrq = ToDouble(value);
-                else if (m_stCurrentCpuMode == "steal")
-                    cpuMetrics.Steal = ToDouble(value);
-                else if (m_stCurrentCpuMode == "system")
-                    cpuMetrics.System = ToDouble(value);
-                else if (m_stCurrentCpuMode == "user")
-                    cpuMetrics.User = ToDouble(value);
-                m_iCurrentCpuIndex = -1;
-                m_stCurrentCpuMode = {};
-            }
-            else if (m_stCurrentMetricsName == "node_disk_io_time_seconds_total")
-            {
-                m_stRawMetrics.DiskIoTimeSecondsTotal[m_stCurrentDeviceName] = ToDouble(value);
-                m_stCurrentDeviceName = {};
-            }
-            else if (m_stCurrentMetricsName == "node_disk_read_time_seconds_total")
-            {
-                m_stRawMetrics.DiskReadTimeSecondsTotal[m_stCurrentDeviceName] = ToDouble(value);
-                m_stCurrentDeviceName = {};
-            }
-            else if (m_stCurrentMetricsName == "node_disk_write_time_seconds_total")
-            {
-                m_stRawMetrics.DiskWriteTimeSecondsTotal[m_stCurrentDeviceName] = ToDouble(value);
-                m_stCurrentDeviceName = {};
-            }
-            else if (m_stCurrentMetricsName == "node_disk_read_bytes_total")
-            {
-                m_stRawMetrics.DiskReadBytesTotal[m_stCurrentDeviceName] = ToDouble(value);
-                m_stCurrentDeviceName = {};
-            }
-            else if (m_stCurrentMetricsName == "node_disk_written_bytes_total")
-            {
-                m_stRawMetrics.DiskWrittenBytesTotal[m_stCurrentDeviceName] = ToDouble(value);
-                m_stCurrentDeviceName = {};
-            }
-            else if (m_stCurrentMetricsName == "node_network_receive_bytes_total")
-            {
-                m_stRawMetrics.NetworkReceiveBytesTotal[m_stCurrentDeviceName] = ToDouble(value);
-                m_stCurrentDeviceName = {};
-            }
-            else if (m_stCurrentMetricsName == "node_network_transmit_bytes_total")
-            {
-                m_stRawMetrics.NetworkTransmitBytesTotal[m_stCurrentDeviceName] = ToDouble(value);
-                m_stCurrentDeviceName = {};
-            }
-        }
-
-        void OnMetricsEnd() override
-        {
-            m_stCurrentMetricsName = {};
-        }
-
-    private:
-        MetricsSampleThread::RawMetrics& m_stRawMetrics;
-
-        std::string_view m_stCurrentMetricsName;
-        int m_iCurrentCpuIndex = -1;
-        std::string m_stCurrentCpuMode;
-        std::string m_stCurrentDeviceName;
-    };
 }
 
 void MetricsSampleThread::Run()
 {
+    PSM_TRACE_THREAD_NAME("sampler");
     auto lastTick = ::SDL_GetTicks64();
     while (!m_bStopped)
     {
@@ -194,18 +53,81 @@ void MetricsSampleThread::Run()
                 spdlog::info("Changing URL to {}, refresh interval {}ms", changeUrlCmd.Url, changeUrlCmd.RefreshIntervalMs);
                 m_stUrl = changeUrlCmd.Url;
                 m_dRefreshIntervalMs = changeUrlCmd.RefreshIntervalMs;
+                m_dPrimeIntervalMs = changeUrlCmd.PrimeIntervalMs;
+
+                // 不同主机的计数器不可比较，重新建立基准并立即抓取
+                m_stLastRawMetrics.reset();
+                m_dRefreshTimerMs = m_dRefreshIntervalMs;
+            }
+            else if (std::holds_alternative<RecordCommand>(cmd))
+            {
+                auto& recordCmd = std::get<RecordCommand>(cmd);
+                m_pRecorder.reset();
+                if (!recordCmd.Path.empty())
+                {
+                    auto recorder = std::make_unique<MetricsCaptureWriter>();
+                    if (recorder->Open(recordCmd.Path))
+                        m_pRecorder = std::move(recorder);
+                }
+            }
+            else if (std::holds_alternative<ReplayCommand>(cmd))
+            {
+                auto& replayCmd = std::get<ReplayCommand>(cmd);
+                auto replayer = std::make_unique<MetricsCaptureReader>();
+                if (replayer->Open(replayCmd.Path))
+                {
+                    spdlog::info("Replaying {} ({})", replayCmd.Path, replayCmd.RealTime ? "real time" : "as fast as possible");
+                    m_pReplayer = std::move(replayer);
+                    m_bReplayRealTime = replayCmd.RealTime;
+                    m_bReplayLoop = replayCmd.Loop;
+                    m_uReplayStartTick = ::SDL_GetTicks64();
+                    m_uReplayFirstTimestampMs = 0;
+                    m_stPendingRecord.reset();
+                    m_stLastRawMetrics.reset();
+                }
+            }
+            else if (std::holds_alternative<ChangeDeviceFilterCommand>(cmd))
+            {
+                auto& filterCmd = std::get<ChangeDeviceFilterCommand>(cmd);
+                m_stDiskFilter = std::move(filterCmd.Disk);
+                m_stNetworkFilter = std::move(filterCmd.Network);
             }
         }
 
+        // 回放模式下不再抓取
+        if (m_pReplayer)
+        {
+            if (!ReplayMetrics())
+            {
+                spdlog::info("Replay finished");
+                m_pReplayer.reset();
+            }
+            else if (!m_bReplayRealTime)
+            {
+                // 尽快回放时仅在结果堆积过多时让出，避免无限占用内存
+                if (m_stResultQueue.size_approx() > kMaxPendingReplayResults)
+                    ::SDL_Delay(1);
+                continue;
+            }
+            ::SDL_Delay(10);
+            lastTick = ::SDL_GetTicks64();
+            continue;
+        }
+
         auto currentTick = ::SDL_GetTicks64();
         auto deltaTimeMs = static_cast<double>(currentTick - lastTick);
         lastTick = currentTick;
 
         m_dRefreshTimerMs += deltaTimeMs;
-        if (m_dRefreshTimerMs >= m_dRefreshIntervalMs)
+        if (!m_stUrl.empty() && m_dRefreshTimerMs >= m_dRefreshIntervalMs)
         {
             m_dRefreshTimerMs = 0.;
+            bool priming = !m_stLastRawMetrics || m_stLastRawMetrics->Tick == 0;
             RefreshMetrics();
+
+            // 刚建立基准时提前进行下一次抓取，使第一个结果不必等待完整的刷新间隔
+            if (priming && m_stLastRawMetrics && m_stLastRawMetrics->Tick != 0 && m_dPrimeIntervalMs > 0)
+                m_dRefreshTimerMs = std::max(0., m_dRefreshIntervalMs - m_dPrimeIntervalMs);
         }
 
         ::SDL_Delay(100);  // 10 FPS
@@ -224,43 +146,105 @@ bool MetricsSampleThread::TryDequeueResult(Result& result)
 
 void MetricsSampleThread::RefreshMetrics()
 {
-    RawMetrics rawMetrics;
+    static Uint64 kFrequency = ::SDL_GetPerformanceFrequency();
+    LatencyTimestamps timestamps;
+    auto fetchStart = timestamps.RequestStart = ::SDL_GetPerformanceCounter();
+    std::optional<std::string> body;
+    {
+        PSM_TRACE_SCOPE("Fetch");
+        body = FetchMetrics(timestamps.FirstByte);
+    }
+    auto fetchSeconds = static_cast<double>(::SDL_GetPerformanceCounter() - fetchStart) / static_cast<double>(kFrequency);
+
+    SelfMetrics::ObserveScrape(fetchSeconds, body.has_value());
 
-    // 发起 HTTP 请求
-    if (!m_stUrl.empty())
+    auto timestampMs = GetUnixTimeMs();
+    if (body && m_pRecorder)
     {
-        auto url = ada::parse(m_stUrl);
-        if (!url)
-        {
-            spdlog::error("Failed to parse URL: {}", m_stUrl);
-        }
-        else
+        if (!m_pRecorder->Append(timestampMs, *body))
+            m_pRecorder.reset();
+    }
+
+    ProcessMetrics(body ? &*body : nullptr, ::SDL_GetTicks64(), timestampMs, fetchSeconds, timestamps);
+}
+
+bool MetricsSampleThread::ReplayMetrics()
+{
+    static Uint64 kFrequency = ::SDL_GetPerformanceFrequency();
+
+    while (true)
+    {
+        // 读取下一条记录，读取与解压耗时计入抓取阶段
+        auto fetchStart = ::SDL_GetPerformanceCounter();
+        if (!m_stPendingRecord)
         {
-            httplib::Client client(fmt::format("{}//{}", url->get_protocol(), url->get_host()));
-            client.set_connection_timeout(5);
-            auto res = client.Get(fmt::format("{}", url->get_pathname()));
-            if (!res)
+            PSM_TRACE_SCOPE("ReadCapture");
+            MetricsCaptureRecord record;
+            if (!m_pReplayer->Next(record))
             {
-                spdlog::error("Failed to get URL: {}, error: {}", m_stUrl, static_cast<int>(res.error()));
+                if (!m_bReplayLoop)
+                    return false;
+
+                // 从头回放时时间轴与计数器都会回退，需要重新建立基准
+                m_pReplayer->Rewind();
+                m_uReplayStartTick = ::SDL_GetTicks64();
+                m_uReplayFirstTimestampMs = 0;
+                m_stLastRawMetrics.reset();
+                if (!m_pReplayer->Next(record))
+                    return false;
             }
-            else
-            {
-                auto status = res->status;
-                if (status != 200)
-                {
-                    spdlog::error("Failed to get URL: {}, status: {}", m_stUrl, status);
-                }
-                else
-                {
-                    const auto& body = res->body;
+            if (m_uReplayFirstTimestampMs == 0)
+                m_uReplayFirstTimestampMs = record.TimestampMs;
+            m_stPendingRecord = std::move(record);
+        }
+        auto fetchSeconds = static_cast<double>(::SDL_GetPerformanceCounter() - fetchStart) / static_cast<double>(kFrequency);
 
-                    MetricsParseListener listener(rawMetrics);
-                    MetricsParser::Parse(body, &listener);
-                    rawMetrics.Tick = ::SDL_GetTicks64();
-                }
-            }
+        if (m_bReplayRealTime)
+        {
+            auto elapsed = ::SDL_GetTicks64() - m_uReplayStartTick;
+            auto due = m_stPendingRecord->TimestampMs > m_uReplayFirstTimestampMs ?
+                m_stPendingRecord->TimestampMs - m_uReplayFirstTimestampMs : 0;
+            if (due > elapsed)
+                return true;
         }
+
+        auto record = std::move(*m_stPendingRecord);
+        m_stPendingRecord.reset();
+
+        // 使用记录时间计算速率，与回放速度无关
+        LatencyTimestamps timestamps;
+        timestamps.RequestStart = fetchStart;
+        timestamps.FirstByte = ::SDL_GetPerformanceCounter();
+        ProcessMetrics(&record.Body, record.TimestampMs, record.TimestampMs, fetchSeconds, timestamps);
+        if (!m_bReplayRealTime)
+            return true;
+    }
+}
+
+void MetricsSampleThread::ProcessMetrics(const std::string* body, uint64_t tick, uint64_t timestampMs, double fetchSeconds,
+    LatencyTimestamps timestamps)
+{
+    static Uint64 kFrequency = ::SDL_GetPerformanceFrequency();
+    auto phaseTick = ::SDL_GetPerformanceCounter();
+    auto endPhase = [&]() {
+        auto now = ::SDL_GetPerformanceCounter();
+        auto seconds = static_cast<double>(now - phaseTick) / static_cast<double>(kFrequency);
+        phaseTick = now;
+        return seconds;
+    };
+
+    RawMetrics rawMetrics;
+    if (body)
+    {
+        PSM_TRACE_SCOPE("Parse");
+        ParseMetrics(*body, rawMetrics, &m_stDiskFilter, &m_stNetworkFilter);
+        rawMetrics.Tick = tick;
+        rawMetrics.TimestampMs = timestampMs;
     }
+    auto parseSeconds = endPhase();
+    if (body)
+        SelfMetrics::ObserveParse(body->size(), parseSeconds);
+    timestamps.ParseEnd = phaseTick;
 
     // 从 rawMetrics 产生处理后的结果
     if (!m_stLastRawMetrics)
@@ -270,8 +254,80 @@ void MetricsSampleThread::RefreshMetrics()
     }
 
     MetricsResult metrics;
+    {
+        PSM_TRACE_SCOPE("Compute");
+        ComputeMetrics(rawMetrics, *m_stLastRawMetrics, metrics);
+    }
+    m_stLastRawMetrics = std::move(rawMetrics);
+
+    metrics.FetchSeconds = fetchSeconds;
+    metrics.ParseSeconds = parseSeconds;
+    metrics.ComputeSeconds = endPhase();
+    metrics.Timestamps = timestamps;
+
+    // 推送 Metrics
+    metrics.Timestamps.Enqueue = ::SDL_GetPerformanceCounter();
+    {
+        PSM_TRACE_SCOPE("Enqueue");
+        m_stResultQueue.enqueue(std::move(metrics));
+    }
+    SelfMetrics::ObserveResultEnqueued();
+}
+
+std::optional<std::string> MetricsSampleThread::FetchMetrics(uint64_t& firstByteTick)
+{
+    if (m_stUrl.empty())
+        return {};
+
+    auto url = ada::parse(m_stUrl);
+    if (!url)
+    {
+        spdlog::error("Failed to parse URL: {}", m_stUrl);
+        return {};
+    }
+
+    httplib::Client client(fmt::format("{}//{}", url->get_protocol(), url->get_host()));
+    client.set_connection_timeout(5);
+
+    // 自行接收响应体，以便记录收到响应头的时间
+    std::string body;
+    auto res = client.Get(fmt::format("{}", url->get_pathname()),
+        [&](const httplib::Response&) {
+            firstByteTick = ::SDL_GetPerformanceCounter();
+            return true;
+        },
+        [&](const char* data, size_t length) {
+            body.append(data, length);
+            return true;
+        });
+    if (!res)
+    {
+        spdlog::error("Failed to get URL: {}, error: {}", m_stUrl, static_cast<int>(res.error()));
+        return {};
+    }
+
+    auto status = res->status;
+    if (status != 200)
+    {
+        spdlog::error("Failed to get URL: {}, status: {}", m_stUrl, status);
+        return {};
+    }
+    return body;
+}
+
+void MetricsSampleThread::ParseMetrics(const std::string& body, RawMetrics& raw, const DeviceFilter* diskFilter,
+    const DeviceFilter* networkFilter)
+{
+    MetricsParseListener listener(raw, diskFilter, networkFilter);
+    MetricsParser::Parse(body, &listener);
+}
+
+void MetricsSampleThread::ComputeMetrics(const RawMetrics& rawMetrics, const RawMetrics& last, MetricsResult& metrics)
+{
     metrics.Tick = rawMetrics.Tick;
-    metrics.BootTimeSeconds = rawMetrics.BootTimestamp == 0 ? 0 : static_cast<double>(::time(nullptr) - rawMetrics.BootTimestamp);
+    metrics.TimestampMs = rawMetrics.TimestampMs;
+    metrics.BootTimeSeconds = rawMetrics.BootTimestamp == 0 ? 0 :
+        static_cast<double>(rawMetrics.TimestampMs / 1000) - static_cast<double>(rawMetrics.BootTimestamp);
     metrics.Load1 = rawMetrics.Load1;
     metrics.Load5 = rawMetrics.Load5;
     metrics.Load15 = rawMetrics.Load15;
@@ -279,8 +335,28 @@ void MetricsSampleThread::RefreshMetrics()
     metrics.MemoryTotalBytes = rawMetrics.MemoryTotalBytes;
     metrics.MemoryFreeBytes = rawMetrics.MemoryFreeBytes;
 
+    // 内存构成与换页速率
+    auto& memory = metrics.Memory;
+    memory.AnonBytes = rawMetrics.MemoryAnonBytes;
+    memory.BuffersBytes = rawMetrics.MemoryBuffersBytes;
+    memory.CachedBytes = rawMetrics.MemoryCachedBytes;
+    memory.SwapTotalBytes = rawMetrics.SwapTotalBytes;
+    memory.SwapUsedBytes = rawMetrics.SwapTotalBytes - std::min(rawMetrics.SwapFreeBytes, rawMetrics.SwapTotalBytes);
+    memory.ZramOriginalBytes = rawMetrics.ZramOriginalBytes;
+    memory.ZramCompressedBytes = rawMetrics.ZramCompressedBytes;
+    if (rawMetrics.HasVmstat && last.HasVmstat && rawMetrics.Tick > last.Tick)
+    {
+        auto scale = 1000. / static_cast<double>(rawMetrics.Tick - last.Tick);
+        memory.MajorFaultsPerSecond = std::max(0., rawMetrics.VmstatMajorFaults - last.VmstatMajorFaults) * scale;
+        memory.SwapInPagesPerSecond = std::max(0., rawMetrics.VmstatSwapIn - last.VmstatSwapIn) * scale;
+        memory.SwapOutPagesPerSecond = std::max(0., rawMetrics.VmstatSwapOut - last.VmstatSwapOut) * scale;
+        metrics.HasVmstat = true;
+    }
+
     // 计算 CPU 占用
     size_t lastFillIndex = 0;
+    RawCpuMetrics modeDelta;
+    double totalDelta = 0;
     for (const auto& [cpuIndex, cpuMetrics] : rawMetrics.CpuSecondsTotal)
     {
         // 由于 CpuSecondsTotal 使用 map 存储，因此保证从小到大排序
@@ -291,8 +367,8 @@ void MetricsSampleThread::RefreshMetrics()
         }
 
         // 查找上次的 CPU 时间
-        auto it = m_stLastRawMetrics->CpuSecondsTotal.find(cpuIndex);
-        if (it == m_stLastRawMetrics->CpuSecondsTotal.end())
+        auto it = last.CpuSecondsTotal.find(cpuIndex);
+        if (it == last.CpuSecondsTotal.end())
             continue;
 
         // 计算时间
@@ -303,53 +379,121 @@ void MetricsSampleThread::RefreshMetrics()
         // 记录
         metrics.CpuUsage.push_back(cpuUsage);
         ++lastFillIndex;
+
+        // 累计各模式时间，计数器回绕或重置时跳过该核心
+        if (cpuTotalSecondsDelta > 0)
+        {
+            const auto& lastCpu = it->second;
+            modeDelta.User += std::max(0., cpuMetrics.User - lastCpu.User);
+            modeDelta.Nice += std::max(0., cpuMetrics.Nice - lastCpu.Nice);
+            modeDelta.System += std::max(0., cpuMetrics.System - lastCpu.System);
+            modeDelta.IoWait += std::max(0., cpuMetrics.IoWait - lastCpu.IoWait);
+            modeDelta.Irq += std::max(0., cpuMetrics.Irq - lastCpu.Irq);
+            modeDelta.SoftIrq += std::max(0., cpuMetrics.SoftIrq - lastCpu.SoftIrq);
+            modeDelta.Steal += std::max(0., cpuMetrics.Steal - lastCpu.Steal);
+            totalDelta += cpuTotalSecondsDelta;
+        }
+    }
+    if (totalDelta > 0)
+    {
+        auto scale = 100. / totalDelta;
+        metrics.CpuModes.User = modeDelta.User * scale;
+        metrics.CpuModes.Nice = modeDelta.Nice * scale;
+        metrics.CpuModes.System = modeDelta.System * scale;
+        metrics.CpuModes.IoWait = modeDelta.IoWait * scale;
+        metrics.CpuModes.Irq = modeDelta.Irq * scale;
+        metrics.CpuModes.SoftIrq = modeDelta.SoftIrq * scale;
+        metrics.CpuModes.Steal = modeDelta.Steal * scale;
+    }
+
+    // 计算 PSI，阻塞时间的增量除以采样间隔
+    if (rawMetrics.HasPressure && last.HasPressure && rawMetrics.Tick > last.Tick)
+    {
+        auto scale = 100. * 1000. / static_cast<double>(rawMetrics.Tick - last.Tick);
+        auto stallRatio = [scale](double current, double previous) {
+            return std::clamp((current - previous) * scale, 0., 100.);
+        };
+        const auto& current = rawMetrics.PressureSecondsTotal;
+        const auto& previous = last.PressureSecondsTotal;
+        metrics.Pressure.CpuSome = stallRatio(current.CpuWaiting, previous.CpuWaiting);
+        metrics.Pressure.CpuFull = stallRatio(current.CpuStalled, previous.CpuStalled);
+        metrics.Pressure.MemorySome = stallRatio(current.MemoryWaiting, previous.MemoryWaiting);
+        metrics.Pressure.MemoryFull = stallRatio(current.MemoryStalled, previous.MemoryStalled);
+        metrics.Pressure.IoSome = stallRatio(current.IoWaiting, previous.IoWaiting);
+        metrics.Pressure.IoFull = stallRatio(current.IoStalled, previous.IoStalled);
+        metrics.HasPressure = true;
     }
 
     // 计算磁盘占用
     for (const auto& [device, value] : rawMetrics.DiskReadBytesTotal)
     {
-        auto it = m_stLastRawMetrics->DiskReadBytesTotal.find(device);
-        if (it == m_stLastRawMetrics->DiskReadBytesTotal.end())
+        auto it = last.DiskReadBytesTotal.find(device);
+        if (it == last.DiskReadBytesTotal.end())
             continue;
 
         auto delta = value - it->second;
-        auto deltaTickMs = static_cast<double>(rawMetrics.Tick - m_stLastRawMetrics->Tick);
+        auto deltaTickMs = static_cast<double>(rawMetrics.Tick - last.Tick);
         metrics.DiskReadBytesPerSecond[device] = static_cast<double>(delta) / static_cast<double>(deltaTickMs / 1000);
     }
     for (const auto& [device, value] : rawMetrics.DiskWrittenBytesTotal)
     {
-        auto it = m_stLastRawMetrics->DiskWrittenBytesTotal.find(device);
-        if (it == m_stLastRawMetrics->DiskWrittenBytesTotal.end())
+        auto it = last.DiskWrittenBytesTotal.find(device);
+        if (it == last.DiskWrittenBytesTotal.end())
             continue;
 
         auto delta = value - it->second;
-        auto deltaTickMs = static_cast<double>(rawMetrics.Tick - m_stLastRawMetrics->Tick);
+        auto deltaTickMs = static_cast<double>(rawMetrics.Tick - last.Tick);
         metrics.DiskWrittenBytesPerSecond[device] = static_cast<double>(delta) / static_cast<double>(deltaTickMs / 1000);
     }
 
+    // 计算磁盘负载，计数器缺失或回退时该项记为 0
+    auto deltaSeconds = static_cast<double>(rawMetrics.Tick - last.Tick) / 1000.;
+    auto counterDelta = [](const std::map<std::string, double>& current, const std::map<std::string, double>& previous,
+        const std::string& device) {
+        auto it = current.find(device);
+        auto lastIt = previous.find(device);
+        if (it == current.end() || lastIt == previous.end())
+            return 0.;
+        return std::max(0., it->second - lastIt->second);
+    };
+    for (const auto& [device, _] : rawMetrics.DiskIoTimeSecondsTotal)
+    {
+        if (deltaSeconds <= 0 || last.DiskIoTimeSecondsTotal.find(device) == last.DiskIoTimeSecondsTotal.end())
+            continue;
+
+        auto reads = counterDelta(rawMetrics.DiskReadsCompletedTotal, last.DiskReadsCompletedTotal, device);
+        auto writes = counterDelta(rawMetrics.DiskWritesCompletedTotal, last.DiskWritesCompletedTotal, device);
+        auto& stats = metrics.Disks[device];
+        stats.Utilization = std::min(100., 100. * counterDelta(rawMetrics.DiskIoTimeSecondsTotal, last.DiskIoTimeSecondsTotal,
+            device) / deltaSeconds);
+        stats.ReadIops = reads / deltaSeconds;
+        stats.WriteIops = writes / deltaSeconds;
+        stats.ReadAwaitMs = reads > 0 ?
+            1000. * counterDelta(rawMetrics.DiskReadTimeSecondsTotal, last.DiskReadTimeSecondsTotal, device) / reads : 0.;
+        stats.WriteAwaitMs = writes > 0 ?
+            1000. * counterDelta(rawMetrics.DiskWriteTimeSecondsTotal, last.DiskWriteTimeSecondsTotal, device) / writes : 0.;
+        stats.QueueDepth = counterDelta(rawMetrics.DiskIoTimeWeightedSecondsTotal, last.DiskIoTimeWeightedSecondsTotal, device) /
+            deltaSeconds;
+    }
+
     for (const auto& [device, value] : rawMetrics.NetworkReceiveBytesTotal)
     {
-        auto it = m_stLastRawMetrics->NetworkReceiveBytesTotal.find(device);
-        if (it == m_stLastRawMetrics->NetworkReceiveBytesTotal.end())
+        auto it = last.NetworkReceiveBytesTotal.find(device);
+        if (it == last.NetworkReceiveBytesTotal.end())
             continue;
 
         auto delta = value - it->second;
-        auto deltaTickMs = static_cast<double>(rawMetrics.Tick - m_stLastRawMetrics->Tick);
+        auto deltaTickMs = static_cast<double>(rawMetrics.Tick - last.Tick);
         metrics.NetworkReceiveBytesPerSecond[device] = static_cast<double>(delta) / static_cast<double>(deltaTickMs / 1000);
     }
     for (const auto& [device, value] : rawMetrics.NetworkTransmitBytesTotal)
     {
-        auto it = m_stLastRawMetrics->NetworkTransmitBytesTotal.find(device);
-        if (it == m_stLastRawMetrics->NetworkTransmitBytesTotal.end())
+        auto it = last.NetworkTransmitBytesTotal.find(device);
+        if (it == last.NetworkTransmitBytesTotal.end())
             continue;
 
         auto delta = value - it->second;
-        auto deltaTickMs = static_cast<double>(rawMetrics.Tick - m_stLastRawMetrics->Tick);
+        auto deltaTickMs = static_cast<double>(rawMetrics.Tick - last.Tick);
         metrics.NetworkTransmitBytesPerSecond[device] = static_cast<double>(delta) / static_cast<double>(deltaTickMs / 1000);
     }
-
-    m_stLastRawMetrics = std::move(rawMetrics);
-
-    // 推送 Metrics
-    m_stResultQueue.enqueue(std::move(metrics));
 }
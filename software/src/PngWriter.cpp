@@ -0,0 +1,102 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <PngWriter.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <zlib.h>
+#include <spdlog/spdlog.h>
+
+using namespace std;
+
+namespace
+{
+    void AppendU32BE(std::vector<uint8_t>& out, uint32_t value)
+    {
+        out.push_back(static_cast<uint8_t>(value >> 24));
+        out.push_back(static_cast<uint8_t>(value >> 16));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    void AppendChunk(std::vector<uint8_t>& out, const char type[4], const uint8_t* data, size_t size)
+    {
+        AppendU32BE(out, static_cast<uint32_t>(size));
+        auto crcStart = out.size();
+        out.insert(out.end(), type, type + 4);
+        if (size)
+            out.insert(out.end(), data, data + size);
+        auto crc = ::crc32(0, out.data() + crcStart, static_cast<uInt>(out.size() - crcStart));
+        AppendU32BE(out, static_cast<uint32_t>(crc));
+    }
+}
+
+Result<void> PngWriter::WriteRGB565(const std::string& path, const uint16_t* pixels, int width, int height,
+    int stride) noexcept
+{
+    try
+    {
+        // 扫描线：每行前置过滤类型 0，RGB565 扩展为 RGB888
+        std::vector<uint8_t> raw;
+        raw.reserve(static_cast<size_t>(height) * (1 + static_cast<size_t>(width) * 3));
+        for (int y = 0; y < height; ++y)
+        {
+            raw.push_back(0);
+            const auto* row = pixels + static_cast<size_t>(y) * stride;
+            for (int x = 0; x < width; ++x)
+            {
+                auto c = row[x];
+                uint32_t r = (c >> 11) & 0x1F, g = (c >> 5) & 0x3F, b = c & 0x1F;
+                raw.push_back(static_cast<uint8_t>((r << 3) | (r >> 2)));
+                raw.push_back(static_cast<uint8_t>((g << 2) | (g >> 4)));
+                raw.push_back(static_cast<uint8_t>((b << 3) | (b >> 2)));
+            }
+        }
+
+        auto compressedSize = ::compressBound(static_cast<uLong>(raw.size()));
+        std::vector<uint8_t> compressed(compressedSize);
+        if (::compress2(compressed.data(), &compressedSize, raw.data(), static_cast<uLong>(raw.size()), Z_BEST_SPEED) != Z_OK)
+        {
+            spdlog::error("Failed to compress PNG data");
+            return make_error_code(errc::io_error);
+        }
+
+        static const uint8_t kSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        std::vector<uint8_t> out(kSignature, kSignature + sizeof(kSignature));
+
+        std::vector<uint8_t> header;
+        AppendU32BE(header, static_cast<uint32_t>(width));
+        AppendU32BE(header, static_cast<uint32_t>(height));
+        header.push_back(8);  // 位深
+        header.push_back(2);  // RGB
+        header.push_back(0);  // 压缩方式
+        header.push_back(0);  // 过滤方式
+        header.push_back(0);  // 非隔行
+        AppendChunk(out, "IHDR", header.data(), header.size());
+        AppendChunk(out, "IDAT", compressed.data(), compressedSize);
+        AppendChunk(out, "IEND", nullptr, 0);
+
+        auto* fp = ::fopen(path.c_str(), "wb");
+        if (!fp)
+        {
+            spdlog::error("Failed to open {}: {}", path, ::strerror(errno));
+            return error_code(errno, system_category());
+        }
+        auto written = ::fwrite(out.data(), 1, out.size(), fp);
+        ::fclose(fp);
+        if (written != out.size())
+        {
+            spdlog::error("Failed to write {}", path);
+            return make_error_code(errc::io_error);
+        }
+        return {};
+    }
+    catch (const std::bad_alloc&)
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+}
@@ -0,0 +1,150 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <PrebakedFontAtlas.hpp>
+
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <spdlog/spdlog.h>
+
+using namespace std;
+
+static_assert(std::endian::native == std::endian::little, "Prebaked font atlas is stored in little endian");
+
+namespace
+{
+    class BlobReader
+    {
+    public:
+        BlobReader(const void* data, size_t size) noexcept
+            : m_pData(static_cast<const uint8_t*>(data)), m_uSize(size) {}
+
+    public:
+        template <typename T>
+        bool Read(T& out) noexcept
+        {
+            if (m_uSize - m_uOffset < sizeof(T))
+                return false;
+            ::memcpy(&out, m_pData + m_uOffset, sizeof(T));
+            m_uOffset += sizeof(T);
+            return true;
+        }
+
+        const uint8_t* Take(size_t size) noexcept
+        {
+            if (m_uSize - m_uOffset < size)
+                return nullptr;
+            auto p = m_pData + m_uOffset;
+            m_uOffset += size;
+            return p;
+        }
+
+    private:
+        const uint8_t* m_pData = nullptr;
+        size_t m_uSize = 0;
+        size_t m_uOffset = 0;
+    };
+}
+
+Result<void> PrebakedFontAtlas::Load(ImFontAtlas* atlas, const void* data, size_t size) noexcept
+{
+    assert(atlas->Fonts.empty());
+
+    BlobReader reader(data, size);
+    uint32_t magic = 0, version = 0, texWidth = 0, texHeight = 0, linesCount = 0, fontCount = 0;
+    ImVec2 whitePixel;
+    if (!reader.Read(magic) || magic != kMagic || !reader.Read(version) || version != kVersion)
+    {
+        spdlog::error("Invalid prebaked font atlas header");
+        return make_error_code(errc::invalid_argument);
+    }
+    if (!reader.Read(texWidth) || !reader.Read(texHeight) || !reader.Read(whitePixel) || !reader.Read(linesCount) ||
+        linesCount != IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1)
+    {
+        spdlog::error("Prebaked font atlas does not match this ImGui build");
+        return make_error_code(errc::invalid_argument);
+    }
+
+    ImVec4 uvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+    for (auto& line : uvLines)
+    {
+        if (!reader.Read(line))
+            return make_error_code(errc::invalid_argument);
+    }
+    if (!reader.Read(fontCount) || fontCount != static_cast<uint32_t>(FontId::Count))
+    {
+        spdlog::error("Prebaked font atlas contains {} font(s), expect {}", fontCount, static_cast<int>(FontId::Count));
+        return make_error_code(errc::invalid_argument);
+    }
+
+    // 先放置全部 ConfigData，避免扩容导致 ImFont::ConfigData 失效
+    // 字体数据已经烘焙，FontData 为空且不会再被 Build() 使用
+    atlas->ConfigData.resize(static_cast<int>(fontCount));
+    for (uint32_t i = 0; i < fontCount; ++i)
+    {
+        auto& cfg = atlas->ConfigData[static_cast<int>(i)];
+        cfg = ImFontConfig();
+        cfg.FontDataOwnedByAtlas = false;
+        cfg.SizePixels = kFonts[i].SizePixels;
+        ::snprintf(cfg.Name, sizeof(cfg.Name), "%s, %.1fpx", kFonts[i].AssetName, kFonts[i].SizePixels);
+    }
+
+    for (uint32_t i = 0; i < fontCount; ++i)
+    {
+        auto* font = IM_NEW(ImFont);
+        atlas->Fonts.push_back(font);
+
+        auto& cfg = atlas->ConfigData[static_cast<int>(i)];
+        cfg.DstFont = font;
+        font->ContainerAtlas = atlas;
+        font->ConfigData = &cfg;
+        font->ConfigDataCount = 1;
+
+        uint32_t glyphCount = 0;
+        if (!reader.Read(font->FontSize) || !reader.Read(font->Ascent) || !reader.Read(font->Descent) ||
+            !reader.Read(glyphCount))
+        {
+            atlas->Clear();
+            return make_error_code(errc::invalid_argument);
+        }
+
+        font->Glyphs.reserve(static_cast<int>(glyphCount));
+        for (uint32_t j = 0; j < glyphCount; ++j)
+        {
+            uint32_t codepoint = 0;
+            float values[9];
+            if (!reader.Read(codepoint) || !reader.Read(values))
+            {
+                atlas->Clear();
+                return make_error_code(errc::invalid_argument);
+            }
+
+            // 传入 nullptr 配置以保持烘焙时已对齐的坐标与步进
+            font->AddGlyph(nullptr, static_cast<ImWchar>(codepoint), values[1], values[2], values[3], values[4],
+                values[5], values[6], values[7], values[8], values[0]);
+        }
+        font->BuildLookupTable();
+    }
+
+    auto* pixels = reader.Take(static_cast<size_t>(texWidth) * texHeight);
+    if (!pixels)
+    {
+        atlas->Clear();
+        return make_error_code(errc::invalid_argument);
+    }
+
+    atlas->ClearTexData();
+    atlas->TexPixelsAlpha8 = static_cast<unsigned char*>(IM_ALLOC(static_cast<size_t>(texWidth) * texHeight));
+    ::memcpy(atlas->TexPixelsAlpha8, pixels, static_cast<size_t>(texWidth) * texHeight);
+    atlas->TexWidth = static_cast<int>(texWidth);
+    atlas->TexHeight = static_cast<int>(texHeight);
+    atlas->TexUvScale = ImVec2(1.0f / static_cast<float>(texWidth), 1.0f / static_cast<float>(texHeight));
+    atlas->TexUvWhitePixel = whitePixel;
+    for (int i = 0; i <= IM_DRAWLIST_TEX_LINES_WIDTH_MAX; ++i)
+        atlas->TexUvLines[i] = uvLines[i];
+    atlas->TexReady = true;
+    return {};
+}
@@ -0,0 +1,160 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <QuantileSketch.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace std;
+
+QuantileSketch::QuantileSketch(double relativeAccuracy) noexcept
+    : m_dRelativeAccuracy(std::clamp(relativeAccuracy, 1e-4, 0.5))
+{
+    m_dGamma = (1 + m_dRelativeAccuracy) / (1 - m_dRelativeAccuracy);
+    m_dInvLogGamma = 1. / std::log(m_dGamma);
+}
+
+void QuantileSketch::Add(double value)
+{
+    if (m_uCount == 0)
+    {
+        m_dMin = m_dMax = value;
+    }
+    else
+    {
+        m_dMin = std::min(m_dMin, value);
+        m_dMax = std::max(m_dMax, value);
+    }
+    ++m_uCount;
+
+    if (!(value >= kMinPositiveValue))
+    {
+        ++m_uZeroCount;
+        return;
+    }
+
+    auto key = GetKey(value);
+    if (m_stBins.empty() || key < m_iMinKey || key >= m_iMinKey + static_cast<int32_t>(m_stBins.size()))
+        key = std::max(key, Extend(key, key));
+    ++m_stBins[static_cast<size_t>(key - m_iMinKey)];
+}
+
+void QuantileSketch::Merge(const QuantileSketch& other)
+{
+    assert(other.m_dGamma == m_dGamma);
+    if (other.m_uCount == 0)
+        return;
+
+    if (m_uCount == 0)
+    {
+        m_dMin = other.m_dMin;
+        m_dMax = other.m_dMax;
+    }
+    else
+    {
+        m_dMin = std::min(m_dMin, other.m_dMin);
+        m_dMax = std::max(m_dMax, other.m_dMax);
+    }
+    m_uCount += other.m_uCount;
+    m_uZeroCount += other.m_uZeroCount;
+
+    if (other.m_stBins.empty())
+        return;
+    auto otherMaxKey = other.m_iMinKey + static_cast<int32_t>(other.m_stBins.size()) - 1;
+    auto minKey = Extend(other.m_iMinKey, otherMaxKey);
+    for (size_t i = 0; i < other.m_stBins.size(); ++i)
+    {
+        auto key = std::max(minKey, other.m_iMinKey + static_cast<int32_t>(i));
+        m_stBins[static_cast<size_t>(key - m_iMinKey)] += other.m_stBins[i];
+    }
+}
+
+void QuantileSketch::Clear() noexcept
+{
+    std::fill(m_stBins.begin(), m_stBins.end(), 0);
+    m_uZeroCount = 0;
+    m_uCount = 0;
+    m_dMin = m_dMax = 0;
+}
+
+double QuantileSketch::GetQuantile(double q) const noexcept
+{
+    if (m_uCount == 0)
+        return 0;
+
+    auto rank = static_cast<uint64_t>(std::clamp(q, 0., 1.) * static_cast<double>(m_uCount - 1));
+    if (rank < m_uZeroCount)
+        return std::clamp(0., m_dMin, m_dMax);
+
+    uint64_t seen = m_uZeroCount;
+    for (size_t i = 0; i < m_stBins.size(); ++i)
+    {
+        seen += m_stBins[i];
+        if (seen > rank)
+            return std::clamp(GetValue(m_iMinKey + static_cast<int32_t>(i)), m_dMin, m_dMax);
+    }
+    return m_dMax;
+}
+
+int32_t QuantileSketch::GetKey(double value) const noexcept
+{
+    return static_cast<int32_t>(std::ceil(std::log(value) * m_dInvLogGamma));
+}
+
+double QuantileSketch::GetValue(int32_t key) const noexcept
+{
+    // 桶 (γ^(k-1), γ^k] 中相对误差最小的代表值
+    return 2 * std::pow(m_dGamma, key) / (m_dGamma + 1);
+}
+
+int32_t QuantileSketch::Extend(int32_t minKey, int32_t maxKey)
+{
+    if (m_stBins.empty())
+    {
+        // 预留一定余量，避免数值缓慢变化时反复扩展
+        static const int32_t kInitialMargin = 16;
+        minKey = std::max(minKey - kInitialMargin, maxKey - static_cast<int32_t>(kMaxBins) + 1);
+        m_iMinKey = minKey;
+        m_stBins.assign(static_cast<size_t>(maxKey - minKey + 1), 0);
+        return m_iMinKey;
+    }
+
+    auto currentMaxKey = m_iMinKey + static_cast<int32_t>(m_stBins.size()) - 1;
+    auto newMinKey = std::min(minKey, m_iMinKey);
+    auto newMaxKey = std::max(maxKey, currentMaxKey);
+
+    // 超出上限时将最小的一端合并到新的最小桶中
+    newMinKey = std::max(newMinKey, newMaxKey - static_cast<int32_t>(kMaxBins) + 1);
+
+    if (newMinKey > m_iMinKey)
+    {
+        uint32_t collapsed = 0;
+        auto dropCount = static_cast<size_t>(std::min(newMinKey, currentMaxKey + 1) - m_iMinKey);
+        for (size_t i = 0; i < dropCount; ++i)
+            collapsed += m_stBins[i];
+        m_stBins.erase(m_stBins.begin(), m_stBins.begin() + static_cast<ptrdiff_t>(dropCount));
+        m_iMinKey += static_cast<int32_t>(dropCount);
+        if (m_iMinKey < newMinKey)
+        {
+            // 原有的桶全部被合并
+            m_stBins.clear();
+            m_iMinKey = newMinKey;
+        }
+        if (m_stBins.empty())
+            m_stBins.push_back(0);
+        m_stBins.front() += collapsed;
+    }
+    else if (newMinKey < m_iMinKey)
+    {
+        m_stBins.insert(m_stBins.begin(), static_cast<size_t>(m_iMinKey - newMinKey), 0);
+        m_iMinKey = newMinKey;
+    }
+
+    if (newMaxKey > m_iMinKey + static_cast<int32_t>(m_stBins.size()) - 1)
+        m_stBins.resize(static_cast<size_t>(newMaxKey - m_iMinKey + 1), 0);
+    return m_iMinKey;
+}
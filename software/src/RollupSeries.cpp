@@ -0,0 +1,138 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <RollupSeries.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+using namespace std;
+
+namespace
+{
+    constexpr uint64_t kTierWidthMs[] = { 60 * 1000, 10 * 60 * 1000 };
+    constexpr size_t kTierCapacity[] = { 24 * 60, 7 * 24 * 6 };
+
+    static_assert(std::size(kTierWidthMs) == static_cast<size_t>(RollupSeries::Tier::Count));
+    static_assert(std::size(kTierCapacity) == static_cast<size_t>(RollupSeries::Tier::Count));
+}
+
+uint64_t RollupSeries::GetTierWidthMs(Tier tier) noexcept
+{
+    assert(tier < Tier::Count);
+    return kTierWidthMs[static_cast<size_t>(tier)];
+}
+
+size_t RollupSeries::GetTierCapacity(Tier tier) noexcept
+{
+    assert(tier < Tier::Count);
+    return kTierCapacity[static_cast<size_t>(tier)];
+}
+
+RollupSeries::Tier RollupSeries::SelectTier(uint64_t spanMs, size_t maxPoints) noexcept
+{
+    for (size_t i = 0; i < static_cast<size_t>(Tier::Count); ++i)
+    {
+        auto points = (spanMs + kTierWidthMs[i] - 1) / kTierWidthMs[i];
+        if (points <= maxPoints && points <= kTierCapacity[i])
+            return static_cast<Tier>(i);
+    }
+    return static_cast<Tier>(static_cast<size_t>(Tier::Count) - 1);
+}
+
+RollupSeries::RollupSeries()
+{
+    for (size_t i = 0; i < m_stTiers.size(); ++i)
+        m_stTiers[i].Buckets.resize(kTierCapacity[i]);
+}
+
+void RollupSeries::Append(uint64_t timestampMs, double value) noexcept
+{
+    for (size_t i = 0; i < m_stTiers.size(); ++i)
+    {
+        auto& ring = m_stTiers[i];
+        auto capacity = ring.Buckets.size();
+        auto startMs = timestampMs - timestampMs % kTierWidthMs[i];
+
+        // 时钟回拨时并入最新的桶，不破坏时间顺序
+        if (ring.Count > 0)
+        {
+            auto& newest = ring.Buckets[(ring.Head + ring.Count - 1) % capacity];
+            if (startMs <= newest.StartMs)
+            {
+                newest.Min = std::min(newest.Min, value);
+                newest.Max = std::max(newest.Max, value);
+                newest.Sum += value;
+                newest.Last = value;
+                ++newest.Count;
+                continue;
+            }
+        }
+
+        // 开始新桶，满时覆盖最旧的桶
+        size_t index;
+        if (ring.Count < capacity)
+        {
+            index = (ring.Head + ring.Count) % capacity;
+            ++ring.Count;
+        }
+        else
+        {
+            index = ring.Head;
+            ring.Head = (ring.Head + 1) % capacity;
+        }
+        ring.Buckets[index] = { startMs, value, value, value, value, 1 };
+    }
+}
+
+void RollupSeries::Assign(Tier tier, const Bucket* buckets, size_t count) noexcept
+{
+    auto& ring = m_stTiers[static_cast<size_t>(tier)];
+    auto capacity = ring.Buckets.size();
+    if (count > capacity)
+    {
+        buckets += count - capacity;
+        count = capacity;
+    }
+    std::copy(buckets, buckets + count, ring.Buckets.begin());
+    ring.Head = 0;
+    ring.Count = count;
+}
+
+const RollupSeries::Bucket& RollupSeries::GetBucket(Tier tier, size_t index) const noexcept
+{
+    const auto& ring = m_stTiers[static_cast<size_t>(tier)];
+    assert(index < ring.Count);
+    return ring.Buckets[(ring.Head + index) % ring.Buckets.size()];
+}
+
+void RollupSeries::CopyRecent(Tier tier, uint64_t endMs, size_t count, std::vector<double>& min, std::vector<double>& max,
+    std::vector<double>& average) const
+{
+    min.assign(count, numeric_limits<double>::quiet_NaN());
+    max.assign(count, numeric_limits<double>::quiet_NaN());
+    average.assign(count, numeric_limits<double>::quiet_NaN());
+    if (count == 0)
+        return;
+
+    auto widthMs = GetTierWidthMs(tier);
+    auto lastStartMs = endMs - endMs % widthMs;
+    auto firstStartMs = lastStartMs - std::min(lastStartMs / widthMs, static_cast<uint64_t>(count - 1)) * widthMs;
+
+    // 从最新的桶向前，晚于 endMs 的桶（时钟回拨）不显示
+    for (auto i = GetBucketCount(tier); i > 0; --i)
+    {
+        const auto& bucket = GetBucket(tier, i - 1);
+        if (bucket.StartMs < firstStartMs)
+            break;
+        if (bucket.StartMs > lastStartMs)
+            continue;
+        auto slot = count - 1 - static_cast<size_t>((lastStartMs - bucket.StartMs) / widthMs);
+        min[slot] = bucket.Min;
+        max[slot] = bucket.Max;
+        average[slot] = bucket.GetAverage();
+    }
+}
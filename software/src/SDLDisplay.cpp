@@ -0,0 +1,136 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <SDLDisplay.hpp>
+
+#include <spdlog/spdlog.h>
+#include <AppBase.hpp>
+#include <SDLError.hpp>
+#include <ImGuiSDL2Backend.hpp>
+#include <ImGuiOpenGLBackend.hpp>
+
+using namespace std;
+
+SDLDisplay::~SDLDisplay() noexcept
+{
+    if (m_bBackendInitialized)
+    {
+        ImGuiOpenGLBackend::Shutdown();
+        ImGuiSDL2Backend::Shutdown();
+    }
+
+    if (m_pGLContext)
+        ::SDL_GL_DeleteContext(m_pGLContext);
+    if (m_pMainWindow)
+        ::SDL_DestroyWindow(m_pMainWindow);
+}
+
+Result<void> SDLDisplay::Initialize(const AppBaseConfig& config) noexcept
+{
+    if (auto ret = ::SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_GAMECONTROLLER); ret != 0)
+    {
+        spdlog::error("SDL_Init failed: {}", ::SDL_GetError());
+        return MakeSDLError(ret);
+    }
+
+#ifdef SDL_HINT_IME_SHOW_UI
+    ::SDL_SetHint(SDL_HINT_IME_SHOW_UI, "1");
+#endif
+
+    ::SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+    ::SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
+    ::SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
+    ::SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 2);
+    ::SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 2);
+    auto windowFlags = SDL_WINDOW_OPENGL | SDL_WINDOW_ALLOW_HIGHDPI;
+    if (config.Resizable)
+        windowFlags |= SDL_WINDOW_RESIZABLE;
+    if (config.Borderless)
+        windowFlags |= SDL_WINDOW_BORDERLESS;
+    if (config.FullScreen)
+        windowFlags |= SDL_WINDOW_FULLSCREEN;
+    SDL_Window* window = ::SDL_CreateWindow(config.Title.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, config.InitialWidth,
+        config.InitialHeight, static_cast<SDL_WindowFlags>(windowFlags));
+    if (window == nullptr)
+    {
+        spdlog::error("SDL_CreateWindow failed: {}", ::SDL_GetError());
+        return MakeSDLError(-1);
+    }
+
+    SDL_GLContext glContext = ::SDL_GL_CreateContext(window);
+    if (glContext == nullptr)
+    {
+        spdlog::error("SDL_GL_CreateContext failed: {}", ::SDL_GetError());
+        ::SDL_DestroyWindow(window);
+        return MakeSDLError(-1);
+    }
+    ::SDL_GL_MakeCurrent(window, glContext);
+    ::SDL_GL_SetSwapInterval(1); // Enable vsync
+
+    ImGuiSDL2Backend::Initialize(window);
+    ImGuiOpenGLBackend::Initialize();
+
+    m_pMainWindow = window;
+    m_pGLContext = glContext;
+    m_bBackendInitialized = true;
+    return {};
+}
+
+void SDLDisplay::PollEvents(bool& exitRequest) noexcept
+{
+    // Poll and handle events (inputs, window resize, etc.)
+    // You can read the io.WantCaptureMouse, io.WantCaptureKeyboard flags to tell if dear imgui wants to use your inputs.
+    // - When io.WantCaptureMouse is true, do not dispatch mouse input data to your main application, or clear/overwrite your copy of the mouse data.
+    // - When io.WantCaptureKeyboard is true, do not dispatch keyboard input data to your main application, or clear/overwrite your copy of the keyboard data.
+    // Generally you may always pass all inputs to dear imgui, and hide them from your application based on those two flags.
+    ::SDL_Event event;
+    while (::SDL_PollEvent(&event))
+    {
+        ImGuiSDL2Backend::ProcessEvent(&event);
+        if (event.type == SDL_QUIT || (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_CLOSE &&
+            event.window.windowID == ::SDL_GetWindowID(m_pMainWindow)))
+        {
+            exitRequest = true;
+        }
+    }
+}
+
+bool SDLDisplay::IsSuspended() const noexcept
+{
+    return (::SDL_GetWindowFlags(m_pMainWindow) & SDL_WINDOW_MINIMIZED) != 0;
+}
+
+ImTextureID SDLDisplay::CreateTexture(int width, int height) noexcept
+{
+    return ImGuiOpenGLBackend::CreateTexture(width, height);
+}
+
+void SDLDisplay::UpdateTexture(ImTextureID texture, int x, int y, int width, int height, const uint32_t* pixels) noexcept
+{
+    ImGuiOpenGLBackend::UpdateTexture(texture, x, y, width, height, pixels);
+}
+
+void SDLDisplay::DestroyTexture(ImTextureID texture) noexcept
+{
+    ImGuiOpenGLBackend::DestroyTexture(texture);
+}
+
+void SDLDisplay::NewFrame() noexcept
+{
+    ImGuiOpenGLBackend::NewFrame();
+    ImGuiSDL2Backend::NewFrame();
+}
+
+void SDLDisplay::Render(ImDrawData* drawData) noexcept
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGuiOpenGLBackend::Clear(static_cast<int>(io.DisplaySize.x), static_cast<int>(io.DisplaySize.y));
+    ImGuiOpenGLBackend::RenderDrawData(drawData);
+}
+
+void SDLDisplay::Present() noexcept
+{
+    ::SDL_GL_SwapWindow(m_pMainWindow);
+}
@@ -0,0 +1,281 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <SelfMetrics.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+#include <fmt/format.h>
+#include <httplib.h>
+#include <spdlog/spdlog.h>
+
+using namespace std;
+
+namespace
+{
+    // 直方图桶上界（秒），覆盖从渲染阶段到网络请求的范围
+    constexpr std::array<double, 16> kBucketBounds = { 0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025,
+        0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10 };
+
+    /**
+     * 无锁直方图
+     */
+    struct Histogram
+    {
+        std::array<std::atomic<uint64_t>, kBucketBounds.size() + 1> Buckets {};  // 最后一个为 +Inf
+        std::atomic<uint64_t> SumNanoseconds = 0;
+        std::atomic<uint64_t> Count = 0;
+
+        void Observe(double seconds) noexcept
+        {
+            size_t i = 0;
+            while (i < kBucketBounds.size() && seconds > kBucketBounds[i])
+                ++i;
+            Buckets[i].fetch_add(1, memory_order_relaxed);
+            SumNanoseconds.fetch_add(static_cast<uint64_t>(std::max(0., seconds) * 1e9), memory_order_relaxed);
+            Count.fetch_add(1, memory_order_relaxed);
+        }
+    };
+
+    Histogram gScrapeDuration;
+    std::atomic<uint64_t> gScrapeSuccess = 0;
+    std::atomic<uint64_t> gScrapeFailure = 0;
+    std::atomic<uint64_t> gParseBytes = 0;
+    std::atomic<uint64_t> gParseNanoseconds = 0;
+    std::atomic<uint64_t> gResultsEnqueued = 0;
+    std::atomic<uint64_t> gResultsDequeued = 0;
+    std::atomic<uint64_t> gFramesRendered = 0;
+    std::atomic<uint64_t> gFramesSkipped = 0;
+    std::atomic<uint64_t> gFramesLate = 0;
+    std::atomic<uint64_t> gPresentBytes = 0;
+    std::atomic<uint64_t> gPresentLastBytes = 0;
+    std::array<Histogram, static_cast<size_t>(FrameProfiler::Phase::Count)> gPhaseDuration;
+    std::atomic<uint64_t> gHistoryBytes = 0;
+    std::atomic<uint64_t> gHistorySeries = 0;
+
+    std::unique_ptr<httplib::Server> gServer;
+    std::thread gServerThread;
+
+    void AppendHistogram(fmt::memory_buffer& out, const char* name, const std::string& labels, const Histogram& histogram)
+    {
+        auto it = back_inserter(out);
+        auto separator = labels.empty() ? "" : ",";
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < kBucketBounds.size(); ++i)
+        {
+            cumulative += histogram.Buckets[i].load(memory_order_relaxed);
+            fmt::format_to(it, "{}_bucket{{{}{}le=\"{}\"}} {}\n", name, labels, separator, kBucketBounds[i], cumulative);
+        }
+        cumulative += histogram.Buckets.back().load(memory_order_relaxed);
+        fmt::format_to(it, "{}_bucket{{{}{}le=\"+Inf\"}} {}\n", name, labels, separator, cumulative);
+
+        auto braced = labels.empty() ? std::string() : fmt::format("{{{}}}", labels);
+        fmt::format_to(it, "{}_sum{} {}\n", name, braced,
+            static_cast<double>(histogram.SumNanoseconds.load(memory_order_relaxed)) / 1e9);
+        fmt::format_to(it, "{}_count{} {}\n", name, braced, histogram.Count.load(memory_order_relaxed));
+    }
+
+    /**
+     * 从 /proc/self/stat 读取 CPU 时间（秒）与常驻内存（字节）
+     */
+    bool ReadProcessStat(double& cpuSeconds, uint64_t& residentBytes) noexcept
+    {
+        auto* fp = ::fopen("/proc/self/stat", "r");
+        if (!fp)
+            return false;
+        char buffer[1024];
+        auto length = ::fread(buffer, 1, sizeof(buffer) - 1, fp);
+        ::fclose(fp);
+        buffer[length] = '\0';
+
+        // 进程名可能包含空格，从最后一个 ')' 之后开始解析（第 3 个字段起）
+        const char* p = ::strrchr(buffer, ')');
+        if (!p)
+            return false;
+        unsigned long utime = 0, stime = 0;
+        long rss = 0;
+        if (::sscanf(p + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu %*d %*d %*d %*d %*d %*d %*u %*u %ld",
+            &utime, &stime, &rss) != 3)
+        {
+            return false;
+        }
+
+        static const auto kClockTicks = static_cast<double>(::sysconf(_SC_CLK_TCK));
+        static const auto kPageSize = static_cast<uint64_t>(::sysconf(_SC_PAGESIZE));
+        cpuSeconds = static_cast<double>(utime + stime) / kClockTicks;
+        residentBytes = static_cast<uint64_t>(std::max(0l, rss)) * kPageSize;
+        return true;
+    }
+}
+
+void SelfMetrics::ObserveScrape(double seconds, bool success) noexcept
+{
+    gScrapeDuration.Observe(seconds);
+    (success ? gScrapeSuccess : gScrapeFailure).fetch_add(1, memory_order_relaxed);
+}
+
+void SelfMetrics::ObserveParse(size_t bytes, double seconds) noexcept
+{
+    gParseBytes.fetch_add(bytes, memory_order_relaxed);
+    gParseNanoseconds.fetch_add(static_cast<uint64_t>(std::max(0., seconds) * 1e9), memory_order_relaxed);
+}
+
+void SelfMetrics::ObservePhase(FrameProfiler::Phase phase, double seconds) noexcept
+{
+    gPhaseDuration[static_cast<size_t>(phase)].Observe(seconds);
+}
+
+void SelfMetrics::ObserveResultEnqueued() noexcept
+{
+    gResultsEnqueued.fetch_add(1, memory_order_relaxed);
+}
+
+void SelfMetrics::ObserveResultDequeued() noexcept
+{
+    gResultsDequeued.fetch_add(1, memory_order_relaxed);
+}
+
+void SelfMetrics::ObserveFrame(bool rendered, bool late) noexcept
+{
+    (rendered ? gFramesRendered : gFramesSkipped).fetch_add(1, memory_order_relaxed);
+    if (late)
+        gFramesLate.fetch_add(1, memory_order_relaxed);
+}
+
+void SelfMetrics::ObservePresent(size_t bytes) noexcept
+{
+    gPresentBytes.fetch_add(bytes, memory_order_relaxed);
+    gPresentLastBytes.store(bytes, memory_order_relaxed);
+}
+
+void SelfMetrics::SetHistoryBytes(size_t bytes, size_t seriesCount) noexcept
+{
+    gHistoryBytes.store(bytes, memory_order_relaxed);
+    gHistorySeries.store(seriesCount, memory_order_relaxed);
+}
+
+Result<void> SelfMetrics::StartServer(const std::string& listen) noexcept
+{
+    StopServer();
+
+    std::string host = "0.0.0.0";
+    int port = 0;
+    auto colon = listen.rfind(':');
+    if (colon == std::string::npos)
+    {
+        port = ::atoi(listen.c_str());
+    }
+    else
+    {
+        host = listen.substr(0, colon);
+        port = ::atoi(listen.c_str() + colon + 1);
+    }
+    if (port <= 0 || port > 65535)
+    {
+        spdlog::error("Invalid self metrics listen address: {}", listen);
+        return make_error_code(errc::invalid_argument);
+    }
+
+    try
+    {
+        auto server = make_unique<httplib::Server>();
+        server->Get("/metrics", [](const httplib::Request&, httplib::Response& response) {
+            response.set_content(Format(), "text/plain; version=0.0.4; charset=utf-8");
+        });
+        if (!server->bind_to_port(host, port))
+        {
+            spdlog::error("Failed to bind self metrics server on {}:{}", host, port);
+            return make_error_code(errc::address_in_use);
+        }
+
+        gServer = std::move(server);
+        gServerThread = thread([]() { gServer->listen_after_bind(); });
+        spdlog::info("Self metrics available on http://{}:{}/metrics", host, port);
+        return {};
+    }
+    catch (const std::exception& ex)
+    {
+        spdlog::error("Failed to start self metrics server: {}", ex.what());
+        return make_error_code(errc::not_enough_memory);
+    }
+}
+
+void SelfMetrics::StopServer() noexcept
+{
+    if (!gServer)
+        return;
+    gServer->stop();
+    if (gServerThread.joinable())
+        gServerThread.join();
+    gServer.reset();
+}
+
+std::string SelfMetrics::Format()
+{
+    fmt::memory_buffer out;
+    auto it = back_inserter(out);
+
+    fmt::format_to(it, "# HELP psm_scrape_duration_seconds Time spent fetching node_exporter.\n"
+        "# TYPE psm_scrape_duration_seconds histogram\n");
+    AppendHistogram(out, "psm_scrape_duration_seconds", {}, gScrapeDuration);
+
+    fmt::format_to(it, "# HELP psm_scrapes_total Number of scrapes by result.\n# TYPE psm_scrapes_total counter\n"
+        "psm_scrapes_total{{result=\"success\"}} {}\npsm_scrapes_total{{result=\"failure\"}} {}\n",
+        gScrapeSuccess.load(memory_order_relaxed), gScrapeFailure.load(memory_order_relaxed));
+
+    fmt::format_to(it, "# HELP psm_parse_bytes_total Bytes of exposition text parsed.\n# TYPE psm_parse_bytes_total counter\n"
+        "psm_parse_bytes_total {}\n", gParseBytes.load(memory_order_relaxed));
+    fmt::format_to(it, "# HELP psm_parse_seconds_total Time spent parsing.\n# TYPE psm_parse_seconds_total counter\n"
+        "psm_parse_seconds_total {}\n", static_cast<double>(gParseNanoseconds.load(memory_order_relaxed)) / 1e9);
+
+    auto dequeued = gResultsDequeued.load(memory_order_relaxed);
+    auto enqueued = std::max(dequeued, gResultsEnqueued.load(memory_order_relaxed));
+    fmt::format_to(it, "# HELP psm_queue_depth Results waiting for the UI thread.\n# TYPE psm_queue_depth gauge\n"
+        "psm_queue_depth{{queue=\"result\"}} {}\n", enqueued - dequeued);
+
+    fmt::format_to(it, "# HELP psm_frames_total Frames by outcome.\n# TYPE psm_frames_total counter\n"
+        "psm_frames_total{{outcome=\"rendered\"}} {}\npsm_frames_total{{outcome=\"skipped\"}} {}\n",
+        gFramesRendered.load(memory_order_relaxed), gFramesSkipped.load(memory_order_relaxed));
+    fmt::format_to(it, "# HELP psm_frames_late_total Frames that exceeded the target frame interval.\n"
+        "# TYPE psm_frames_late_total counter\npsm_frames_late_total {}\n", gFramesLate.load(memory_order_relaxed));
+
+    fmt::format_to(it, "# HELP psm_framebuffer_bytes_total Bytes written to the framebuffer.\n"
+        "# TYPE psm_framebuffer_bytes_total counter\npsm_framebuffer_bytes_total {}\n", gPresentBytes.load(memory_order_relaxed));
+    fmt::format_to(it, "# HELP psm_framebuffer_last_frame_bytes Bytes written to the framebuffer by the last frame.\n"
+        "# TYPE psm_framebuffer_last_frame_bytes gauge\npsm_framebuffer_last_frame_bytes {}\n",
+        gPresentLastBytes.load(memory_order_relaxed));
+
+    fmt::format_to(it, "# HELP psm_phase_duration_seconds Time spent in each frame, sampler and latency phase.\n"
+        "# TYPE psm_phase_duration_seconds histogram\n");
+    for (size_t i = 0; i < gPhaseDuration.size(); ++i)
+    {
+        auto labels = fmt::format("phase=\"{}\"", FrameProfiler::GetPhaseName(static_cast<FrameProfiler::Phase>(i)));
+        AppendHistogram(out, "psm_phase_duration_seconds", labels, gPhaseDuration[i]);
+    }
+
+    fmt::format_to(it, "# HELP psm_history_bytes Memory used by compressed long-term history.\n# TYPE psm_history_bytes gauge\n"
+        "psm_history_bytes {}\n", gHistoryBytes.load(memory_order_relaxed));
+    fmt::format_to(it, "# HELP psm_history_series Number of long-term history series.\n# TYPE psm_history_series gauge\n"
+        "psm_history_series {}\n", gHistorySeries.load(memory_order_relaxed));
+
+    double cpuSeconds = 0;
+    uint64_t residentBytes = 0;
+    if (ReadProcessStat(cpuSeconds, residentBytes))
+    {
+        fmt::format_to(it, "# HELP process_cpu_seconds_total Total user and system CPU time spent in seconds.\n"
+            "# TYPE process_cpu_seconds_total counter\nprocess_cpu_seconds_total {}\n", cpuSeconds);
+        fmt::format_to(it, "# HELP process_resident_memory_bytes Resident memory size in bytes.\n"
+            "# TYPE process_resident_memory_bytes gauge\nprocess_resident_memory_bytes {}\n", residentBytes);
+    }
+
+    return fmt::to_string(out);
+}
@@ -0,0 +1,35 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <SignalHandler.hpp>
+
+#include <atomic>
+#include <csignal>
+
+using namespace std;
+
+namespace
+{
+    std::atomic<bool> gExitRequested = false;
+
+    void OnTerminateSignal(int) noexcept
+    {
+        gExitRequested = true;
+    }
+}
+
+void SignalHandler::Install() noexcept
+{
+    struct sigaction action {};
+    action.sa_handler = OnTerminateSignal;
+    ::sigemptyset(&action.sa_mask);
+    ::sigaction(SIGINT, &action, nullptr);
+    ::sigaction(SIGTERM, &action, nullptr);
+}
+
+bool SignalHandler::ConsumeExitRequest() noexcept
+{
+    return gExitRequested.exchange(false);
+}
@@ -0,0 +1,151 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <SparklineLod.hpp>
+
+#include <algorithm>
+
+using namespace std;
+
+namespace
+{
+    /**
+     * 按出现顺序输出桶内的最小值与最大值，两者为同一点时只输出一次
+     */
+    void EmitMinMax(uint64_t minIndex, double min, uint64_t maxIndex, double max, double xOffset, std::vector<double>& xs,
+        std::vector<double>& ys)
+    {
+        if (minIndex == maxIndex)
+        {
+            xs.push_back(static_cast<double>(minIndex) + xOffset);
+            ys.push_back(min);
+        }
+        else if (minIndex < maxIndex)
+        {
+            xs.push_back(static_cast<double>(minIndex) + xOffset);
+            ys.push_back(min);
+            xs.push_back(static_cast<double>(maxIndex) + xOffset);
+            ys.push_back(max);
+        }
+        else
+        {
+            xs.push_back(static_cast<double>(maxIndex) + xOffset);
+            ys.push_back(max);
+            xs.push_back(static_cast<double>(minIndex) + xOffset);
+            ys.push_back(min);
+        }
+    }
+}
+
+void SparklineLod::Decimate(const double* values, size_t count, size_t width, double xStart, std::vector<double>& xs,
+    std::vector<double>& ys)
+{
+    xs.clear();
+    ys.clear();
+    if (count == 0)
+        return;
+    width = std::max<size_t>(width, 1);
+    auto bucketSize = (count + width - 1) / width;
+    xs.reserve(2 * width);
+    ys.reserve(2 * width);
+
+    for (size_t begin = 0; begin < count; begin += bucketSize)
+    {
+        auto end = std::min(count, begin + bucketSize);
+        size_t minIndex = begin, maxIndex = begin;
+        for (auto i = begin + 1; i < end; ++i)
+        {
+            if (values[i] < values[minIndex])
+                minIndex = i;
+            if (values[i] > values[maxIndex])
+                maxIndex = i;
+        }
+        EmitMinMax(minIndex, values[minIndex], maxIndex, values[maxIndex], xStart, xs, ys);
+    }
+}
+
+void SparklineLod::Rebuild(const double* values, size_t count, size_t capacity, size_t width)
+{
+    m_uCapacity = std::max<size_t>(capacity, 1);
+    m_uWidth = std::max<size_t>(width, 1);
+    m_uBucketSize = (m_uCapacity + m_uWidth - 1) / m_uWidth;
+    m_uNextIndex = 0;
+    m_stBuckets.clear();
+    m_bOutputDirty = true;
+
+    for (size_t i = 0; i < count; ++i)
+        Push(values[i]);
+}
+
+void SparklineLod::Push(double value)
+{
+    if (m_uWidth == 0)
+        return;
+
+    auto index = m_uNextIndex++;
+    if (m_stBuckets.empty() || m_stBuckets.back().MinIndex / m_uBucketSize != index / m_uBucketSize)
+    {
+        m_stBuckets.push_back({ index, index, value, value });
+    }
+    else
+    {
+        auto& bucket = m_stBuckets.back();
+        if (value < bucket.Min)
+        {
+            bucket.Min = value;
+            bucket.MinIndex = index;
+        }
+        if (value > bucket.Max)
+        {
+            bucket.Max = value;
+            bucket.MaxIndex = index;
+        }
+    }
+
+    // 丢弃完全滑出窗口的桶
+    auto windowStart = m_uNextIndex > m_uCapacity ? m_uNextIndex - m_uCapacity : 0;
+    while (!m_stBuckets.empty() && (m_stBuckets.front().MinIndex / m_uBucketSize + 1) * m_uBucketSize <= windowStart)
+        m_stBuckets.pop_front();
+    m_bOutputDirty = true;
+}
+
+const std::vector<double>& SparklineLod::GetX()
+{
+    UpdateOutput();
+    return m_stX;
+}
+
+const std::vector<double>& SparklineLod::GetY()
+{
+    UpdateOutput();
+    return m_stY;
+}
+
+double SparklineLod::GetMax()
+{
+    UpdateOutput();
+    return m_dMax;
+}
+
+void SparklineLod::UpdateOutput()
+{
+    if (!m_bOutputDirty)
+        return;
+    m_bOutputDirty = false;
+
+    m_stX.clear();
+    m_stY.clear();
+    m_dMax = 0;
+
+    // 窗口未满时与 MetricsHistory 一样靠右对齐
+    auto windowStart = static_cast<double>(m_uNextIndex) - static_cast<double>(m_uCapacity);
+    for (const auto& bucket : m_stBuckets)
+    {
+        EmitMinMax(bucket.MinIndex, bucket.Min, bucket.MaxIndex, bucket.Max, -windowStart, m_stX, m_stY);
+        m_dMax = std::max(m_dMax, bucket.Max);
+    }
+    for (auto& x : m_stX)
+        x = std::max(0., x);
+}
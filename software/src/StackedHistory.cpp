@@ -0,0 +1,37 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <StackedHistory.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+using namespace std;
+
+StackedHistory::StackedHistory(size_t layerCount, size_t capacity)
+    : m_uLayerCount(layerCount), m_uCapacity(std::max<size_t>(capacity, 1))
+{
+    m_stBoundaries.assign((layerCount + 1) * 2 * m_uCapacity, 0.);
+    m_stX.resize(m_uCapacity);
+    std::iota(m_stX.begin(), m_stX.end(), 0.);
+}
+
+void StackedHistory::Push(const double* values) noexcept
+{
+    auto stride = 2 * m_uCapacity;
+    auto* boundary = m_stBoundaries.data() + stride + m_uHead;
+    double sum = 0;
+    for (size_t i = 0; i < m_uLayerCount; ++i, boundary += stride)
+    {
+        sum += std::max(0., values[i]);
+        boundary[0] = boundary[m_uCapacity] = sum;
+    }
+    m_uHead = (m_uHead + 1) % m_uCapacity;
+}
+
+const double* StackedHistory::GetBoundary(size_t index) const noexcept
+{
+    return m_stBoundaries.data() + index * 2 * m_uCapacity + m_uHead;
+}
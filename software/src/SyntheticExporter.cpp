@@ -0,0 +1,282 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <SyntheticExporter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <fmt/format.h>
+
+using namespace std;
+
+namespace
+{
+    constexpr const char* kCpuModes[] = { "idle", "iowait", "irq", "nice", "softirq", "steal", "system", "user" };
+
+    constexpr const char* kDiskMetrics[][2] = {
+        { "node_disk_io_time_seconds_total", "Total seconds spent doing I/Os." },
+        { "node_disk_read_time_seconds_total", "The total number of seconds spent by all reads." },
+        { "node_disk_write_time_seconds_total", "This is the total number of seconds spent by all writes." },
+        { "node_disk_read_bytes_total", "The total number of bytes read successfully." },
+        { "node_disk_written_bytes_total", "The total number of bytes written successfully." },
+        { "node_disk_reads_completed_total", "The total number of reads completed successfully." },
+        { "node_disk_writes_completed_total", "The total number of writes completed successfully." },
+        { "node_disk_io_time_weighted_seconds_total", "The weighted # of seconds spent doing I/Os." },
+    };
+    constexpr double kDiskRequestBytes = 64 * 1024;  // 用于由字节数推算请求数
+
+    constexpr const char* kNetworkMetrics[][2] = {
+        { "node_network_receive_bytes_total", "Network device statistic receive_bytes." },
+        { "node_network_transmit_bytes_total", "Network device statistic transmit_bytes." },
+    };
+
+    // 依次为 cpu some、memory some/full、io some/full
+    constexpr const char* kPressureMetrics[][2] = {
+        { "node_pressure_cpu_waiting_seconds_total", "Total time in seconds that processes have waited for CPU time" },
+        { "node_pressure_memory_waiting_seconds_total", "Total time in seconds that processes have waited for memory" },
+        { "node_pressure_memory_stalled_seconds_total", "Total time in seconds no process could make progress due to memory congestion" },
+        { "node_pressure_io_waiting_seconds_total", "Total time in seconds that processes have waited due to IO congestion" },
+        { "node_pressure_io_stalled_seconds_total", "Total time in seconds no process could make progress due to IO congestion" },
+    };
+
+    void AppendHeader(fmt::memory_buffer& out, const char* name, const char* help, const char* type)
+    {
+        fmt::format_to(back_inserter(out), "# HELP {} {}\n# TYPE {} {}\n", name, help, name, type);
+    }
+
+    string MakeDiskName(int index)
+    {
+        // 前 26 个为物理盘，其余模拟 device-mapper 卷
+        if (index < 26)
+            return fmt::format("sd{}", static_cast<char>('a' + index));
+        return fmt::format("dm-{}", index - 26);
+    }
+
+    string MakeNetworkName(int index, mt19937& random)
+    {
+        // 第一个为物理网卡，其余模拟容器的 veth
+        if (index == 0)
+            return "eth0";
+        return fmt::format("veth{:07x}", random() & 0xFFFFFFF);
+    }
+}
+
+SyntheticExporter::SyntheticExporter(const Config& config)
+    : m_stConfig(config), m_stRandom(config.Seed)
+{
+    m_stConfig.CpuCount = std::max(1, m_stConfig.CpuCount);
+    m_stConfig.DiskCount = std::max(0, m_stConfig.DiskCount);
+    m_stConfig.NetworkCount = std::max(0, m_stConfig.NetworkCount);
+    m_stConfig.ExtraMetricCount = std::max(0, m_stConfig.ExtraMetricCount);
+
+    m_uMemoryTotalBytes = static_cast<uint64_t>(m_stConfig.CpuCount) * 4 * 1024 * 1024 * 1024;
+    m_uMemoryAvailableBytes = m_uMemoryTotalBytes / 2;
+    m_uSwapTotalBytes = m_uMemoryTotalBytes / 2;
+    m_uSwapUsedBytes = m_uSwapTotalBytes / 8;
+    m_dLoad1 = m_dLoad5 = m_dLoad15 = m_stConfig.CpuCount * 0.25;
+
+    // 初始计数器相当于已运行约一天
+    uniform_real_distribution<double> uptime(0.5, 1.5);
+    m_stCpus.resize(static_cast<size_t>(m_stConfig.CpuCount));
+    for (auto& cpu : m_stCpus)
+    {
+        for (auto& seconds : cpu.Seconds)
+            seconds = uptime(m_stRandom) * 3600.;
+        cpu.Seconds[0] = uptime(m_stRandom) * 86400.;
+    }
+
+    m_stDisks.resize(static_cast<size_t>(m_stConfig.DiskCount));
+    for (size_t i = 0; i < m_stDisks.size(); ++i)
+    {
+        m_stDisks[i].Name = MakeDiskName(static_cast<int>(i));
+        for (auto& counter : m_stDisks[i].Counters)
+            counter = std::floor(uptime(m_stRandom) * 1e6);
+    }
+
+    m_stNetworks.resize(static_cast<size_t>(m_stConfig.NetworkCount));
+    for (size_t i = 0; i < m_stNetworks.size(); ++i)
+    {
+        m_stNetworks[i].Name = MakeNetworkName(static_cast<int>(i), m_stRandom);
+        for (auto& counter : m_stNetworks[i].Counters)
+            counter = std::floor(uptime(m_stRandom) * 1e9);
+    }
+
+    m_stExtras.resize(static_cast<size_t>(m_stConfig.ExtraMetricCount));
+    for (auto& extra : m_stExtras)
+        extra = std::floor(uptime(m_stRandom) * 1e3);
+}
+
+std::string SyntheticExporter::Render(uint64_t timestampMs)
+{
+    if (m_uBootTimestampMs == 0)
+    {
+        m_uBootTimestampMs = timestampMs - std::min<uint64_t>(timestampMs, 86400000);
+        m_uLastTimestampMs = timestampMs;
+    }
+    if (timestampMs > m_uLastTimestampMs)
+    {
+        Advance(static_cast<double>(timestampMs - m_uLastTimestampMs) / 1000.);
+        m_uLastTimestampMs = timestampMs;
+    }
+
+    fmt::memory_buffer out;
+    out.reserve(256 + m_stCpus.size() * 8 * 64 + (m_stDisks.size() * 5 + m_stNetworks.size() * 2) * 80 +
+        m_stExtras.size() * 64);
+    auto it = back_inserter(out);
+
+    AppendHeader(out, "node_boot_time_seconds", "Node boot time, in unixtime.", "gauge");
+    fmt::format_to(it, "node_boot_time_seconds {}\n", m_uBootTimestampMs / 1000);
+    AppendHeader(out, "node_load1", "1m load average.", "gauge");
+    fmt::format_to(it, "node_load1 {:.2f}\n", m_dLoad1);
+    AppendHeader(out, "node_load5", "5m load average.", "gauge");
+    fmt::format_to(it, "node_load5 {:.2f}\n", m_dLoad5);
+    AppendHeader(out, "node_load15", "15m load average.", "gauge");
+    fmt::format_to(it, "node_load15 {:.2f}\n", m_dLoad15);
+
+    AppendHeader(out, "node_memory_MemAvailable_bytes", "Memory information field MemAvailable_bytes.", "gauge");
+    fmt::format_to(it, "node_memory_MemAvailable_bytes {}\n", m_uMemoryAvailableBytes);
+    AppendHeader(out, "node_memory_MemFree_bytes", "Memory information field MemFree_bytes.", "gauge");
+    fmt::format_to(it, "node_memory_MemFree_bytes {}\n", m_uMemoryAvailableBytes / 2);
+    AppendHeader(out, "node_memory_MemTotal_bytes", "Memory information field MemTotal_bytes.", "gauge");
+    fmt::format_to(it, "node_memory_MemTotal_bytes {}\n", m_uMemoryTotalBytes);
+
+    // 可用内存中一半为空闲，其余主要是页缓存；已用内存中 3/4 为匿名页
+    auto usedBytes = m_uMemoryTotalBytes - m_uMemoryAvailableBytes;
+    AppendHeader(out, "node_memory_AnonPages_bytes", "Memory information field AnonPages_bytes.", "gauge");
+    fmt::format_to(it, "node_memory_AnonPages_bytes {}\n", usedBytes / 4 * 3);
+    AppendHeader(out, "node_memory_Buffers_bytes", "Memory information field Buffers_bytes.", "gauge");
+    fmt::format_to(it, "node_memory_Buffers_bytes {}\n", m_uMemoryAvailableBytes / 20);
+    AppendHeader(out, "node_memory_Cached_bytes", "Memory information field Cached_bytes.", "gauge");
+    fmt::format_to(it, "node_memory_Cached_bytes {}\n", m_uMemoryAvailableBytes / 20 * 9);
+    AppendHeader(out, "node_memory_SwapFree_bytes", "Memory information field SwapFree_bytes.", "gauge");
+    fmt::format_to(it, "node_memory_SwapFree_bytes {}\n", m_uSwapTotalBytes - m_uSwapUsedBytes);
+    AppendHeader(out, "node_memory_SwapTotal_bytes", "Memory information field SwapTotal_bytes.", "gauge");
+    fmt::format_to(it, "node_memory_SwapTotal_bytes {}\n", m_uSwapTotalBytes);
+
+    // 交换空间全部位于 zram，压缩率约 3:1
+    AppendHeader(out, "node_zram_orig_data_size_bytes", "Uncompressed size of data stored in zram.", "gauge");
+    fmt::format_to(it, "node_zram_orig_data_size_bytes{{device=\"zram0\"}} {}\n", m_uSwapUsedBytes);
+    AppendHeader(out, "node_zram_compr_data_size_bytes", "Compressed size of data stored in zram.", "gauge");
+    fmt::format_to(it, "node_zram_compr_data_size_bytes{{device=\"zram0\"}} {}\n", m_uSwapUsedBytes / 3);
+
+    AppendHeader(out, "node_vmstat_pgmajfault", "/proc/vmstat information field pgmajfault.", "untyped");
+    fmt::format_to(it, "node_vmstat_pgmajfault {}\n", m_dMajorFaults);
+    AppendHeader(out, "node_vmstat_pswpin", "/proc/vmstat information field pswpin.", "untyped");
+    fmt::format_to(it, "node_vmstat_pswpin {}\n", m_dSwapIn);
+    AppendHeader(out, "node_vmstat_pswpout", "/proc/vmstat information field pswpout.", "untyped");
+    fmt::format_to(it, "node_vmstat_pswpout {}\n", m_dSwapOut);
+
+    for (size_t j = 0; j < std::size(kPressureMetrics); ++j)
+    {
+        AppendHeader(out, kPressureMetrics[j][0], kPressureMetrics[j][1], "counter");
+        fmt::format_to(it, "{} {:.6f}\n", kPressureMetrics[j][0], m_stPressureSeconds[j]);
+    }
+
+    AppendHeader(out, "node_cpu_seconds_total", "Seconds the CPUs spent in each mode.", "counter");
+    for (size_t i = 0; i < m_stCpus.size(); ++i)
+    {
+        for (size_t j = 0; j < std::size(kCpuModes); ++j)
+            fmt::format_to(it, "node_cpu_seconds_total{{cpu=\"{}\",mode=\"{}\"}} {:.2f}\n", i, kCpuModes[j],
+                m_stCpus[i].Seconds[j]);
+    }
+
+    for (size_t j = 0; j < std::size(kDiskMetrics); ++j)
+    {
+        AppendHeader(out, kDiskMetrics[j][0], kDiskMetrics[j][1], "counter");
+        for (const auto& disk : m_stDisks)
+            fmt::format_to(it, "{}{{device=\"{}\"}} {}\n", kDiskMetrics[j][0], disk.Name, disk.Counters[j]);
+    }
+
+    for (size_t j = 0; j < std::size(kNetworkMetrics); ++j)
+    {
+        AppendHeader(out, kNetworkMetrics[j][0], kNetworkMetrics[j][1], "counter");
+        for (const auto& network : m_stNetworks)
+            fmt::format_to(it, "{}{{device=\"{}\"}} {}\n", kNetworkMetrics[j][0], network.Name, network.Counters[j]);
+    }
+
+    if (!m_stExtras.empty())
+    {
+        AppendHeader(out, "node_synthetic_value_total", "Synthetic series ignored by the monitor.", "counter");
+        for (size_t i = 0; i < m_stExtras.size(); ++i)
+            fmt::format_to(it, "node_synthetic_value_total{{index=\"{}\"}} {}\n", i, m_stExtras[i]);
+    }
+
+    return fmt::to_string(out);
+}
+
+void SyntheticExporter::Advance(double seconds)
+{
+    uniform_real_distribution<double> unit(0., 1.);
+
+    // 负载在 [0, CpuCount] 内随机游走
+    auto cpuCount = static_cast<double>(m_stCpus.size());
+    m_dLoad1 = std::clamp(m_dLoad1 + (unit(m_stRandom) - 0.5) * cpuCount * 0.2, 0., cpuCount);
+    m_dLoad5 += (m_dLoad1 - m_dLoad5) * 0.2;
+    m_dLoad15 += (m_dLoad5 - m_dLoad15) * 0.05;
+
+    auto memoryDelta = (unit(m_stRandom) - 0.5) * static_cast<double>(m_uMemoryTotalBytes) * 0.01;
+    m_uMemoryAvailableBytes = static_cast<uint64_t>(std::clamp(static_cast<double>(m_uMemoryAvailableBytes) + memoryDelta,
+        static_cast<double>(m_uMemoryTotalBytes) * 0.05, static_cast<double>(m_uMemoryTotalBytes) * 0.95));
+
+    // 交换空间在 [0, SwapTotal / 2] 内随机游走，换入换出页数与其变化量相符，每次换入都伴随一次主缺页
+    auto swapDelta = (unit(m_stRandom) - 0.5) * static_cast<double>(m_uSwapTotalBytes) * 0.01;
+    auto swapUsed = std::clamp(static_cast<double>(m_uSwapUsedBytes) + swapDelta, 0., static_cast<double>(m_uSwapTotalBytes) / 2);
+    auto swapPages = std::floor(std::abs(swapUsed - static_cast<double>(m_uSwapUsedBytes)) / 4096);
+    auto swapIn = swapUsed < static_cast<double>(m_uSwapUsedBytes) ? swapPages : 0.;
+    m_dSwapIn += swapIn;
+    m_dSwapOut += swapPages - swapIn;
+    m_dMajorFaults += swapIn + std::floor(seconds * unit(m_stRandom) * 50.);
+    m_uSwapUsedBytes = static_cast<uint64_t>(swapUsed);
+
+    // some 不超过 20%，full 不超过同一资源的 some
+    static_assert(std::size(kPressureMetrics) == 5);
+    m_stPressureSeconds[0] += seconds * unit(m_stRandom) * 0.2;
+    for (size_t j = 1; j < std::size(kPressureMetrics); j += 2)
+    {
+        auto some = seconds * unit(m_stRandom) * 0.2;
+        m_stPressureSeconds[j] += some;
+        m_stPressureSeconds[j + 1] += some * unit(m_stRandom);
+    }
+
+    // 每个 CPU 的各模式时间之和与流逝的时间一致
+    for (auto& cpu : m_stCpus)
+    {
+        double weights[std::size(kCpuModes)];
+        double total = 0;
+        for (size_t j = 0; j < std::size(kCpuModes); ++j)
+        {
+            weights[j] = unit(m_stRandom) * (j == 0 ? 6. : 1.);
+            total += weights[j];
+        }
+        for (size_t j = 0; j < std::size(kCpuModes); ++j)
+            cpu.Seconds[j] += seconds * weights[j] / total;
+    }
+
+    for (auto& disk : m_stDisks)
+    {
+        auto busy = unit(m_stRandom);
+        auto readShare = unit(m_stRandom);
+        disk.Counters[0] += seconds * busy;
+        disk.Counters[1] += seconds * busy * readShare;
+        disk.Counters[2] += seconds * busy * (1. - readShare);
+        auto readBytes = std::floor(seconds * busy * readShare * m_stConfig.DiskBytesPerSecond);
+        auto writtenBytes = std::floor(seconds * busy * (1. - readShare) * m_stConfig.DiskBytesPerSecond);
+        disk.Counters[3] += readBytes;
+        disk.Counters[4] += writtenBytes;
+        disk.Counters[5] += std::ceil(readBytes / kDiskRequestBytes);
+        disk.Counters[6] += std::ceil(writtenBytes / kDiskRequestBytes);
+        disk.Counters[7] += seconds * busy * (1. + 4. * unit(m_stRandom));  // 平均队列深度 1~5
+    }
+
+    for (auto& network : m_stNetworks)
+    {
+        network.Counters[0] += std::floor(seconds * unit(m_stRandom) * m_stConfig.NetworkBytesPerSecond);
+        network.Counters[1] += std::floor(seconds * unit(m_stRandom) * m_stConfig.NetworkBytesPerSecond);
+    }
+
+    for (auto& extra : m_stExtras)
+        extra += std::floor(seconds * unit(m_stRandom) * 100.);
+}
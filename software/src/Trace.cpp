@@ -0,0 +1,245 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <Trace.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+using namespace std;
+
+namespace
+{
+    constexpr size_t kThreadBufferSize = 32768;  // 每个线程保留的最近事件数
+
+    struct TraceEvent
+    {
+        const char* Name = nullptr;
+        uint64_t StartNs = 0;
+        uint64_t EndNs = 0;
+    };
+
+    /**
+     * 单写者环形缓冲区，写入方只有所属线程
+     */
+    struct ThreadBuffer
+    {
+        uint32_t ThreadId = 0;
+        std::atomic<const char*> ThreadName = nullptr;
+        std::atomic<uint64_t> WriteIndex = 0;
+        std::array<TraceEvent, kThreadBufferSize> Events;
+    };
+
+    std::mutex gRegistryLock;
+    std::vector<std::unique_ptr<ThreadBuffer>> gRegistry;  // 线程退出后仍保留，以便输出
+    std::atomic<uint32_t> gNextThreadId = 1;
+
+    std::string gOutputPath;
+    double gDurationSeconds = 0;
+    uint64_t gInstallNs = 0;
+    bool gDurationFlushed = false;
+    std::atomic<bool> gFlushRequested = false;
+    std::atomic<bool> gWriting = false;  // 后台线程正在写文件
+
+    /**
+     * 某个线程缓冲区的副本
+     */
+    struct ThreadSnapshot
+    {
+        uint32_t ThreadId = 0;
+        const char* ThreadName = nullptr;
+        std::vector<TraceEvent> Events;
+    };
+
+    ThreadBuffer& GetThreadBuffer() noexcept
+    {
+        thread_local ThreadBuffer* tBuffer = nullptr;
+        if (!tBuffer)
+        {
+            auto buffer = make_unique<ThreadBuffer>();
+            buffer->ThreadId = gNextThreadId.fetch_add(1);
+            tBuffer = buffer.get();
+
+            lock_guard<mutex> guard(gRegistryLock);
+            gRegistry.push_back(std::move(buffer));
+        }
+        return *tBuffer;
+    }
+
+    void OnFlushSignal(int) noexcept
+    {
+        gFlushRequested = true;
+    }
+
+    /**
+     * 复制所有线程缓冲区中的事件，只做内存拷贝
+     */
+    std::vector<ThreadSnapshot> TakeSnapshot()
+    {
+        std::vector<ThreadSnapshot> snapshot;
+        lock_guard<mutex> guard(gRegistryLock);
+        snapshot.reserve(gRegistry.size());
+        for (const auto& buffer : gRegistry)
+        {
+            auto& copy = snapshot.emplace_back();
+            copy.ThreadId = buffer->ThreadId;
+            copy.ThreadName = buffer->ThreadName.load(memory_order_acquire);
+
+            // 写入方可能仍在继续，跳过最旧的一段以免读到正在被覆盖的槽位
+            auto end = buffer->WriteIndex.load(memory_order_acquire);
+            auto begin = end > kThreadBufferSize - 64 ? end - (kThreadBufferSize - 64) : 0;
+            copy.Events.reserve(static_cast<size_t>(end - begin));
+            for (auto i = begin; i < end; ++i)
+            {
+                const auto& event = buffer->Events[i % kThreadBufferSize];
+                if (event.Name)
+                    copy.Events.push_back(event);
+            }
+        }
+        return snapshot;
+    }
+
+    /**
+     * 将副本格式化为 JSON 写入文件
+     */
+    Result<void> WriteSnapshot(const std::string& path, const std::vector<ThreadSnapshot>& snapshot) noexcept
+    {
+        auto* fp = ::fopen(path.c_str(), "w");
+        if (!fp)
+        {
+            spdlog::error("Failed to open trace file {}", path);
+            return make_error_code(errc::io_error);
+        }
+
+        auto pid = static_cast<int>(::getpid());
+        size_t count = 0;
+        bool first = true;
+        fmt::print(fp, "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        for (const auto& copy : snapshot)
+        {
+            if (copy.ThreadName)
+            {
+                fmt::print(fp, "{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{},\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}",
+                    first ? "" : ",\n", pid, copy.ThreadId, copy.ThreadName);
+                first = false;
+            }
+            for (const auto& event : copy.Events)
+            {
+                fmt::print(fp, "{}{{\"name\":\"{}\",\"cat\":\"psm\",\"ph\":\"X\",\"pid\":{},\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                    first ? "" : ",\n", event.Name, pid, copy.ThreadId, static_cast<double>(event.StartNs) / 1000.,
+                    static_cast<double>(event.EndNs - event.StartNs) / 1000.);
+                first = false;
+                ++count;
+            }
+        }
+        fmt::print(fp, "\n]}}\n");
+
+        bool failed = ::ferror(fp) != 0;
+        ::fclose(fp);
+        if (failed)
+        {
+            spdlog::error("Failed to write trace file {}", path);
+            return make_error_code(errc::io_error);
+        }
+        spdlog::info("Wrote {} trace events to {}", count, path);
+        return {};
+    }
+}
+
+void Trace::Record(const char* name, uint64_t startNs, uint64_t endNs) noexcept
+{
+    auto& buffer = GetThreadBuffer();
+    auto index = buffer.WriteIndex.load(memory_order_relaxed);
+    auto& event = buffer.Events[index % kThreadBufferSize];
+    event.Name = name;
+    event.StartNs = startNs;
+    event.EndNs = endNs;
+    buffer.WriteIndex.store(index + 1, memory_order_release);
+}
+
+void Trace::SetThreadName(const char* name) noexcept
+{
+    GetThreadBuffer().ThreadName.store(name, memory_order_release);
+}
+
+uint64_t Trace::Now() noexcept
+{
+    return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void Trace::Install(const std::string& path, double durationSeconds) noexcept
+{
+    gOutputPath = path;
+    gDurationSeconds = durationSeconds;
+    gInstallNs = Now();
+    gDurationFlushed = false;
+
+    struct sigaction action {};
+    action.sa_handler = OnFlushSignal;
+    ::sigemptyset(&action.sa_mask);
+    ::sigaction(SIGUSR1, &action, nullptr);
+    spdlog::info("Tracing enabled, send SIGUSR1 to write {}", path);
+}
+
+void Trace::Poll() noexcept
+{
+    if (gOutputPath.empty())
+        return;
+
+    bool flush = gFlushRequested.exchange(false);
+    if (!gDurationFlushed && gDurationSeconds > 0 &&
+        static_cast<double>(Now() - gInstallNs) / 1e9 >= gDurationSeconds)
+    {
+        gDurationFlushed = true;
+        flush = true;
+    }
+    if (!flush)
+        return;
+
+    // 上一次输出尚未完成时跳过，避免两个线程同时写同一个文件
+    if (gWriting.exchange(true))
+    {
+        spdlog::warn("Trace file {} is still being written, skipping", gOutputPath);
+        return;
+    }
+
+    // UI 线程只复制缓冲区，格式化与写文件交给后台线程，避免在被追踪的时间线上留下长时间的卡顿
+    try
+    {
+        PSM_TRACE_SCOPE("Trace::Snapshot");
+        thread([path = gOutputPath, snapshot = TakeSnapshot()]() {
+            WriteSnapshot(path, snapshot);
+            gWriting = false;
+        }).detach();
+    }
+    catch (const std::exception& ex)
+    {
+        spdlog::error("Failed to start trace writer: {}", ex.what());
+        gWriting = false;
+    }
+}
+
+Result<void> Trace::Flush(const std::string& path) noexcept
+{
+    try
+    {
+        return WriteSnapshot(path, TakeSnapshot());
+    }
+    catch (const std::bad_alloc&)
+    {
+        return make_error_code(errc::not_enough_memory);
+    }
+}
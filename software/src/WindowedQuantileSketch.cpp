@@ -0,0 +1,65 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ */
+#include <WindowedQuantileSketch.hpp>
+
+#include <algorithm>
+
+using namespace std;
+
+WindowedQuantileSketch::WindowedQuantileSketch(uint64_t windowMs, size_t sliceCount, double relativeAccuracy)
+    : m_stMerged(relativeAccuracy)
+{
+    sliceCount = std::max<size_t>(sliceCount, 1);
+    m_uSliceWidthMs = std::max<uint64_t>(windowMs / sliceCount, 1);
+    m_stSlices.assign(sliceCount, QuantileSketch(relativeAccuracy));
+    m_stSliceStartMs.assign(sliceCount, 0);
+}
+
+void WindowedQuantileSketch::Add(uint64_t timestampMs, double value)
+{
+    auto startMs = timestampMs - timestampMs % m_uSliceWidthMs;
+    if (startMs > m_uCurrentStartMs)
+        m_uCurrentStartMs = startMs;
+
+    // 同一位置上的片已过期时先清空再复用
+    auto index = static_cast<size_t>(m_uCurrentStartMs / m_uSliceWidthMs % m_stSlices.size());
+    if (m_stSliceStartMs[index] != m_uCurrentStartMs)
+    {
+        m_stSlices[index].Clear();
+        m_stSliceStartMs[index] = m_uCurrentStartMs;
+    }
+    m_stSlices[index].Add(value);
+    m_bMergedDirty = true;
+}
+
+void WindowedQuantileSketch::MergeInto(QuantileSketch& out) const
+{
+    auto windowMs = m_uSliceWidthMs * m_stSlices.size();
+    for (size_t i = 0; i < m_stSlices.size(); ++i)
+    {
+        if (m_stSliceStartMs[i] + windowMs > m_uCurrentStartMs)
+            out.Merge(m_stSlices[i]);
+    }
+}
+
+const QuantileSketch& WindowedQuantileSketch::GetMerged()
+{
+    if (m_bMergedDirty)
+    {
+        m_bMergedDirty = false;
+        m_stMerged.Clear();
+        MergeInto(m_stMerged);
+    }
+    return m_stMerged;
+}
+
+size_t WindowedQuantileSketch::GetMemoryBytes() const noexcept
+{
+    size_t bytes = m_stMerged.GetMemoryBytes();
+    for (const auto& slice : m_stSlices)
+        bytes += slice.GetMemoryBytes();
+    return bytes;
+}
@@ -0,0 +1,103 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ *
+ * 构建期工具：按 PrebakedFontAtlas::kFonts 烘焙 Alpha8 字体图集。
+ *
+ * 用法：FontAtlasBaker <assets 目录> <输出文件>
+ */
+#include <bit>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <imgui.h>
+#include <PrebakedFontAtlas.hpp>
+
+static_assert(std::endian::native == std::endian::little, "Prebaked font atlas is stored in little endian");
+
+namespace
+{
+    template <typename T>
+    void Append(std::vector<uint8_t>& out, const T& value)
+    {
+        auto p = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), p, p + sizeof(T));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        ::fprintf(stderr, "Usage: %s <assets-dir> <output>\n", argv[0]);
+        return 1;
+    }
+
+    std::string assetsDir = argv[1];
+    ImFontAtlas atlas;
+    atlas.Flags |= ImFontAtlasFlags_NoMouseCursors;  // 不使用软件鼠标
+
+    for (const auto& desc : PrebakedFontAtlas::kFonts)
+    {
+        auto path = assetsDir + "/" + desc.AssetName;
+        if (!atlas.AddFontFromFileTTF(path.c_str(), desc.SizePixels, nullptr, PrebakedFontAtlas::kGlyphRanges))
+        {
+            ::fprintf(stderr, "Failed to load font %s\n", path.c_str());
+            return 1;
+        }
+    }
+
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    atlas.GetTexDataAsAlpha8(&pixels, &width, &height);
+    if (!pixels)
+    {
+        ::fprintf(stderr, "Failed to build font atlas\n");
+        return 1;
+    }
+
+    std::vector<uint8_t> blob;
+    Append(blob, PrebakedFontAtlas::kMagic);
+    Append(blob, PrebakedFontAtlas::kVersion);
+    Append(blob, static_cast<uint32_t>(width));
+    Append(blob, static_cast<uint32_t>(height));
+    Append(blob, atlas.TexUvWhitePixel);
+    Append(blob, static_cast<uint32_t>(IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1));
+    for (const auto& line : atlas.TexUvLines)
+        Append(blob, line);
+
+    Append(blob, static_cast<uint32_t>(atlas.Fonts.Size));
+    for (const auto* font : atlas.Fonts)
+    {
+        Append(blob, font->FontSize);
+        Append(blob, font->Ascent);
+        Append(blob, font->Descent);
+        Append(blob, static_cast<uint32_t>(font->Glyphs.Size));
+        for (const auto& glyph : font->Glyphs)
+        {
+            Append(blob, static_cast<uint32_t>(glyph.Codepoint));
+            const float values[9] = { glyph.AdvanceX, glyph.X0, glyph.Y0, glyph.X1, glyph.Y1, glyph.U0, glyph.V0,
+                glyph.U1, glyph.V1 };
+            Append(blob, values);
+        }
+    }
+    blob.insert(blob.end(), pixels, pixels + static_cast<size_t>(width) * height);
+
+    auto* fp = ::fopen(argv[2], "wb");
+    if (!fp)
+    {
+        ::fprintf(stderr, "Failed to open %s\n", argv[2]);
+        return 1;
+    }
+    auto written = ::fwrite(blob.data(), 1, blob.size(), fp);
+    ::fclose(fp);
+    if (written != blob.size())
+    {
+        ::fprintf(stderr, "Failed to write %s\n", argv[2]);
+        return 1;
+    }
+
+    ::printf("Baked %d font(s) into %dx%d Alpha8 atlas (%zu bytes)\n", atlas.Fonts.Size, width, height, blob.size());
+    return 0;
+}
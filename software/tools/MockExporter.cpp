@@ -0,0 +1,106 @@
+/**
+ * @file
+ * @author chu
+ * @date 2026/10/18
+ *
+ * 本地模拟 node_exporter：按指定规模生成指标页面，用于大型主机场景的扩展性测试。
+ *
+ * 用法：MockExporter [--listen 地址] [--port 端口] [--cpus N] [--disks N] [--nets N] [--extra N] [--seed N]
+ *                    [--delay-ms N]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <httplib.h>
+#include <SyntheticExporter.hpp>
+
+using namespace std;
+
+namespace
+{
+    uint64_t GetUnixTimeMs() noexcept
+    {
+        return static_cast<uint64_t>(chrono::duration_cast<chrono::milliseconds>(
+            chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+    void PrintUsage(const char* program)
+    {
+        ::fprintf(stderr, "Usage: %s [--listen ADDR] [--port PORT] [--cpus N] [--disks N] [--nets N] [--extra N] "
+            "[--seed N] [--delay-ms N]\n", program);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    string listen = "127.0.0.1";
+    int port = 9100;
+    int delayMs = 0;
+    SyntheticExporter::Config config;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (i + 1 >= argc)
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+
+        const char* key = argv[i];
+        const char* value = argv[++i];
+        if (::strcmp(key, "--listen") == 0)
+            listen = value;
+        else if (::strcmp(key, "--port") == 0)
+            port = ::atoi(value);
+        else if (::strcmp(key, "--cpus") == 0)
+            config.CpuCount = ::atoi(value);
+        else if (::strcmp(key, "--disks") == 0)
+            config.DiskCount = ::atoi(value);
+        else if (::strcmp(key, "--nets") == 0)
+            config.NetworkCount = ::atoi(value);
+        else if (::strcmp(key, "--extra") == 0)
+            config.ExtraMetricCount = ::atoi(value);
+        else if (::strcmp(key, "--seed") == 0)
+            config.Seed = static_cast<uint32_t>(::strtoul(value, nullptr, 10));
+        else if (::strcmp(key, "--delay-ms") == 0)
+            delayMs = ::atoi(value);
+        else
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    SyntheticExporter exporter(config);
+    mutex exporterLock;
+
+    httplib::Server server;
+    server.Get("/metrics", [&](const httplib::Request&, httplib::Response& response) {
+        // 模拟大型主机上 node_exporter 自身的采集耗时
+        if (delayMs > 0)
+            this_thread::sleep_for(chrono::milliseconds(delayMs));
+
+        string body;
+        {
+            lock_guard<mutex> guard(exporterLock);
+            body = exporter.Render(GetUnixTimeMs());
+        }
+        response.set_content(std::move(body), "text/plain; version=0.0.4; charset=utf-8");
+    });
+
+    const auto& actual = exporter.GetConfig();
+    ::printf("Serving %d cpu(s), %d disk(s), %d network device(s), %d extra series on http://%s:%d/metrics\n",
+        actual.CpuCount, actual.DiskCount, actual.NetworkCount, actual.ExtraMetricCount, listen.c_str(), port);
+    ::fflush(stdout);
+
+    if (!server.listen(listen, port))
+    {
+        ::fprintf(stderr, "Failed to listen on %s:%d\n", listen.c_str(), port);
+        return 1;
+    }
+    return 0;
+}
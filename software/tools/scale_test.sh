@@ -0,0 +1,69 @@
+#!/bin/bash
+#
+# 主机规模扩展性测试
+#
+# 对每一档规模启动 MockExporter，以无头模式运行 PiSystemMonitor，收集帧耗时与采样线程
+# 抓取/解析/计算耗时（HEADLESS_STATS 中的 phases 字段），汇总到一个 JSON 文件。
+#
+# 用法：scale_test.sh [构建目录] [输出目录]
+#   SCALE_SIZES    规模列表，每项为 cpus:disks:nets，默认 "4:2:2 32:16:16 128:128:128 256:512:512"
+#   SCALE_FRAMES   每档渲染帧数，默认 300
+#   SCALE_FPS      帧率上限，默认 30
+#   SCALE_PORT     MockExporter 端口，默认 19100
+
+set -e
+
+BUILD_DIR=$(realpath "${1:-$(dirname $0)/../../build}")
+OUTPUT_DIR=$(realpath -m "${2:-./scale_test}")
+SIZES=${SCALE_SIZES:-"4:2:2 32:16:16 128:128:128 256:512:512"}
+FRAMES=${SCALE_FRAMES:-300}
+FPS=${SCALE_FPS:-30}
+PORT=${SCALE_PORT:-19100}
+
+mkdir -p "$OUTPUT_DIR"
+SUMMARY="$OUTPUT_DIR/summary.json"
+
+EXPORTER_PID=
+cleanup() {
+    if [ -n "$EXPORTER_PID" ]; then
+        kill $EXPORTER_PID 2>/dev/null || true
+        wait $EXPORTER_PID 2>/dev/null || true
+    fi
+}
+trap cleanup EXIT
+
+echo "[" > "$SUMMARY"
+FIRST=1
+for SIZE in $SIZES; do
+    IFS=: read CPUS DISKS NETS <<< "$SIZE"
+    NAME="${CPUS}cpu_${DISKS}disk_${NETS}net"
+    STATS="$OUTPUT_DIR/$NAME.json"
+    echo "==> $NAME"
+
+    "$BUILD_DIR/MockExporter" --port $PORT --cpus $CPUS --disks $DISKS --nets $NETS &
+    EXPORTER_PID=$!
+    sleep 0.5
+
+    # 采样间隔缩短到 100ms，使一次运行中包含足够多的采样
+    METRICS_URL="http://127.0.0.1:$PORT/metrics" METRICS_INTERVAL_MS=100 \
+        DISPLAY_BACKEND=headless HEADLESS_FRAMES=$FRAMES HEADLESS_WARMUP=10 HEADLESS_FPS=$FPS \
+        HEADLESS_STATS="$STATS" HEADLESS_DUMP_DIR="$OUTPUT_DIR/$NAME" \
+        "$BUILD_DIR/PiSystemMonitor"
+
+    cleanup
+    EXPORTER_PID=
+
+    [ $FIRST -eq 1 ] || echo "," >> "$SUMMARY"
+    FIRST=0
+    echo "{\"cpus\": $CPUS, \"disks\": $DISKS, \"nets\": $NETS, \"stats\": " >> "$SUMMARY"
+    cat "$STATS" >> "$SUMMARY"
+    echo "}" >> "$SUMMARY"
+done
+echo "]" >> "$SUMMARY"
+
+echo "Summary written to $SUMMARY"
+if command -v jq > /dev/null; then
+    jq -r '["size", "frame_p99_ms", "fetch_p50_ms", "parse_p50_ms", "compute_p50_ms", "first_frame_ms"],
+        (.[] | ["\(.cpus)/\(.disks)/\(.nets)", .stats.frame_ms.p99, .stats.phases.Fetch.p50,
+            .stats.phases.Parse.p50, .stats.phases.Compute.p50, .stats.phases.FirstFrame.max]) | @tsv' "$SUMMARY" | column -t
+fi